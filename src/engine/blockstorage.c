@@ -0,0 +1,142 @@
+#include "blockstorage.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+static int getWordCount(int bitsPerBlock) {
+    return BLOCK_STORAGE_SIZE * bitsPerBlock / 64;
+}
+
+static int readPaletteIndex(const uint64_t* data, int bitsPerBlock, int index) {
+    int bitOffset = index * bitsPerBlock;
+    uint64_t mask = ((uint64_t)1 << bitsPerBlock) - 1;
+
+    return (int)((data[bitOffset >> 6] >> (bitOffset & 63)) & mask);
+}
+
+static void writePaletteIndex(uint64_t* data, int bitsPerBlock, int index, int paletteIndex) {
+    int bitOffset = index * bitsPerBlock;
+    uint64_t mask = ((uint64_t)1 << bitsPerBlock) - 1;
+    uint64_t* word = &data[bitOffset >> 6];
+
+    *word = (*word & ~(mask << (bitOffset & 63))) | (((uint64_t)paletteIndex & mask) << (bitOffset & 63));
+}
+
+static void repackBlockStorage(BlockStorage* storage, int bitsPerBlock, const int* remap) {
+    uint64_t* data = calloc(getWordCount(bitsPerBlock), sizeof(uint64_t));
+
+    for (int i = 0; i < BLOCK_STORAGE_SIZE; i++) {
+        int paletteIndex = readPaletteIndex(storage->data, storage->bitsPerBlock, i);
+        writePaletteIndex(data, bitsPerBlock, i, remap != NULL ? remap[paletteIndex] : paletteIndex);
+    }
+
+    free(storage->data);
+    storage->data = data;
+    storage->bitsPerBlock = bitsPerBlock;
+    storage->palette = realloc(storage->palette, ((size_t)1 << bitsPerBlock) * sizeof(int));
+}
+
+static void compactPalette(BlockStorage* storage) {
+    int remap[1 << BLOCK_STORAGE_MAX_BITS];
+    bool used[1 << BLOCK_STORAGE_MAX_BITS] = { false };
+
+    for (int i = 0; i < BLOCK_STORAGE_SIZE; i++) {
+        used[readPaletteIndex(storage->data, storage->bitsPerBlock, i)] = true;
+    }
+
+    int paletteSize = 0;
+    for (int i = 0; i < storage->paletteSize; i++) {
+        if (used[i]) {
+            storage->palette[paletteSize] = storage->palette[i];
+            remap[i] = paletteSize++;
+        }
+    }
+
+    storage->paletteSize = paletteSize;
+    repackBlockStorage(storage, storage->bitsPerBlock, remap);
+}
+
+static int addPaletteEntry(BlockStorage* storage, int type) {
+    if (storage->paletteSize == 1 << storage->bitsPerBlock) {
+        if (storage->bitsPerBlock == BLOCK_STORAGE_MAX_BITS) {
+            compactPalette(storage);
+
+            if (storage->paletteSize == 1 << storage->bitsPerBlock) {
+                return -1;
+            }
+        }
+        else {
+            repackBlockStorage(storage, storage->bitsPerBlock * 2, NULL);
+        }
+    }
+
+    storage->palette[storage->paletteSize] = type;
+    return storage->paletteSize++;
+}
+
+void initBlockStorage(BlockStorage* storage, int initialType) {
+    storage->bitsPerBlock = 1;
+    storage->paletteSize = 1;
+    storage->palette = malloc(2 * sizeof(int));
+    storage->palette[0] = initialType;
+    storage->data = calloc(getWordCount(1), sizeof(uint64_t));
+}
+
+void freeBlockStorage(BlockStorage* storage) {
+    free(storage->palette);
+    free(storage->data);
+    storage->palette = NULL;
+    storage->data = NULL;
+    storage->paletteSize = 0;
+}
+
+int getStorageBlock(const BlockStorage* storage, int index) {
+    return storage->palette[readPaletteIndex(storage->data, storage->bitsPerBlock, index)];
+}
+
+void fillStorageOccupancy(const BlockStorage* storage, uint16_t* rows) {
+    bool isSolid[1 << BLOCK_STORAGE_MAX_BITS] = { false };
+
+    for (int i = 0; i < storage->paletteSize; i++) {
+        isSolid[i] = storage->palette[i] != 0;
+    }
+
+    for (int row = 0; row < BLOCK_STORAGE_SIZE / BLOCK_STORAGE_ROW_SIZE; row++) {
+        uint16_t rowBits = 0;
+
+        for (int i = 0; i < BLOCK_STORAGE_ROW_SIZE; i++) {
+            int paletteIndex = readPaletteIndex(storage->data, storage->bitsPerBlock, row * BLOCK_STORAGE_ROW_SIZE + i);
+            rowBits |= (uint16_t)(isSolid[paletteIndex] << i);
+        }
+
+        rows[row] = rowBits;
+    }
+}
+
+bool setStorageBlock(BlockStorage* storage, int index, int type) {
+    int paletteIndex = -1;
+
+    for (int i = 0; i < storage->paletteSize; i++) {
+        if (storage->palette[i] == type) {
+            paletteIndex = i;
+            break;
+        }
+    }
+
+    if (paletteIndex == -1) {
+        paletteIndex = addPaletteEntry(storage, type);
+
+        if (paletteIndex == -1) {
+            return false;
+        }
+    }
+
+    writePaletteIndex(storage->data, storage->bitsPerBlock, index, paletteIndex);
+    return true;
+}
+
+size_t getBlockStorageBytes(const BlockStorage* storage) {
+    return sizeof(BlockStorage)
+        + ((size_t)1 << storage->bitsPerBlock) * sizeof(int)
+        + getWordCount(storage->bitsPerBlock) * sizeof(uint64_t);
+}
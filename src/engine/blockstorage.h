@@ -0,0 +1,26 @@
+#ifndef BLOCKS_BLOCKSTORAGE
+#define BLOCKS_BLOCKSTORAGE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BLOCK_STORAGE_SIZE 4096
+#define BLOCK_STORAGE_MAX_BITS 8
+#define BLOCK_STORAGE_ROW_SIZE 16
+
+typedef struct BlockStorage {
+	int* palette;
+	int paletteSize;
+	int bitsPerBlock;
+	uint64_t* data;
+} BlockStorage;
+
+void initBlockStorage(BlockStorage* storage, int initialType);
+void freeBlockStorage(BlockStorage* storage);
+int getStorageBlock(const BlockStorage* storage, int index);
+bool setStorageBlock(BlockStorage* storage, int index, int type);
+void fillStorageOccupancy(const BlockStorage* storage, uint16_t* rows);
+size_t getBlockStorageBytes(const BlockStorage* storage);
+
+#endif
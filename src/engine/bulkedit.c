@@ -0,0 +1,295 @@
+#include "bulkedit.h"
+#include "dirty.h"
+#include "journal.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+typedef int (*BulkEditFunction)(void* context, int x, int y, int z, int oldType);
+
+typedef struct ClipboardContext {
+    IntVector3 origin;
+    const BlockClipboard* clipboard;
+    bool skipAir;
+} ClipboardContext;
+
+static BulkEditStats bulkEditStats = {
+    .operations = 0,
+    .changedBlocks = 0,
+    .touchedChunks = 0
+};
+
+BulkEditStats getBulkEditStats() {
+    return bulkEditStats;
+}
+
+static int clampInt(int value, int min, int max) {
+    return value < min ? min : (value > max ? max : value);
+}
+
+static uint16_t spreadSlices(uint16_t slices) {
+    return (uint16_t)(slices | (slices << 1) | (slices >> 1));
+}
+
+static void editChunk(WorldState* ws, ChunkColumn* column, Chunk* chunk, IntVector3 min, IntVector3 max,
+    BulkEditFunction function, void* context, bool isJournaled) {
+    int originX = chunk->position.x * CHUNK_SIZE;
+    int originY = chunk->position.y * CHUNK_SIZE;
+    int originZ = chunk->position.z * CHUNK_SIZE;
+    int startX = clampInt(min.x - originX, 0, CHUNK_MASK);
+    int startY = clampInt(min.y - originY, 0, CHUNK_MASK);
+    int startZ = clampInt(min.z - originZ, 0, CHUNK_MASK);
+    int endX = clampInt(max.x - originX, 0, CHUNK_MASK);
+    int endY = clampInt(max.y - originY, 0, CHUNK_MASK);
+    int endZ = clampInt(max.z - originZ, 0, CHUNK_MASK);
+
+    uint16_t changedSlices = 0;
+    uint16_t leftSlices = 0;
+    uint16_t rightSlices = 0;
+    uint16_t bottomSlices = 0;
+    uint16_t topSlices = 0;
+
+    for (int z = startZ; z <= endZ; z++) {
+        for (int y = startY; y <= endY; y++) {
+            for (int x = startX; x <= endX; x++) {
+                int index = x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
+                int oldType = getChunkBlock(chunk, index);
+                int newType = function(context, originX + x, originY + y, originZ + z, oldType);
+
+                if (newType == oldType || !setChunkBlock(ws, chunk, index, newType)) {
+                    continue;
+                }
+
+                updateColumnSurface(column, originX + x, originY + y, originZ + z, newType);
+                bulkEditStats.changedBlocks++;
+
+                if (isJournaled) {
+                    appendJournalEdit(originX + x, originY + y, originZ + z, oldType, newType);
+                }
+
+                uint16_t slice = (uint16_t)(1u << z);
+                changedSlices |= slice;
+                leftSlices |= x == 0 ? slice : 0;
+                rightSlices |= x == CHUNK_MASK ? slice : 0;
+                bottomSlices |= y == 0 ? slice : 0;
+                topSlices |= y == CHUNK_MASK ? slice : 0;
+            }
+        }
+    }
+
+    if (changedSlices == 0) {
+        return;
+    }
+
+    if (chunk->uniformType == CHUNK_MIXED) {
+        compactChunk(chunk);
+        if (chunk->uniformType != CHUNK_MIXED) {
+            ws->elidedSectionCount++;
+        }
+    }
+
+    column->isModified = true;
+    column->revision++;
+    bulkEditStats.touchedChunks++;
+
+    IntVector3 position = chunk->position;
+    markChunkDirty(ws, chunk, spreadSlices(changedSlices));
+    markChunkDirty(ws, getChunkAt(ws, position.x - 1, position.y, position.z), leftSlices);
+    markChunkDirty(ws, getChunkAt(ws, position.x + 1, position.y, position.z), rightSlices);
+    markChunkDirty(ws, getChunkAt(ws, position.x, position.y - 1, position.z), bottomSlices);
+    markChunkDirty(ws, getChunkAt(ws, position.x, position.y + 1, position.z), topSlices);
+
+    if (changedSlices & 1) {
+        markChunkDirty(ws, getChunkAt(ws, position.x, position.y, position.z - 1), (uint16_t)(1u << CHUNK_MASK));
+    }
+    if (changedSlices & (1u << CHUNK_MASK)) {
+        markChunkDirty(ws, getChunkAt(ws, position.x, position.y, position.z + 1), 1);
+    }
+}
+
+static void applyBulkEdit(WorldState* ws, IntVector3 min, IntVector3 max, BulkEditFunction function, void* context,
+    bool isJournaled) {
+    bulkEditStats.operations++;
+
+    if (min.x > max.x || min.y > max.y || min.z > max.z || max.y < 0 || min.y >= WORLD_HEIGHT) {
+        return;
+    }
+
+    int minSection = clampInt(min.y >> CHUNK_SHIFT, 0, CHUNK_SECTION_COUNT - 1);
+    int maxSection = clampInt(max.y >> CHUNK_SHIFT, 0, CHUNK_SECTION_COUNT - 1);
+
+    for (int columnZ = min.z >> CHUNK_SHIFT; columnZ <= max.z >> CHUNK_SHIFT; columnZ++) {
+        for (int columnX = min.x >> CHUNK_SHIFT; columnX <= max.x >> CHUNK_SHIFT; columnX++) {
+            ChunkColumn* column = getChunkColumnAt(ws, columnX, columnZ);
+
+            if (column == NULL) {
+                continue;
+            }
+
+            for (int section = minSection; section <= maxSection; section++) {
+                editChunk(ws, column, &column->sections[section], min, max, function, context, isJournaled);
+            }
+        }
+    }
+}
+
+static int bulkEditFunction(void* context, int x, int y, int z, int oldType) {
+    const BulkEdit* edit = context;
+
+    if (edit->kind == BULK_EDIT_FILL) {
+        return edit->blockType;
+    }
+
+    if (edit->kind == BULK_EDIT_REPLACE) {
+        return oldType == edit->fromType ? edit->blockType : oldType;
+    }
+
+    double dx = ((double)x - edit->center[0]) * edit->inverseRadius[0];
+    double dy = ((double)y - edit->center[1]) * edit->inverseRadius[1];
+    double dz = ((double)z - edit->center[2]) * edit->inverseRadius[2];
+
+    return dx * dx + dy * dy + dz * dz <= 1.0 ? edit->blockType : oldType;
+}
+
+void applyBulkEditToColumn(WorldState* ws, ChunkColumn* column, const BulkEdit* edit) {
+    if (edit->max.x < column->x * CHUNK_SIZE || edit->min.x >= (column->x + 1) * CHUNK_SIZE
+        || edit->max.z < column->z * CHUNK_SIZE || edit->min.z >= (column->z + 1) * CHUNK_SIZE
+        || edit->min.x > edit->max.x || edit->min.z > edit->max.z
+        || edit->min.y > edit->max.y || edit->max.y < 0 || edit->min.y >= WORLD_HEIGHT) {
+        return;
+    }
+
+    int minSection = clampInt(edit->min.y >> CHUNK_SHIFT, 0, CHUNK_SECTION_COUNT - 1);
+    int maxSection = clampInt(edit->max.y >> CHUNK_SHIFT, 0, CHUNK_SECTION_COUNT - 1);
+
+    for (int section = minSection; section <= maxSection; section++) {
+        editChunk(ws, column, &column->sections[section], edit->min, edit->max, bulkEditFunction, (void*)edit, false);
+    }
+}
+
+static void runBulkEdit(WorldState* ws, const BulkEdit* edit) {
+    bulkEditStats.operations++;
+
+    for (int columnZ = edit->min.z >> CHUNK_SHIFT; columnZ <= edit->max.z >> CHUNK_SHIFT; columnZ++) {
+        for (int columnX = edit->min.x >> CHUNK_SHIFT; columnX <= edit->max.x >> CHUNK_SHIFT; columnX++) {
+            ChunkColumn* column = getChunkColumnAt(ws, columnX, columnZ);
+
+            if (column == NULL) {
+                continue;
+            }
+
+            BulkEdit columnEdit = *edit;
+            columnEdit.min.x = edit->min.x > columnX * CHUNK_SIZE ? edit->min.x : columnX * CHUNK_SIZE;
+            columnEdit.min.z = edit->min.z > columnZ * CHUNK_SIZE ? edit->min.z : columnZ * CHUNK_SIZE;
+            columnEdit.max.x = edit->max.x < columnX * CHUNK_SIZE + CHUNK_MASK ? edit->max.x : columnX * CHUNK_SIZE + CHUNK_MASK;
+            columnEdit.max.z = edit->max.z < columnZ * CHUNK_SIZE + CHUNK_MASK ? edit->max.z : columnZ * CHUNK_SIZE + CHUNK_MASK;
+
+            int changedBlocks = bulkEditStats.changedBlocks;
+            applyBulkEditToColumn(ws, column, &columnEdit);
+
+            if (bulkEditStats.changedBlocks != changedBlocks) {
+                appendJournalBulkEdit(&columnEdit);
+            }
+        }
+    }
+}
+
+static int copyFunction(void* context, int x, int y, int z, int oldType) {
+    const ClipboardContext* copy = context;
+    const BlockClipboard* clipboard = copy->clipboard;
+    int index = (x - copy->origin.x)
+        + (y - copy->origin.y) * clipboard->size.x
+        + (z - copy->origin.z) * clipboard->size.x * clipboard->size.y;
+
+    clipboard->blocks[index] = oldType;
+    return oldType;
+}
+
+static int pasteFunction(void* context, int x, int y, int z, int oldType) {
+    const ClipboardContext* paste = context;
+    const BlockClipboard* clipboard = paste->clipboard;
+    int index = (x - paste->origin.x)
+        + (y - paste->origin.y) * clipboard->size.x
+        + (z - paste->origin.z) * clipboard->size.x * clipboard->size.y;
+    int blockType = clipboard->blocks[index];
+
+    return paste->skipAir && blockType == 0 ? oldType : blockType;
+}
+
+void fillBlocks(WorldState* ws, IntVector3 min, IntVector3 max, int blockType) {
+    BulkEdit edit = { .kind = BULK_EDIT_FILL, .min = min, .max = max, .blockType = blockType };
+    runBulkEdit(ws, &edit);
+}
+
+void replaceBlocks(WorldState* ws, IntVector3 min, IntVector3 max, int fromType, int toType) {
+    BulkEdit edit = { .kind = BULK_EDIT_REPLACE, .min = min, .max = max, .fromType = fromType, .blockType = toType };
+    runBulkEdit(ws, &edit);
+}
+
+void fillEllipsoid(WorldState* ws, Vector3 center, Vector3 radius, int blockType) {
+    if (radius.x <= 0.0 || radius.y <= 0.0 || radius.z <= 0.0) {
+        return;
+    }
+
+    BulkEdit edit = {
+        .kind = BULK_EDIT_ELLIPSOID,
+        .min = {
+            .x = (int)ceil(center.x - radius.x),
+            .y = (int)ceil(center.y - radius.y),
+            .z = (int)ceil(center.z - radius.z)
+        },
+        .max = {
+            .x = (int)floor(center.x + radius.x),
+            .y = (int)floor(center.y + radius.y),
+            .z = (int)floor(center.z + radius.z)
+        },
+        .blockType = blockType,
+        .center = { (float)center.x, (float)center.y, (float)center.z },
+        .inverseRadius = { (float)(1.0 / radius.x), (float)(1.0 / radius.y), (float)(1.0 / radius.z) }
+    };
+
+    runBulkEdit(ws, &edit);
+}
+
+void carveSphere(WorldState* ws, Vector3 center, double radius) {
+    Vector3 radii = { .x = radius, .y = radius, .z = radius };
+    fillEllipsoid(ws, center, radii, 0);
+}
+
+void copyBlocks(WorldState* ws, IntVector3 min, IntVector3 max, BlockClipboard* clipboard) {
+    clipboard->size.x = max.x - min.x + 1;
+    clipboard->size.y = max.y - min.y + 1;
+    clipboard->size.z = max.z - min.z + 1;
+
+    if (clipboard->size.x <= 0 || clipboard->size.y <= 0 || clipboard->size.z <= 0) {
+        clipboard->size.x = clipboard->size.y = clipboard->size.z = 0;
+        clipboard->blocks = NULL;
+        return;
+    }
+
+    clipboard->blocks = calloc((size_t)clipboard->size.x * clipboard->size.y * clipboard->size.z, sizeof(int));
+
+    ClipboardContext context = { .origin = min, .clipboard = clipboard, .skipAir = false };
+    applyBulkEdit(ws, min, max, copyFunction, &context, false);
+}
+
+void pasteBlocks(WorldState* ws, const BlockClipboard* clipboard, IntVector3 origin, bool skipAir) {
+    if (clipboard->blocks == NULL) {
+        return;
+    }
+
+    IntVector3 max = {
+        .x = origin.x + clipboard->size.x - 1,
+        .y = origin.y + clipboard->size.y - 1,
+        .z = origin.z + clipboard->size.z - 1
+    };
+    ClipboardContext context = { .origin = origin, .clipboard = clipboard, .skipAir = skipAir };
+
+    applyBulkEdit(ws, origin, max, pasteFunction, &context, true);
+}
+
+void freeBlockClipboard(BlockClipboard* clipboard) {
+    free(clipboard->blocks);
+    clipboard->blocks = NULL;
+    clipboard->size.x = clipboard->size.y = clipboard->size.z = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef BLOCKS_BULKEDIT
+#define BLOCKS_BULKEDIT
+
+#include <stdbool.h>
+#include "types.h"
+#include "world.h"
+
+typedef struct BlockClipboard {
+	IntVector3 size;
+	int* blocks;
+} BlockClipboard;
+
+typedef enum BulkEditKind {
+	BULK_EDIT_FILL,
+	BULK_EDIT_REPLACE,
+	BULK_EDIT_ELLIPSOID
+} BulkEditKind;
+
+typedef struct BulkEdit {
+	BulkEditKind kind;
+	IntVector3 min;
+	IntVector3 max;
+	int fromType;
+	int blockType;
+	float center[3];
+	float inverseRadius[3];
+} BulkEdit;
+
+typedef struct BulkEditStats {
+	int operations;
+	int changedBlocks;
+	int touchedChunks;
+} BulkEditStats;
+
+void fillBlocks(WorldState* worldState, IntVector3 min, IntVector3 max, int blockType);
+void replaceBlocks(WorldState* worldState, IntVector3 min, IntVector3 max, int fromType, int toType);
+void fillEllipsoid(WorldState* worldState, Vector3 center, Vector3 radius, int blockType);
+void carveSphere(WorldState* worldState, Vector3 center, double radius);
+void copyBlocks(WorldState* worldState, IntVector3 min, IntVector3 max, BlockClipboard* clipboard);
+void pasteBlocks(WorldState* worldState, const BlockClipboard* clipboard, IntVector3 origin, bool skipAir);
+void freeBlockClipboard(BlockClipboard* clipboard);
+void applyBulkEditToColumn(WorldState* worldState, ChunkColumn* column, const BulkEdit* edit);
+BulkEditStats getBulkEditStats();
+
+#endif
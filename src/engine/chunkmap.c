@@ -0,0 +1,135 @@
+#include "chunkmap.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+static unsigned int hashChunkKey(IntVector3 key) {
+    unsigned int hash = (unsigned int)key.x * 73856093u;
+    hash ^= (unsigned int)key.y * 19349663u;
+    hash ^= (unsigned int)key.z * 83492791u;
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352Du;
+    hash ^= hash >> 15;
+    return hash;
+}
+
+static bool chunkKeysEqual(IntVector3 a, IntVector3 b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static void allocateEntries(ChunkMap* map, int capacity) {
+    map->entries = malloc(capacity * sizeof(ChunkMapEntry));
+    map->capacity = capacity;
+    map->count = 0;
+
+    for (int i = 0; i < capacity; i++) {
+        map->entries[i].value = CHUNK_MAP_EMPTY;
+    }
+}
+
+static void growChunkMap(ChunkMap* map) {
+    ChunkMapEntry* oldEntries = map->entries;
+    int oldCapacity = map->capacity;
+
+    allocateEntries(map, oldCapacity * 2);
+
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldEntries[i].value != CHUNK_MAP_EMPTY) {
+            chunkMapPut(map, oldEntries[i].key, oldEntries[i].value);
+        }
+    }
+
+    free(oldEntries);
+}
+
+void initChunkMap(ChunkMap* map, int expectedCount) {
+    int capacity = 16;
+    while (capacity < expectedCount * 2) {
+        capacity *= 2;
+    }
+
+    allocateEntries(map, capacity);
+}
+
+void freeChunkMap(ChunkMap* map) {
+    free(map->entries);
+    map->entries = NULL;
+    map->capacity = 0;
+    map->count = 0;
+}
+
+void chunkMapPut(ChunkMap* map, IntVector3 key, int value) {
+    if ((map->count + 1) * 2 > map->capacity) {
+        growChunkMap(map);
+    }
+
+    unsigned int mask = (unsigned int)map->capacity - 1;
+    unsigned int slot = hashChunkKey(key) & mask;
+
+    while (map->entries[slot].value != CHUNK_MAP_EMPTY) {
+        if (chunkKeysEqual(map->entries[slot].key, key)) {
+            map->entries[slot].value = value;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    map->entries[slot].key = key;
+    map->entries[slot].value = value;
+    map->count++;
+}
+
+int chunkMapGet(const ChunkMap* map, IntVector3 key) {
+    if (map->entries == NULL) {
+        return CHUNK_MAP_EMPTY;
+    }
+
+    unsigned int mask = (unsigned int)map->capacity - 1;
+    unsigned int slot = hashChunkKey(key) & mask;
+
+    while (map->entries[slot].value != CHUNK_MAP_EMPTY) {
+        if (chunkKeysEqual(map->entries[slot].key, key)) {
+            return map->entries[slot].value;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return CHUNK_MAP_EMPTY;
+}
+
+void chunkMapRemove(ChunkMap* map, IntVector3 key) {
+    if (map->entries == NULL) {
+        return;
+    }
+
+    unsigned int mask = (unsigned int)map->capacity - 1;
+    unsigned int slot = hashChunkKey(key) & mask;
+
+    while (map->entries[slot].value != CHUNK_MAP_EMPTY) {
+        if (chunkKeysEqual(map->entries[slot].key, key)) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (map->entries[slot].value == CHUNK_MAP_EMPTY) {
+        return;
+    }
+
+    map->entries[slot].value = CHUNK_MAP_EMPTY;
+    map->count--;
+
+    unsigned int hole = slot;
+    unsigned int next = (slot + 1) & mask;
+
+    while (map->entries[next].value != CHUNK_MAP_EMPTY) {
+        unsigned int home = hashChunkKey(map->entries[next].key) & mask;
+
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            map->entries[hole] = map->entries[next];
+            map->entries[next].value = CHUNK_MAP_EMPTY;
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
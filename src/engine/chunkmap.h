@@ -0,0 +1,25 @@
+#ifndef BLOCKS_CHUNKMAP
+#define BLOCKS_CHUNKMAP
+
+#include "types.h"
+
+#define CHUNK_MAP_EMPTY -1
+
+typedef struct ChunkMapEntry {
+	IntVector3 key;
+	int value;
+} ChunkMapEntry;
+
+typedef struct ChunkMap {
+	ChunkMapEntry* entries;
+	int capacity;
+	int count;
+} ChunkMap;
+
+void initChunkMap(ChunkMap* map, int expectedCount);
+void freeChunkMap(ChunkMap* map);
+void chunkMapPut(ChunkMap* map, IntVector3 key, int value);
+int chunkMapGet(const ChunkMap* map, IntVector3 key);
+void chunkMapRemove(ChunkMap* map, IntVector3 key);
+
+#endif
@@ -0,0 +1,275 @@
+#include "connectivity.h"
+#include "constants.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ChunkVisit {
+    Chunk* chunk;
+    IntVector3 position;
+    int entryFace;
+    int directions;
+} ChunkVisit;
+
+static const IntVector3 faceDirections[BLOCK_FACE_COUNT] = {
+    { .x = 0, .y = 1, .z = 0 },
+    { .x = 0, .y = -1, .z = 0 },
+    { .x = 0, .y = 0, .z = 1 },
+    { .x = 0, .y = 0, .z = -1 },
+    { .x = 1, .y = 0, .z = 0 },
+    { .x = -1, .y = 0, .z = 0 }
+};
+
+static ChunkVisit* visits = NULL;
+static int visitCapacity = 0;
+static int reachFrame = 0;
+static bool isEnabled = true;
+static bool isTraversalReady = false;
+
+static ConnectivityStats connectivityStats = {
+    .rebuiltChunks = 0,
+    .visitedChunks = 0,
+    .reachedChunks = 0
+};
+
+ConnectivityStats getConnectivityStats() {
+    return connectivityStats;
+}
+
+bool isCaveCullingEnabled() {
+    return isEnabled;
+}
+
+void setCaveCullingEnabled(bool enabled) {
+    isEnabled = enabled;
+    isTraversalReady = false;
+}
+
+static int getBoundaryFaces(int x, int y, int z) {
+    int faces = 0;
+
+    faces |= (y == CHUNK_MASK) << BLOCK_FACE_TOP;
+    faces |= (y == 0) << BLOCK_FACE_BOTTOM;
+    faces |= (z == CHUNK_MASK) << BLOCK_FACE_FRONT;
+    faces |= (z == 0) << BLOCK_FACE_BACK;
+    faces |= (x == CHUNK_MASK) << BLOCK_FACE_RIGHT;
+    faces |= (x == 0) << BLOCK_FACE_LEFT;
+    return faces;
+}
+
+static void pushAirCell(uint16_t* filled, int* stack, int* count, int x, int y, int z) {
+    int row = y + z * CHUNK_SIZE;
+    uint16_t bit = (uint16_t)(1u << x);
+
+    if (filled[row] & bit) {
+        return;
+    }
+
+    filled[row] |= bit;
+    stack[(*count)++] = x + (row << CHUNK_SHIFT);
+}
+
+static int floodFillAir(uint16_t* filled, int* stack, int x, int y, int z) {
+    int faces = 0;
+    int count = 0;
+
+    pushAirCell(filled, stack, &count, x, y, z);
+
+    while (count > 0) {
+        int index = stack[--count];
+        int cellX = index & CHUNK_MASK;
+        int cellY = (index >> CHUNK_SHIFT) & CHUNK_MASK;
+        int cellZ = index >> (CHUNK_SHIFT * 2);
+
+        faces |= getBoundaryFaces(cellX, cellY, cellZ);
+
+        if (cellX > 0) {
+            pushAirCell(filled, stack, &count, cellX - 1, cellY, cellZ);
+        }
+        if (cellX < CHUNK_MASK) {
+            pushAirCell(filled, stack, &count, cellX + 1, cellY, cellZ);
+        }
+        if (cellY > 0) {
+            pushAirCell(filled, stack, &count, cellX, cellY - 1, cellZ);
+        }
+        if (cellY < CHUNK_MASK) {
+            pushAirCell(filled, stack, &count, cellX, cellY + 1, cellZ);
+        }
+        if (cellZ > 0) {
+            pushAirCell(filled, stack, &count, cellX, cellY, cellZ - 1);
+        }
+        if (cellZ < CHUNK_MASK) {
+            pushAirCell(filled, stack, &count, cellX, cellY, cellZ + 1);
+        }
+    }
+
+    return faces;
+}
+
+static uint64_t getFaceSetConnectivity(int faces) {
+    uint64_t connectivity = CONNECTIVITY_NONE;
+
+    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+        if (faces & (1 << face)) {
+            connectivity |= (uint64_t)faces << (face * BLOCK_FACE_COUNT);
+        }
+    }
+
+    return connectivity;
+}
+
+void updateChunkConnectivity(Chunk* chunk) {
+    chunk->hasConnectivity = true;
+    connectivityStats.rebuiltChunks++;
+
+    if (chunk->uniformType != CHUNK_MIXED) {
+        chunk->faceConnectivity = chunk->uniformType == 0 ? CONNECTIVITY_ALL : CONNECTIVITY_NONE;
+        return;
+    }
+
+    uint16_t filled[CHUNK_ROW_COUNT];
+    int stack[CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE];
+
+    memcpy(filled, chunk->solidRows, sizeof(filled));
+    chunk->faceConnectivity = CONNECTIVITY_NONE;
+
+    for (int row = 0; row < CHUNK_ROW_COUNT; row++) {
+        for (int x = 0; filled[row] != 0xFFFF && x < CHUNK_SIZE; x++) {
+            if (filled[row] & (1u << x)) {
+                continue;
+            }
+
+            int faces = floodFillAir(filled, stack, x, row & CHUNK_MASK, row >> CHUNK_SHIFT);
+            chunk->faceConnectivity |= getFaceSetConnectivity(faces);
+
+            if (chunk->faceConnectivity == CONNECTIVITY_ALL) {
+                return;
+            }
+        }
+    }
+}
+
+bool areChunkFacesConnected(Chunk* chunk, int fromFace, int toFace) {
+    if (!chunk->hasConnectivity) {
+        updateChunkConnectivity(chunk);
+    }
+
+    return (chunk->faceConnectivity >> (fromFace * BLOCK_FACE_COUNT + toFace)) & 1;
+}
+
+static bool isChunkInFrustum(const Frustum* frustum, IntVector3 position) {
+    Vector3 center = {
+        .x = position.x * CHUNK_SIZE + CHUNK_SIZE * 0.5,
+        .y = position.y * CHUNK_SIZE + CHUNK_SIZE * 0.5 - 1.5,
+        .z = position.z * CHUNK_SIZE + CHUNK_SIZE * 0.5
+    };
+    Vector3 extents = { .x = CHUNK_SIZE * 0.5, .y = CHUNK_SIZE * 0.5, .z = CHUNK_SIZE * 0.5 };
+
+    return isAABBInFrustum(frustum, &center, &extents);
+}
+
+static void pushChunkVisit(int* count, Chunk* chunk, IntVector3 position, int entryFace, int directions) {
+    if (*count == visitCapacity) {
+        visitCapacity = visitCapacity == 0 ? 1024 : visitCapacity * 2;
+        visits = realloc(visits, visitCapacity * sizeof(ChunkVisit));
+    }
+
+    if (chunk->reachedFrame != reachFrame) {
+        chunk->reachedFrame = reachFrame;
+        chunk->reachedFaces = 0;
+        connectivityStats.reachedChunks++;
+    }
+
+    if (entryFace != BLOCK_FACE_NONE) {
+        chunk->reachedFaces |= (uint8_t)(1 << entryFace);
+    }
+
+    visits[*count].chunk = chunk;
+    visits[*count].position = position;
+    visits[*count].entryFace = entryFace;
+    visits[*count].directions = directions;
+    (*count)++;
+}
+
+void findReachableChunks(WorldState* ws, Vector3 cameraPosition, const Frustum* frustum, int columnRadius) {
+    reachFrame++;
+    isTraversalReady = false;
+    connectivityStats.visitedChunks = 0;
+    connectivityStats.reachedChunks = 0;
+
+    if (!isEnabled) {
+        return;
+    }
+
+    int cameraY = (int)floor(cameraPosition.y + 1.5) >> CHUNK_SHIFT;
+    IntVector3 start = {
+        .x = (int)floor(cameraPosition.x) >> CHUNK_SHIFT,
+        .y = cameraY < 0 ? 0 : (cameraY >= CHUNK_SECTION_COUNT ? CHUNK_SECTION_COUNT - 1 : cameraY),
+        .z = (int)floor(cameraPosition.z) >> CHUNK_SHIFT
+    };
+    Chunk* startChunk = getChunkAt(ws, start.x, start.y, start.z);
+
+    if (startChunk == NULL) {
+        return;
+    }
+
+    int count = 0;
+    pushChunkVisit(&count, startChunk, start, BLOCK_FACE_NONE, 0);
+
+    for (int head = 0; head < count; head++) {
+        ChunkVisit visit = visits[head];
+        connectivityStats.visitedChunks++;
+
+        for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+            int oppositeFace = face ^ 1;
+
+            if (visit.directions & (1 << oppositeFace)) {
+                continue;
+            }
+
+            if (visit.entryFace != BLOCK_FACE_NONE && !areChunkFacesConnected(visit.chunk, visit.entryFace, face)) {
+                continue;
+            }
+
+            IntVector3 next = {
+                .x = visit.position.x + faceDirections[face].x,
+                .y = visit.position.y + faceDirections[face].y,
+                .z = visit.position.z + faceDirections[face].z
+            };
+
+            if (abs(next.x - start.x) > columnRadius || abs(next.z - start.z) > columnRadius) {
+                continue;
+            }
+
+            Chunk* neighbour = getChunkAt(ws, next.x, next.y, next.z);
+
+            if (neighbour == NULL) {
+                continue;
+            }
+
+            if (neighbour->reachedFrame == reachFrame && (neighbour->reachedFaces & (1 << oppositeFace))) {
+                continue;
+            }
+
+            if (!isChunkInFrustum(frustum, next)) {
+                continue;
+            }
+
+            pushChunkVisit(&count, neighbour, next, oppositeFace, visit.directions | (1 << face));
+        }
+    }
+
+    isTraversalReady = true;
+}
+
+bool isChunkReachable(const Chunk* chunk) {
+    return !isEnabled || !isTraversalReady || chunk->reachedFrame == reachFrame;
+}
+
+void freeConnectivity() {
+    free(visits);
+    visits = NULL;
+    visitCapacity = 0;
+    isTraversalReady = false;
+}
@@ -0,0 +1,29 @@
+#ifndef BLOCKS_CONNECTIVITY
+#define BLOCKS_CONNECTIVITY
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "types.h"
+#include "world.h"
+#include "frustum.h"
+#include "visibility.h"
+
+#define CONNECTIVITY_NONE 0ull
+#define CONNECTIVITY_ALL ((1ull << (BLOCK_FACE_COUNT * BLOCK_FACE_COUNT)) - 1)
+
+typedef struct ConnectivityStats {
+	int rebuiltChunks;
+	int visitedChunks;
+	int reachedChunks;
+} ConnectivityStats;
+
+bool isCaveCullingEnabled();
+void setCaveCullingEnabled(bool isEnabled);
+void updateChunkConnectivity(Chunk* chunk);
+bool areChunkFacesConnected(Chunk* chunk, int fromFace, int toFace);
+void findReachableChunks(WorldState* worldState, Vector3 cameraPosition, const Frustum* frustum, int columnRadius);
+bool isChunkReachable(const Chunk* chunk);
+ConnectivityStats getConnectivityStats();
+void freeConnectivity();
+
+#endif
@@ -26,6 +26,18 @@
 #define DEFAULT_OUTLINE_COLOR 0xA0A0A0
 #endif
 
+#ifndef HUD_TEXT_COLOR
+#define HUD_TEXT_COLOR 0xFFFF00
+#endif
+
+#ifndef CROSSHAIR_COLOR
+#define CROSSHAIR_COLOR 0xFFFFFF
+#endif
+
+#ifndef CARVE_SPHERE_RADIUS
+#define CARVE_SPHERE_RADIUS 4.0
+#endif
+
 #define BLOCK_FACE_TOP 0
 #define BLOCK_FACE_BOTTOM 1
 #define BLOCK_FACE_FRONT 2
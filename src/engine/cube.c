@@ -1,8 +1,14 @@
 #include "cube.h"
 #include "types.h"
+#include "constants.h"
+#include "visibility.h"
+#include "upload.h"
+
+#include <stdio.h>
+#include <stdlib.h>
 
 #if defined(__APPLE__)
-#include <OpenGL/gl.h>
+#include <OpenGL/gl3.h>
 #else
 #if defined(_WIN32)
 #include <windows.h>
@@ -11,27 +17,112 @@
 #include <GL/gl.h>
 #endif
 
-static GLuint vboVertexId = 0;
-static GLuint vboColorId = 0;
+static GLuint cubeProgramId = 0;
+static GLuint cubeVertexBufferId = 0;
+static GLuint cubeVertexArrayId = 0;
+static GLuint quadIndexBufferId = 0;
+static GLuint meshVertexArrayId = 0;
+static GLuint instanceVertexArrayId = 0;
+static GLuint geometryBufferId = 0;
+static GLuint indirectProgramId = 0;
 
-const GLfloat vertices[] =
-{
-    -0.5, -0.5, -0.5,   -0.5, -0.5,  0.5,   -0.5,  0.5,  0.5,   -0.5,  0.5, -0.5,
-     0.5, -0.5, -0.5,    0.5, -0.5,  0.5,    0.5,  0.5,  0.5,    0.5,  0.5, -0.5,
-    -0.5, -0.5, -0.5,   -0.5, -0.5,  0.5,    0.5, -0.5,  0.5,    0.5, -0.5, -0.5,
-    -0.5,  0.5, -0.5,   -0.5,  0.5,  0.5,    0.5,  0.5,  0.5,    0.5,  0.5, -0.5,
-    -0.5, -0.5, -0.5,   -0.5,  0.5, -0.5,    0.5,  0.5, -0.5,    0.5, -0.5, -0.5,
-    -0.5, -0.5,  0.5,   -0.5,  0.5,  0.5,    0.5,  0.5,  0.5,    0.5, -0.5,  0.5
-};
+static GLint viewProjectionLocation = -1;
+static GLint originLocation = -1;
+static GLint scaleLocation = -1;
+static GLint baseTypeLocation = -1;
+static GLint cellSizeLocation = -1;
+static GLint outlineColorLocation = -1;
+static GLint outlineWidthLocation = -1;
+static GLint paletteLocation = -1;
+static GLint indirectViewProjectionLocation = -1;
+static GLint indirectOutlineColorLocation = -1;
+static GLint indirectOutlineWidthLocation = -1;
+
+static bool isProgramBound = false;
+static GLuint boundVertexArrayId = 0;
+static GLuint currentBaseType = 0;
+static GLuint currentCellSize = 0;
+static GLuint currentOutlineHexColor = 0;
+static GLfloat currentOutlineWidth = 1.0f;
+static Vector3 currentScale = { .x = 1.0, .y = 1.0, .z = 1.0 };
+static GLfloat outlineWidth = 1.0f;
+static Matrix4 currentViewProjection;
+
+static CubeDrawCommand* batchCommands = NULL;
+static GLfloat* batchOrigins = NULL;
+static int batchCount = 0;
+static int batchCapacity = 0;
+static int batchGeometryOffset = GEOMETRY_NONE;
+static int batchGeometrySize = 0;
 
-const GLfloat outlineColors[] =
+static const char* cubeVertexShaderSource =
+    "#version 330 core\n"
+    "layout(location = 0) in uint vertexData;\n"
+    "layout(location = 1) in uint instanceData;\n"
+    "uniform mat4 viewProjection;\n"
+    "uniform vec3 origin;\n"
+    "uniform vec3 scale;\n"
+    "uniform uint baseType;\n"
+    "uniform uint cellSize;\n"
+    "uniform vec3 palette[16];\n"
+    "out vec3 blockColor;\n"
+    "out vec2 edgeCoord;\n"
+    "void main() {\n"
+    "    vec3 corner = vec3(vertexData & 31u, (vertexData >> 5) & 31u, (vertexData >> 10) & 31u);\n"
+    "    vec3 offset = vec3(instanceData & 15u, (instanceData >> 4) & 15u, (instanceData >> 8) & 15u);\n"
+    "    uint face = (vertexData >> 15) & 7u;\n"
+    "    uint type = ((vertexData >> 18) & 255u) | ((instanceData >> 12) & 255u) | baseType;\n"
+    "    edgeCoord = face < 2u ? corner.xz : (face < 4u ? corner.xy : corner.zy);\n"
+    "    if (cellSize != 0u) {\n"
+    "        float size = float(cellSize);\n"
+    "        offset = vec3(float(instanceData & 15u) * size, float((instanceData >> 8) & 511u), float((instanceData >> 4) & 15u) * size);\n"
+    "        corner *= vec3(size, float((instanceData >> 17) & 511u), size);\n"
+    "        type = instanceData >> 26;\n"
+    "    }\n"
+    "    blockColor = palette[min(type, 15u)];\n"
+    "    gl_Position = viewProjection * vec4(origin + (corner + offset) * scale, 1.0);\n"
+    "}\n";
+
+static const char* indirectVertexShaderSource =
+    "#version 430 core\n"
+    "#extension GL_ARB_shader_draw_parameters : require\n"
+    "layout(location = 0) in uint vertexData;\n"
+    "layout(std430, binding = 0) readonly buffer ChunkOrigins {\n"
+    "    vec4 origins[];\n"
+    "};\n"
+    "uniform mat4 viewProjection;\n"
+    "uniform vec3 palette[16];\n"
+    "out vec3 blockColor;\n"
+    "out vec2 edgeCoord;\n"
+    "void main() {\n"
+    "    vec3 corner = vec3(vertexData & 31u, (vertexData >> 5) & 31u, (vertexData >> 10) & 31u);\n"
+    "    uint face = (vertexData >> 15) & 7u;\n"
+    "    uint type = (vertexData >> 18) & 255u;\n"
+    "    edgeCoord = face < 2u ? corner.xz : (face < 4u ? corner.xy : corner.zy);\n"
+    "    blockColor = palette[min(type, 15u)];\n"
+    "    gl_Position = viewProjection * vec4(origins[gl_DrawIDARB].xyz + corner, 1.0);\n"
+    "}\n";
+
+static const char* cubeFragmentShaderSource =
+    "#version 330 core\n"
+    "in vec3 blockColor;\n"
+    "in vec2 edgeCoord;\n"
+    "uniform vec3 outlineColor;\n"
+    "uniform float outlineWidth;\n"
+    "out vec4 fragmentColor;\n"
+    "void main() {\n"
+    "    vec2 edgeDistance = min(fract(edgeCoord), 1.0 - fract(edgeCoord)) / fwidth(edgeCoord);\n"
+    "    fragmentColor = vec4(min(edgeDistance.x, edgeDistance.y) < outlineWidth * 0.5 ? outlineColor : blockColor, 1.0);\n"
+    "}\n";
+
+static const GLubyte cubeCorners[BLOCK_FACE_COUNT][4][3] =
 {
-    1, 1, 1,   1, 1, 1,   1, 1, 1,   1, 1, 1,
-    1, 1, 1,   1, 1, 1,   1, 1, 1,   1, 1, 1,
-    1, 1, 1,   1, 1, 1,   1, 1, 1,   1, 1, 1,
-    1, 1, 1,   1, 1, 1,   1, 1, 1,   1, 1, 1,
-    1, 1, 1,   1, 1, 1,   1, 1, 1,   1, 1, 1,
-    1, 1, 1,   1, 1, 1,   1, 1, 1,   1, 1, 1
+    { { 0, 1, 0 }, { 0, 1, 1 }, { 1, 1, 1 }, { 1, 1, 0 } },
+    { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 0, 0, 1 } },
+    { { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } },
+    { { 0, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 }, { 1, 0, 0 } },
+    { { 1, 0, 0 }, { 1, 1, 0 }, { 1, 1, 1 }, { 1, 0, 1 } },
+    { { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 1 }, { 0, 1, 0 } }
 };
 
 GLint getColorByType(int type) {
@@ -55,56 +146,421 @@ static void hexToRGB(GLuint hex, GLfloat* rgb) {
     rgb[2] = (hex & 0xFF) / 255.0f;
 }
 
-void drawCube(Vector3 position, GLuint hexColor, GLuint outlineHexColor) {
-    GLfloat faceColors[24 * 3];
-    GLfloat rgb[3];
-    hexToRGB(hexColor, rgb);
+static void useCubeProgram() {
+    if (!isProgramBound) {
+        glUseProgram(cubeProgramId);
+        isProgramBound = true;
+    }
+}
+
+static void bindCubeVertexArray(GLuint vertexArray) {
+    if (boundVertexArrayId != vertexArray) {
+        glBindVertexArray(vertexArray);
+        boundVertexArrayId = vertexArray;
+    }
+}
 
-    for (int i = 0; i < 24; ++i) {
-        faceColors[i * 3 + 0] = rgb[0];
-        faceColors[i * 3 + 1] = rgb[1];
-        faceColors[i * 3 + 2] = rgb[2];
+static void setCubeDrawState(Vector3 origin, Vector3 scale, GLuint baseType, GLuint cellSize, GLuint outlineHexColor) {
+    useCubeProgram();
+    glUniform3f(originLocation, origin.x, origin.y, origin.z);
+
+    if (scale.x != currentScale.x || scale.y != currentScale.y || scale.z != currentScale.z) {
+        glUniform3f(scaleLocation, scale.x, scale.y, scale.z);
+        currentScale = scale;
+    }
+
+    if (baseType != currentBaseType) {
+        glUniform1ui(baseTypeLocation, baseType);
+        currentBaseType = baseType;
     }
 
-    glPushMatrix();
-    glTranslatef(position.x + 0.5f, position.y - 1.0f, position.z + 0.5f);
+    if (cellSize != currentCellSize) {
+        glUniform1ui(cellSizeLocation, cellSize);
+        currentCellSize = cellSize;
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, vboVertexId);
-    glVertexPointer(3, GL_FLOAT, 0, NULL);
+    if (outlineHexColor != currentOutlineHexColor) {
+        GLfloat rgbOutline[3];
+        hexToRGB(outlineHexColor, rgbOutline);
+        glUniform3f(outlineColorLocation, rgbOutline[0], rgbOutline[1], rgbOutline[2]);
+        currentOutlineHexColor = outlineHexColor;
+    }
+
+    if (outlineWidth != currentOutlineWidth) {
+        glUniform1f(outlineWidthLocation, outlineWidth);
+        currentOutlineWidth = outlineWidth;
+    }
+}
+
+void setCubeViewProjection(const Matrix4* viewProjection) {
+    currentViewProjection = *viewProjection;
+    useCubeProgram();
+    glUniformMatrix4fv(viewProjectionLocation, 1, GL_FALSE, viewProjection->m);
+}
+
+void setCubeOutlineWidth(GLfloat width) {
+    outlineWidth = width;
+}
+
+void drawCube(Vector3 position, int type, GLuint outlineHexColor) {
+    Vector3 origin = { .x = position.x, .y = position.y - 1.5, .z = position.z };
+    Vector3 scale = { .x = 1.0, .y = 1.0, .z = 1.0 };
+
+    setCubeDrawState(origin, scale, (GLuint)type, 0, outlineHexColor);
+    bindCubeVertexArray(cubeVertexArrayId);
+    glDrawElements(GL_TRIANGLES, BLOCK_FACE_COUNT * 6, GL_UNSIGNED_INT, NULL);
+}
+
+void drawBox(Vector3 center, Vector3 size, int type, GLuint outlineHexColor) {
+    Vector3 origin = {
+        .x = center.x - size.x * 0.5,
+        .y = center.y - size.y * 0.5,
+        .z = center.z - size.z * 0.5
+    };
+
+    setCubeDrawState(origin, size, (GLuint)type, 0, outlineHexColor);
+    bindCubeVertexArray(cubeVertexArrayId);
+    glDrawElements(GL_TRIANGLES, BLOCK_FACE_COUNT * 6, GL_UNSIGNED_INT, NULL);
+}
+
+static void syncGeometryVertexArrays() {
+    if (geometryBufferId == getGeometryBuffer()) {
+        return;
+    }
 
+    geometryBufferId = getGeometryBuffer();
+
+    bindCubeVertexArray(meshVertexArrayId);
+    glBindBuffer(GL_ARRAY_BUFFER, geometryBufferId);
+    glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(GLuint), NULL);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void drawCubeMesh(Vector3 origin, int baseVertex, int quadCount, GLuint outlineHexColor) {
+    Vector3 scale = { .x = 1.0, .y = 1.0, .z = 1.0 };
+
+    setCubeDrawState(origin, scale, 0, 0, outlineHexColor);
+    syncGeometryVertexArrays();
+    bindCubeVertexArray(meshVertexArrayId);
+    glDrawElementsBaseVertex(GL_TRIANGLES, quadCount * 6, GL_UNSIGNED_INT, NULL, baseVertex);
+}
+
+static void drawInstances(Vector3 origin, GLuint cellSize, int instanceOffset, int instanceCount, GLuint outlineHexColor) {
+    Vector3 scale = { .x = 1.0, .y = 1.0, .z = 1.0 };
+
+    setCubeDrawState(origin, scale, 0, cellSize, outlineHexColor);
+    bindCubeVertexArray(instanceVertexArrayId);
+    glBindBuffer(GL_ARRAY_BUFFER, getGeometryBuffer());
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(GLuint), (const void*)(size_t)instanceOffset);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glColorPointer(3, GL_FLOAT, 0, faceColors);
+    glDrawElementsInstanced(GL_TRIANGLES, BLOCK_FACE_COUNT * 6, GL_UNSIGNED_INT, NULL, instanceCount);
+}
+
+void drawCubeInstances(Vector3 origin, int instanceOffset, int instanceCount, GLuint outlineHexColor) {
+    drawInstances(origin, 0, instanceOffset, instanceCount, outlineHexColor);
+}
+
+void drawCubeBoxes(Vector3 origin, int cellSize, int instanceOffset, int instanceCount, GLuint outlineHexColor) {
+    drawInstances(origin, (GLuint)cellSize, instanceOffset, instanceCount, outlineHexColor);
+}
+
+bool isCubeMeshBatchSupported() {
+    return indirectProgramId != 0;
+}
+
+void addCubeMeshToBatch(Vector3 origin, int baseVertex, int quadCount) {
+    if (batchCount == batchCapacity) {
+        batchCapacity = batchCapacity == 0 ? 1024 : batchCapacity * 2;
+        batchCommands = realloc(batchCommands, batchCapacity * sizeof(CubeDrawCommand));
+        batchOrigins = realloc(batchOrigins, batchCapacity * 4 * sizeof(GLfloat));
+    }
+
+    CubeDrawCommand* command = &batchCommands[batchCount];
+    command->count = quadCount * 6;
+    command->instanceCount = 1;
+    command->firstIndex = 0;
+    command->baseVertex = baseVertex;
+    command->baseInstance = 0;
+
+    GLfloat* chunkOrigin = &batchOrigins[batchCount * 4];
+    chunkOrigin[0] = origin.x;
+    chunkOrigin[1] = origin.y;
+    chunkOrigin[2] = origin.z;
+    chunkOrigin[3] = 0.0f;
+
+    batchCount++;
+}
+
+bool drawCubeMeshBatch(GLuint outlineHexColor) {
+    if (batchCount == 0) {
+        return false;
+    }
 
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    glDrawArrays(GL_QUADS, 0, 24);
+#if !defined(__APPLE__)
+    int commandBytes = batchCount * sizeof(CubeDrawCommand);
+    int originBytes = batchCount * 4 * sizeof(GLfloat);
+    int originStart = (batchCapacity * sizeof(CubeDrawCommand) + GEOMETRY_ALIGNMENT - 1) & ~(GEOMETRY_ALIGNMENT - 1);
+    int batchBytes = originStart + batchCapacity * 4 * sizeof(GLfloat);
 
-    glDisableClientState(GL_COLOR_ARRAY); 
+    if (batchGeometrySize < batchBytes) {
+        freeGeometry(batchGeometryOffset, batchGeometrySize);
+        batchGeometryOffset = allocateGeometry(batchBytes);
+        batchGeometrySize = batchBytes;
+    }
 
     GLfloat rgbOutline[3];
     hexToRGB(outlineHexColor, rgbOutline);
 
-    glColor3f(rgbOutline[0], rgbOutline[1], rgbOutline[2]);
+    glUseProgram(indirectProgramId);
+    isProgramBound = false;
+    glUniformMatrix4fv(indirectViewProjectionLocation, 1, GL_FALSE, currentViewProjection.m);
+    glUniform3f(indirectOutlineColorLocation, rgbOutline[0], rgbOutline[1], rgbOutline[2]);
+    glUniform1f(indirectOutlineWidthLocation, outlineWidth);
 
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    glDrawArrays(GL_QUADS, 0, 24);
+    syncGeometryVertexArrays();
+    bindCubeVertexArray(meshVertexArrayId);
 
-    glEnableClientState(GL_COLOR_ARRAY); 
+    uploadGeometry(batchGeometryOffset, batchCommands, commandBytes);
+    uploadGeometry(batchGeometryOffset + originStart, batchOrigins, originBytes);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, geometryBufferId, batchGeometryOffset + originStart, originBytes);
 
-    glPopMatrix();
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, geometryBufferId);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)(size_t)batchGeometryOffset, batchCount, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+#endif
+
+    batchCount = 0;
+    return true;
+}
+
+void finishCubeDrawing() {
+    if (boundVertexArrayId != 0) {
+        glBindVertexArray(0);
+        boundVertexArrayId = 0;
+    }
+
+    if (isProgramBound) {
+        glUseProgram(0);
+        isProgramBound = false;
+    }
+}
 
+static GLuint createCubeVertexArray(GLuint vertexBuffer, bool isInstanced) {
+    GLuint vertexArray;
+
+    glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+
+    glEnableVertexAttribArray(0);
+
+    if (vertexBuffer != 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(GLuint), NULL);
+    }
+
+    if (isInstanced) {
+        glEnableVertexAttribArray(1);
+        glVertexAttribDivisor(1, 1);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndexBufferId);
+
+    glBindVertexArray(boundVertexArrayId);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return vertexArray;
+}
+
+static GLuint compileCubeShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    GLint isCompiled = GL_FALSE;
+
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+
+    if (isCompiled != GL_TRUE) {
+        char log[512];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        fprintf(stderr, "Cube shader compilation failed: %s\n", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+static GLuint linkCubeProgram(const char* vertexShaderSource) {
+    GLuint vertexShader = compileCubeShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fragmentShader = compileCubeShader(GL_FRAGMENT_SHADER, cubeFragmentShaderSource);
+    GLuint programId = 0;
+    GLint isLinked = GL_FALSE;
+
+    if (vertexShader != 0 && fragmentShader != 0) {
+        programId = glCreateProgram();
+        glAttachShader(programId, vertexShader);
+        glAttachShader(programId, fragmentShader);
+        glLinkProgram(programId);
+        glGetProgramiv(programId, GL_LINK_STATUS, &isLinked);
+
+        if (isLinked != GL_TRUE) {
+            fprintf(stderr, "Cube shader program failed to link\n");
+            glDeleteProgram(programId);
+            programId = 0;
+        }
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    return programId;
+}
+
+static void initCubeProgram() {
+    GLfloat palette[CUBE_PALETTE_SIZE * 3];
+
+    for (int type = 0; type < CUBE_PALETTE_SIZE; type++) {
+        hexToRGB(getColorByType(type), &palette[type * 3]);
+    }
+
+    viewProjectionLocation = glGetUniformLocation(cubeProgramId, "viewProjection");
+    originLocation = glGetUniformLocation(cubeProgramId, "origin");
+    scaleLocation = glGetUniformLocation(cubeProgramId, "scale");
+    baseTypeLocation = glGetUniformLocation(cubeProgramId, "baseType");
+    cellSizeLocation = glGetUniformLocation(cubeProgramId, "cellSize");
+    outlineColorLocation = glGetUniformLocation(cubeProgramId, "outlineColor");
+    outlineWidthLocation = glGetUniformLocation(cubeProgramId, "outlineWidth");
+    paletteLocation = glGetUniformLocation(cubeProgramId, "palette");
+
+    glUseProgram(cubeProgramId);
+    glUniform3fv(paletteLocation, CUBE_PALETTE_SIZE, palette);
+    glUniform3f(scaleLocation, currentScale.x, currentScale.y, currentScale.z);
+    glUniform1ui(baseTypeLocation, currentBaseType);
+    glUniform1ui(cellSizeLocation, currentCellSize);
+    glUniform3f(outlineColorLocation, 0.0f, 0.0f, 0.0f);
+    glUniform1f(outlineWidthLocation, currentOutlineWidth);
+    glUseProgram(0);
+
+    glVertexAttribI4ui(1, 0, 0, 0, 0);
+}
+
+static void initIndirectProgram() {
+#if !defined(__APPLE__)
+    GLfloat palette[CUBE_PALETTE_SIZE * 3];
+
+    if (!GLEW_VERSION_4_3 || !GLEW_ARB_shader_draw_parameters) {
+        return;
+    }
+
+    indirectProgramId = linkCubeProgram(indirectVertexShaderSource);
+
+    if (indirectProgramId == 0) {
+        return;
+    }
+
+    for (int type = 0; type < CUBE_PALETTE_SIZE; type++) {
+        hexToRGB(getColorByType(type), &palette[type * 3]);
+    }
+
+    indirectViewProjectionLocation = glGetUniformLocation(indirectProgramId, "viewProjection");
+    indirectOutlineColorLocation = glGetUniformLocation(indirectProgramId, "outlineColor");
+    indirectOutlineWidthLocation = glGetUniformLocation(indirectProgramId, "outlineWidth");
+
+    glUseProgram(indirectProgramId);
+    glUniform3fv(glGetUniformLocation(indirectProgramId, "palette"), CUBE_PALETTE_SIZE, palette);
+    glUseProgram(0);
+#endif
 }
 
-void initCubeVBOs() {
-    glGenBuffers(1, &vboVertexId);
+static void initCubeBuffers() {
+    GLuint cubeVertices[BLOCK_FACE_COUNT * 4];
+    GLuint* quadIndices = malloc(CUBE_MAX_QUAD_COUNT * 6 * sizeof(GLuint));
+
+    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+        for (int corner = 0; corner < 4; corner++) {
+            const GLubyte* position = cubeCorners[face][corner];
+            cubeVertices[face * 4 + corner] = PACK_CUBE_VERTEX(position[0], position[1], position[2], face, 0);
+        }
+    }
+
+    for (int quad = 0; quad < CUBE_MAX_QUAD_COUNT; quad++) {
+        GLuint first = quad * 4;
+        quadIndices[quad * 6 + 0] = first;
+        quadIndices[quad * 6 + 1] = first + 1;
+        quadIndices[quad * 6 + 2] = first + 2;
+        quadIndices[quad * 6 + 3] = first;
+        quadIndices[quad * 6 + 4] = first + 2;
+        quadIndices[quad * 6 + 5] = first + 3;
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, vboVertexId);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glGenBuffers(1, &cubeVertexBufferId);
+    glBindBuffer(GL_ARRAY_BUFFER, cubeVertexBufferId);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+    glGenBuffers(1, &quadIndexBufferId);
+    glBindBuffer(GL_ARRAY_BUFFER, quadIndexBufferId);
+    glBufferData(GL_ARRAY_BUFFER, CUBE_MAX_QUAD_COUNT * 6 * sizeof(GLuint), quadIndices, GL_STATIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    free(quadIndices);
+
+    cubeVertexArrayId = createCubeVertexArray(cubeVertexBufferId, false);
+    meshVertexArrayId = createCubeVertexArray(0, false);
+    instanceVertexArrayId = createCubeVertexArray(cubeVertexBufferId, true);
 }
 
-void freeCubeVBOs() {
-    glDeleteBuffers(1, &vboVertexId);
-    glDeleteBuffers(1, &vboColorId);
+bool initCubeRenderer() {
+#if !defined(__APPLE__)
+    if (!GLEW_VERSION_3_3) {
+        fprintf(stderr, "OpenGL 3.3 is required\n");
+        return false;
+    }
+#endif
+
+    cubeProgramId = linkCubeProgram(cubeVertexShaderSource);
+
+    if (cubeProgramId == 0) {
+        return false;
+    }
+
+    initCubeProgram();
+    initIndirectProgram();
+    initCubeBuffers();
+    return true;
+}
+
+void freeCubeRenderer() {
+    finishCubeDrawing();
+
+    GLuint vertexArrays[3] = { cubeVertexArrayId, meshVertexArrayId, instanceVertexArrayId };
+    glDeleteVertexArrays(3, vertexArrays);
+    cubeVertexArrayId = 0;
+    meshVertexArrayId = 0;
+    instanceVertexArrayId = 0;
+    geometryBufferId = 0;
+
+    glDeleteBuffers(1, &cubeVertexBufferId);
+    glDeleteBuffers(1, &quadIndexBufferId);
+
+    if (cubeProgramId != 0) {
+        glDeleteProgram(cubeProgramId);
+        cubeProgramId = 0;
+    }
+
+    if (indirectProgramId != 0) {
+        glDeleteProgram(indirectProgramId);
+        indirectProgramId = 0;
+    }
+
+    freeGeometry(batchGeometryOffset, batchGeometrySize);
+    batchGeometryOffset = GEOMETRY_NONE;
+    batchGeometrySize = 0;
+
+    free(batchCommands);
+    free(batchOrigins);
+    batchCommands = NULL;
+    batchOrigins = NULL;
+    batchCount = 0;
+    batchCapacity = 0;
 }
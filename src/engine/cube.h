@@ -2,12 +2,46 @@
 #define BLOCKS_CUBE
 
 #include "types.h"
+#include "matrix.h"
+#include <stdbool.h>
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
 #include <GL/glew.h>
+#endif
 
-void drawCube(Vector3 position, GLuint hexColor, GLuint outlineHexColor);
+#define CUBE_PALETTE_SIZE 16
+#define CUBE_MAX_QUAD_COUNT (16 * 16 * 16 * 6)
+
+#define PACK_CUBE_VERTEX(x, y, z, face, type) \
+	((GLuint)(x) | ((GLuint)(y) << 5) | ((GLuint)(z) << 10) | ((GLuint)(face) << 15) | ((GLuint)(type) << 18))
+#define PACK_CUBE_INSTANCE(x, y, z, type) \
+	((GLuint)(x) | ((GLuint)(y) << 4) | ((GLuint)(z) << 8) | ((GLuint)(type) << 12))
+#define PACK_CUBE_BOX_INSTANCE(cellX, cellZ, bottom, height, type) \
+	((GLuint)(cellX) | ((GLuint)(cellZ) << 4) | ((GLuint)(bottom) << 8) | ((GLuint)(height) << 17) | ((GLuint)(type) << 26))
+
+typedef struct CubeDrawCommand {
+	GLuint count;
+	GLuint instanceCount;
+	GLuint firstIndex;
+	GLint baseVertex;
+	GLuint baseInstance;
+} CubeDrawCommand;
+
+void setCubeViewProjection(const Matrix4* viewProjection);
+void setCubeOutlineWidth(GLfloat width);
+void drawCube(Vector3 position, int type, GLuint outlineHexColor);
+void drawBox(Vector3 center, Vector3 size, int type, GLuint outlineHexColor);
+void drawCubeMesh(Vector3 origin, int baseVertex, int quadCount, GLuint outlineHexColor);
+void drawCubeInstances(Vector3 origin, int instanceOffset, int instanceCount, GLuint outlineHexColor);
+void drawCubeBoxes(Vector3 origin, int cellSize, int instanceOffset, int instanceCount, GLuint outlineHexColor);
+bool isCubeMeshBatchSupported();
+void addCubeMeshToBatch(Vector3 origin, int baseVertex, int quadCount);
+bool drawCubeMeshBatch(GLuint outlineHexColor);
+void finishCubeDrawing();
 GLint getColorByType(int type);
 
-void initCubeVBOs();
-void freeCubeVBOs();
+bool initCubeRenderer();
+void freeCubeRenderer();
 
-#endif
\ No newline at end of file
+#endif
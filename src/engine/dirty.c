@@ -0,0 +1,103 @@
+#include "dirty.h"
+#include "visibility.h"
+
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define popcount16(value) ((int)__popcnt16(value))
+#else
+#define popcount16(value) __builtin_popcount(value)
+#endif
+
+static IntVector3* dirtyChunks = NULL;
+static int dirtyChunkCount = 0;
+static int dirtyChunkCapacity = 0;
+
+static DirtyStats dirtyStats = {
+    .edits = 0,
+    .rebuiltChunks = 0,
+    .rebuiltRows = 0
+};
+
+DirtyStats getDirtyStats() {
+    return dirtyStats;
+}
+
+void markChunkDirty(WorldState* ws, Chunk* chunk, uint16_t slices) {
+    if (chunk == NULL || slices == 0) {
+        return;
+    }
+
+    if (chunk->dirtySlices == 0) {
+        if (dirtyChunkCount == dirtyChunkCapacity) {
+            dirtyChunkCapacity = dirtyChunkCapacity == 0 ? 64 : dirtyChunkCapacity * 2;
+            dirtyChunks = realloc(dirtyChunks, dirtyChunkCapacity * sizeof(IntVector3));
+        }
+
+        dirtyChunks[dirtyChunkCount++] = chunk->position;
+    }
+
+    chunk->dirtySlices |= slices;
+}
+
+void markBlockDirty(WorldState* ws, int x, int y, int z) {
+    int chunkX = x >> CHUNK_SHIFT;
+    int chunkY = y >> CHUNK_SHIFT;
+    int chunkZ = z >> CHUNK_SHIFT;
+    int localX = x & CHUNK_MASK;
+    int localY = y & CHUNK_MASK;
+    int localZ = z & CHUNK_MASK;
+    uint16_t slice = (uint16_t)(1u << localZ);
+
+    markChunkDirty(ws, getChunkAt(ws, chunkX, chunkY, chunkZ), (uint16_t)((7u << localZ) >> 1));
+
+    if (localX == 0) {
+        markChunkDirty(ws, getChunkAt(ws, chunkX - 1, chunkY, chunkZ), slice);
+    } else if (localX == CHUNK_MASK) {
+        markChunkDirty(ws, getChunkAt(ws, chunkX + 1, chunkY, chunkZ), slice);
+    }
+
+    if (localY == 0) {
+        markChunkDirty(ws, getChunkAt(ws, chunkX, chunkY - 1, chunkZ), slice);
+    } else if (localY == CHUNK_MASK) {
+        markChunkDirty(ws, getChunkAt(ws, chunkX, chunkY + 1, chunkZ), slice);
+    }
+
+    if (localZ == 0) {
+        markChunkDirty(ws, getChunkAt(ws, chunkX, chunkY, chunkZ - 1), (uint16_t)(1u << CHUNK_MASK));
+    } else if (localZ == CHUNK_MASK) {
+        markChunkDirty(ws, getChunkAt(ws, chunkX, chunkY, chunkZ + 1), 1);
+    }
+
+    dirtyStats.edits++;
+}
+
+void processDirtyChunks(WorldState* ws) {
+    for (int i = 0; i < dirtyChunkCount; i++) {
+        IntVector3 position = dirtyChunks[i];
+        Chunk* chunk = getChunkAt(ws, position.x, position.y, position.z);
+
+        if (chunk == NULL || chunk->dirtySlices == 0) {
+            continue;
+        }
+
+        uint16_t slices = chunk->dirtySlices;
+        chunk->dirtySlices = 0;
+
+        updateChunkVisibilitySlices(ws, chunk, slices);
+        ws->revision++;
+
+        dirtyStats.rebuiltChunks++;
+        dirtyStats.rebuiltRows += popcount16(slices) * CHUNK_SIZE;
+    }
+
+    dirtyChunkCount = 0;
+}
+
+void freeDirtyChunks() {
+    free(dirtyChunks);
+    dirtyChunks = NULL;
+    dirtyChunkCount = 0;
+    dirtyChunkCapacity = 0;
+}
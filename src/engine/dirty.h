@@ -0,0 +1,19 @@
+#ifndef BLOCKS_DIRTY
+#define BLOCKS_DIRTY
+
+#include <stdint.h>
+#include "world.h"
+
+typedef struct DirtyStats {
+	int edits;
+	int rebuiltChunks;
+	int rebuiltRows;
+} DirtyStats;
+
+void markChunkDirty(WorldState* worldState, Chunk* chunk, uint16_t slices);
+void markBlockDirty(WorldState* worldState, int x, int y, int z);
+void processDirtyChunks(WorldState* worldState);
+void freeDirtyChunks();
+DirtyStats getDirtyStats();
+
+#endif
@@ -6,35 +6,76 @@
 #include "gametime.h"
 #include "frustum.h"
 #include "userinputs.h"
+#include "streaming.h"
+#include "region.h"
+#include "journal.h"
+#include "dirty.h"
+#include "bulkedit.h"
+#include "cube.h"
+#include "matrix.h"
+#include "upload.h"
+#include "lod.h"
+#include "occlusion.h"
+#include "connectivity.h"
+#include "meshworkers.h"
+#include "visibleset.h"
+#include "overdraw.h"
+#include "hud.h"
+#include "constants.h"
 
 #include <stdio.h>
 #include <math.h>
 #include <stdbool.h>
 #include <time.h>
 
-#if defined(__APPLE__)
-#include <OpenGL/glu.h>
-#include <GLUT/glut.h>
-#else
-#if defined(_WIN32)
-#include <windows.h>
-#endif
-#include <GL/glu.h>
-#include <GL/glut.h>
-#endif
+static const char* renderModeNames[RENDER_MODE_COUNT] = { "cubes", "mesh", "instanced", "indirect" };
 
 void processDisplayLoop(GLFWwindow* window) {
     double lastFpsTime = glfwGetTime();
     int frameCount = 0;
-    char fpsText[32];
+    char fpsText[96];
+    char chunkText[160];
+    char editText[224];
+    char storageText[160];
+    char positionText[128];
+    char renderModeText[128];
+    char cullText[160];
+    char occlusionText[160];
+    char uploadText[160];
+    char meshText[160];
+    char hudText[128];
+    char overdrawText[160];
+    HudStats lastHudStats = getHudStats();
+    OverdrawStats lastOverdrawStats = getOverdrawStats();
+    MeshWorkerStats lastMeshWorkerStats = getMeshWorkerStats();
+    UploadStats lastUploadStats = getUploadStats();
+    RenderStats sampledRenderStats = getRenderStats();
+    FrustumStats sampledFrustumStats = getFrustumStats();
+    LodStats sampledLodStats = getLodStats();
+    VisibleSetStats sampledVisibleSetStats = getVisibleSetStats();
+    OcclusionStats sampledOcclusionStats = getOcclusionStats();
+    UploadStats sampledUploadStats = lastUploadStats;
+    MeshWorkerStats sampledMeshWorkerStats = lastMeshWorkerStats;
+    double uploadedKilobytes = 0.0;
+    int uploadedMeshJobs = 0;
+    int deferredMeshJobs = 0;
+    int sampledDeferredMeshJobs = 0;
+    double worldCpuTime = 0.0;
     sprintf(fpsText, "FPS: N/A");
+    sprintf(hudText, "HUD: N/A");
+    sprintf(overdrawText, "Overdraw: N/A");
 
+    initJournal();
     generateWorld();
 
     while(!glfwWindowShouldClose(window))
     {
         processDeltaTime();
+        beginUploadFrame();
         processInputTick();
+        updateChunkStreaming(getViewportPosition());
+        processDirtyChunks(getWorldStateGlobal());
+        updateJournal();
 
         GLint windowWidth, windowHeight;
 
@@ -44,10 +85,6 @@ void processDisplayLoop(GLFWwindow* window) {
         glClearColor(0.5294, 0.8078, 0.9215, 1.0);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glMatrixMode(GL_PROJECTION_MATRIX);
-        glLoadIdentity();
-        gluPerspective(60, (double)windowWidth / (double)windowHeight, 0.1, 100);
-        
         addForcesBasedOnInputs();
         adjustForcesBasedOnCollision();
         processForces();
@@ -59,77 +96,145 @@ void processDisplayLoop(GLFWwindow* window) {
         Vector3 position = getViewportPosition();
         PlayerState playerState = getPlayerState();
 
-        gluLookAt(
-            position.x,
-            position.y + playerState.height - 1.0,
-            position.z,
-            rotation.x + position.x,
-            rotation.y + position.y + playerState.height - 1.0,
-            rotation.z + position.z,
-            0, 1, 0
-        );
-
-        glMatrixMode(GL_MODELVIEW_MATRIX);
+        Vector3 eye = {
+            .x = position.x,
+            .y = position.y + playerState.height - 1.0,
+            .z = position.z
+        };
+        Vector3 center = {
+            .x = rotation.x + eye.x,
+            .y = rotation.y + eye.y,
+            .z = rotation.z + eye.z
+        };
+        Vector3 up = { .x = 0.0, .y = 1.0, .z = 0.0 };
+
+        Matrix4 projection = getPerspectiveMatrix(60, (double)windowWidth / (double)windowHeight, 0.1, getViewDistance());
+        Matrix4 viewProjection = multiplyMatrices(projection, getLookAtMatrix(eye, center, up));
 
         Frustum viewFrustum;
-        extractFrustumPlanes(&viewFrustum);
-
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glEnableClientState(GL_COLOR_ARRAY);
-
-        drawWorld(&viewFrustum);
+        extractFrustumPlanes(&viewFrustum, &viewProjection);
+
+        setCubeViewProjection(&viewProjection);
+        beginOverdrawQuery(windowWidth, windowHeight);
+        double worldStartTime = glfwGetTime();
+        drawWorld(&viewFrustum, &viewProjection);
+        worldCpuTime += glfwGetTime() - worldStartTime;
+        endOverdrawQuery();
         drawInHandItem();
-
-        glDisableClientState(GL_COLOR_ARRAY);
-        glDisableClientState(GL_VERTEX_ARRAY);
+        finishCubeDrawing();
+        endUploadFrame();
 
         frameCount++;
+        deferredMeshJobs += getMeshWorkerStats().frameDeferredJobs;
         double currentTime = glfwGetTime();
         double elapsedTime = currentTime - lastFpsTime;
 
         if (elapsedTime >= 1.0) {
             double fps = (double)frameCount / elapsedTime;
-            sprintf(fpsText, "FPS: %.2f", fps);
+            FrameTimeStats frameTimeStats = getFrameTimeStats();
+            sprintf(fpsText, "FPS: %.2f, frame ms p50 %.1f, p95 %.1f, p99 %.1f, max %.1f", fps,
+                frameTimeStats.p50, frameTimeStats.p95, frameTimeStats.p99, frameTimeStats.max);
+
+            HudStats hudStats = getHudStats();
+            sprintf(hudText, "HUD: %d glyphs, %d quads, %d rebuilds and %d reuses in the last second", hudStats.glyphCount,
+                hudStats.quadCount, hudStats.rebuilds - lastHudStats.rebuilds, hudStats.reuses - lastHudStats.reuses);
+            lastHudStats = hudStats;
+
+            OverdrawStats overdrawStats = getOverdrawStats();
+            long long coveredSamples = overdrawStats.coveredSamples - lastOverdrawStats.coveredSamples;
+            sprintf(overdrawText, "Overdraw: %.2f samples per pixel, world CPU %.2f ms per frame, visible set %s (F7)",
+                coveredSamples > 0 ? (double)(overdrawStats.samplesPassed - lastOverdrawStats.samplesPassed) / coveredSamples : 0.0,
+                worldCpuTime * 1000.0 / frameCount, isVisibleSetCacheEnabled() ? "cached" : "uncached");
+            lastOverdrawStats = overdrawStats;
+            worldCpuTime = 0.0;
+
+            sampledRenderStats = getRenderStats();
+            sampledFrustumStats = getFrustumStats();
+            sampledLodStats = getLodStats();
+            sampledVisibleSetStats = getVisibleSetStats();
+            sampledOcclusionStats = getOcclusionStats();
+            sampledUploadStats = getUploadStats();
+            sampledMeshWorkerStats = getMeshWorkerStats();
+            uploadedKilobytes = (sampledUploadStats.totalUploadedBytes - lastUploadStats.totalUploadedBytes) / 1024.0;
+            uploadedMeshJobs = sampledMeshWorkerStats.uploadedJobs - lastMeshWorkerStats.uploadedJobs;
+            sampledDeferredMeshJobs = deferredMeshJobs;
+            lastUploadStats = sampledUploadStats;
+            lastMeshWorkerStats = sampledMeshWorkerStats;
+            deferredMeshJobs = 0;
+
             frameCount = 0;
             lastFpsTime = currentTime;
         }
 
-        setupOrthographicProjection(windowWidth, windowHeight);
-
-        renderText(10.0f, windowHeight - 20.0f, fpsText, 1.0f, 1.0f, 0.0f);
-		renderText(windowWidth / 2.0f, windowHeight / 2.0f, "+", 1.0f, 1.0f, 1.0f);
-
-        restorePerspectiveProjection();
+        StreamingStats streamingStats = getChunkStreamingStats();
+        sprintf(chunkText, "Chunks: %d resident, %d pending, %d evicted, %d discarded, %d sections elided",
+            streamingStats.residentChunks, streamingStats.pendingChunks, streamingStats.evictedChunks, streamingStats.discardedChunks,
+            streamingStats.elidedSections);
+
+        DirtyStats dirtyStats = getDirtyStats();
+        BulkEditStats bulkEditStats = getBulkEditStats();
+        JournalStats journalStats = getJournalStats();
+        sprintf(editText, "Edits: %d, %.1f rows rebuilt per edit, %d bulk edits (%d blocks), journal %d records, %d compactions, %d failed writes",
+            dirtyStats.edits, dirtyStats.edits > 0 ? (double)dirtyStats.rebuiltRows / dirtyStats.edits : 0.0,
+            bulkEditStats.operations, bulkEditStats.changedBlocks, journalStats.journalRecords, journalStats.compactions,
+            journalStats.failedWrites);
+
+        RegionStats regionStats = getRegionStats();
+        sprintf(storageText, "Regions: %d columns loaded (%.1f KB), %d saved, %d failed saves, %d compacted",
+            regionStats.loadedColumns, regionStats.loadedBytes / 1024.0, regionStats.savedColumns, regionStats.failedSaves,
+            regionStats.compactedRegions);
+
+        int blockX = (int)floor(position.x);
+        int blockZ = (int)floor(position.z);
+        sprintf(positionText, "Position: %d, %d, %d, surface %d of type %d", blockX, (int)floor(position.y), blockZ,
+            getSurfaceHeight(getWorldStateGlobal(), blockX, blockZ), getSurfaceType(getWorldStateGlobal(), blockX, blockZ));
+
+        bool isFallback = getRenderMode() == RENDER_MODE_INDIRECT && !isCubeMeshBatchSupported();
+        sprintf(renderModeText, "Render: %s%s (F3), %d draw calls, %d vertices", renderModeNames[getRenderMode()],
+            isFallback ? " unsupported, using mesh" : "", sampledRenderStats.drawCalls, sampledRenderStats.drawnVertices);
+
+        sprintf(cullText, "Culling: %d chunks, %d blocks culled, %d AABB tests, visible set %s: %d chunks (F7)",
+            sampledRenderStats.culledChunks, sampledRenderStats.culledBlocks, sampledFrustumStats.aabbTests,
+            !isVisibleSetCacheEnabled() ? "uncached" : (sampledVisibleSetStats.isCached ? "cached" : "rebuilt"),
+            sampledVisibleSetStats.visibleChunks);
+        sprintf(occlusionText, "Occlusion%s: %d chunks, %d LOD cells, %d of %d boxes (F4), caves%s: %d chunks (F5)",
+            isOcclusionEnabled() ? "" : " off", sampledRenderStats.occludedChunks, sampledLodStats.occludedCells,
+            sampledOcclusionStats.occludedBoxes, sampledOcclusionStats.testedBoxes, isCaveCullingEnabled() ? "" : " off",
+            sampledRenderStats.caveCulledChunks);
+
+        sprintf(uploadText, "Uploads: %.1f KB in the last second, %d fence waits, arena %.1f of %.1f MB%s",
+            uploadedKilobytes, sampledUploadStats.fenceWaits, sampledUploadStats.arenaUsedBytes / 1048576.0,
+            sampledUploadStats.arenaBytes / 1048576.0, sampledUploadStats.isPersistentMapped ? ", persistent" : "");
+
+        sprintf(meshText, "Meshing%s: %d pending, %d uploaded and %d deferred in the last second, %d discarded (F6)",
+            isMeshWorkersEnabled() ? "" : " off", sampledMeshWorkerStats.pendingJobs, uploadedMeshJobs,
+            sampledDeferredMeshJobs, sampledMeshWorkerStats.discardedJobs);
+
+        beginHud(windowWidth, windowHeight);
+        drawHudText(10.0f, windowHeight - 20.0f, fpsText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 40.0f, chunkText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 60.0f, editText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 80.0f, renderModeText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 100.0f, cullText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 120.0f, occlusionText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 140.0f, uploadText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 160.0f, meshText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 180.0f, storageText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 200.0f, positionText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 220.0f, hudText, HUD_TEXT_COLOR);
+        drawHudText(10.0f, windowHeight - 240.0f, overdrawText, HUD_TEXT_COLOR);
+        drawHudQuad(windowWidth / 2.0f - 7.0f, windowHeight / 2.0f - 1.0f, 14.0f, 2.0f, CROSSHAIR_COLOR);
+        drawHudQuad(windowWidth / 2.0f - 1.0f, windowHeight / 2.0f - 7.0f, 2.0f, 14.0f, CROSSHAIR_COLOR);
+        endHud();
 
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
+    finishChunkStreaming();
+    saveWorld();
+    closeJournal();
+    freeDirtyChunks();
     removeWorld();
-}
-
-void setupOrthographicProjection(int windowWidth, int windowHeight) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    gluOrtho2D(0, windowWidth, 0, windowHeight);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-}
-
-void restorePerspectiveProjection() {
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
-}
-
-void renderText(float x, float y, char *string, float r, float g, float b) {
-    glColor3f(r, g, b);
-    glRasterPos2f(x, y);
-    char *c;
-    for (c = string; *c != '\0'; c++) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-    }
+    closeRegionFiles();
 }
@@ -1,11 +1,10 @@
 #ifndef BLOCKS_LOOP
 #define BLOCKS_LOOP
+#if defined(__APPLE__)
+#define GLFW_INCLUDE_GLCOREARB
+#endif
 #include <GLFW/glfw3.h>
 
 void processDisplayLoop(GLFWwindow* window);
 
-void renderText(float x, float y, char *string, float r, float g, float b);
-void setupOrthographicProjection(int windowWidth, int windowHeight);
-void restorePerspectiveProjection(void);
-
 #endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "fileutils.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <direct.h>
+#include <io.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+void makeDirectory(const char* path) {
+#if defined(_WIN32)
+    _mkdir(path);
+#else
+    mkdir(path, 0755);
+#endif
+}
+
+bool syncFile(FILE* file) {
+    if (fflush(file) != 0) {
+        return false;
+    }
+
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool syncFileAtPath(const char* path) {
+    FILE* file = fopen(path, "r+b");
+
+    if (file == NULL) {
+        return false;
+    }
+
+    bool isSynced = syncFile(file);
+    fclose(file);
+
+    return isSynced;
+}
+
+bool replaceFile(const char* sourcePath, const char* destinationPath) {
+#if defined(_WIN32)
+    return MoveFileExA(sourcePath, destinationPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(sourcePath, destinationPath) == 0;
+#endif
+}
@@ -0,0 +1,12 @@
+#ifndef BLOCKS_FILEUTILS
+#define BLOCKS_FILEUTILS
+
+#include <stdbool.h>
+#include <stdio.h>
+
+void makeDirectory(const char* path);
+bool syncFile(FILE* file);
+bool syncFileAtPath(const char* path);
+bool replaceFile(const char* sourcePath, const char* destinationPath);
+
+#endif
@@ -1,15 +1,25 @@
 #include "frustum.h"
-#if defined(__APPLE__)
-#include <OpenGL/gl.h>
-#else
-#if defined(_WIN32)
-#include <windows.h>
-#endif
-#include <GL/glew.h>
-#include <GL/gl.h>
-#endif
 #include <math.h>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FRUSTUM_SSE
+#include <xmmintrin.h>
+#endif
+
+static FrustumStats frustumStats = {
+    .aabbTests = 0,
+    .batchedTests = 0
+};
+
+FrustumStats getFrustumStats() {
+    return frustumStats;
+}
+
+void resetFrustumStats() {
+    frustumStats.aabbTests = 0;
+    frustumStats.batchedTests = 0;
+}
+
 static void normalizePlane(Plane* plane) {
     float mag = sqrtf(plane->x * plane->x + plane->y * plane->y + plane->z * plane->z);
     if (mag > 0.00001f) {
@@ -20,33 +30,8 @@ static void normalizePlane(Plane* plane) {
     }
 }
 
-void extractFrustumPlanes(Frustum* frustum) {
-    GLfloat proj[16];
-    GLfloat modl[16];
-    GLfloat clip[16];
-
-    glGetFloatv(GL_PROJECTION_MATRIX, proj);
-    glGetFloatv(GL_MODELVIEW_MATRIX, modl);
-
-    clip[0] = modl[0] * proj[0] + modl[1] * proj[4] + modl[2] * proj[8] + modl[3] * proj[12];
-    clip[1] = modl[0] * proj[1] + modl[1] * proj[5] + modl[2] * proj[9] + modl[3] * proj[13];
-    clip[2] = modl[0] * proj[2] + modl[1] * proj[6] + modl[2] * proj[10] + modl[3] * proj[14];
-    clip[3] = modl[0] * proj[3] + modl[1] * proj[7] + modl[2] * proj[11] + modl[3] * proj[15];
-
-    clip[4] = modl[4] * proj[0] + modl[5] * proj[4] + modl[6] * proj[8] + modl[7] * proj[12];
-    clip[5] = modl[4] * proj[1] + modl[5] * proj[5] + modl[6] * proj[9] + modl[7] * proj[13];
-    clip[6] = modl[4] * proj[2] + modl[5] * proj[6] + modl[6] * proj[10] + modl[7] * proj[14];
-    clip[7] = modl[4] * proj[3] + modl[5] * proj[7] + modl[6] * proj[11] + modl[7] * proj[15];
-
-    clip[8] = modl[8] * proj[0] + modl[9] * proj[4] + modl[10] * proj[8] + modl[11] * proj[12];
-    clip[9] = modl[8] * proj[1] + modl[9] * proj[5] + modl[10] * proj[9] + modl[11] * proj[13];
-    clip[10] = modl[8] * proj[2] + modl[9] * proj[6] + modl[10] * proj[10] + modl[11] * proj[14];
-    clip[11] = modl[8] * proj[3] + modl[9] * proj[7] + modl[10] * proj[11] + modl[11] * proj[15];
-
-    clip[12] = modl[12] * proj[0] + modl[13] * proj[4] + modl[14] * proj[8] + modl[15] * proj[12];
-    clip[13] = modl[12] * proj[1] + modl[13] * proj[5] + modl[14] * proj[9] + modl[15] * proj[13];
-    clip[14] = modl[12] * proj[2] + modl[13] * proj[6] + modl[14] * proj[10] + modl[15] * proj[14];
-    clip[15] = modl[12] * proj[3] + modl[13] * proj[7] + modl[14] * proj[11] + modl[15] * proj[15];
+void extractFrustumPlanes(Frustum* frustum, const Matrix4* viewProjection) {
+    const float* clip = viewProjection->m;
 
     frustum->planes[0].x = clip[3] + clip[0];
     frustum->planes[0].y = clip[7] + clip[4];
@@ -83,9 +68,25 @@ void extractFrustumPlanes(Frustum* frustum) {
     frustum->planes[5].z = clip[11] - clip[10];
     frustum->planes[5].w = clip[15] - clip[14];
     normalizePlane(&frustum->planes[5]);
+
+    for (int i = 0; i < 6; i++) {
+        frustum->planeX[i] = frustum->planes[i].x;
+        frustum->planeY[i] = frustum->planes[i].y;
+        frustum->planeZ[i] = frustum->planes[i].z;
+        frustum->planeW[i] = frustum->planes[i].w;
+    }
+}
+
+void expandFrustum(Frustum* frustum, float margin) {
+    for (int i = 0; i < 6; i++) {
+        frustum->planes[i].w += margin;
+        frustum->planeW[i] = frustum->planes[i].w;
+    }
 }
 
 bool isAABBInFrustum(const Frustum* frustum, const Vector3* center, const Vector3* extents) {
+    frustumStats.aabbTests++;
+
     for (int i = 0; i < 6; i++) {
         const Plane* p = &frustum->planes[i];
 
@@ -108,4 +109,78 @@ void getCubeAABB(Vector3 basePosition, Vector3* center, Vector3* extents) {
     extents->x = 0.5f;
     extents->y = 0.5f;
     extents->z = 0.5f;
-}
\ No newline at end of file
+}
+
+FrustumClass classifyAABBInFrustum(const Frustum* frustum, const Vector3* center, const Vector3* extents) {
+    FrustumClass result = FRUSTUM_INSIDE;
+    frustumStats.aabbTests++;
+
+    for (int i = 0; i < 6; i++) {
+        const Plane* p = &frustum->planes[i];
+
+        float dist_center = p->x * center->x + p->y * center->y + p->z * center->z + p->w;
+        float radius_proj = extents->x * fabsf(p->x) + extents->y * fabsf(p->y) + extents->z * fabsf(p->z);
+
+        if (dist_center < -radius_proj) {
+            return FRUSTUM_OUTSIDE;
+        }
+
+        if (dist_center < radius_proj) {
+            result = FRUSTUM_INTERSECTS;
+        }
+    }
+
+    return result;
+}
+
+int classifyAABBsInFrustum4(const Frustum* frustum, const float* centers, const float* extents, int* insideMask) {
+    frustumStats.aabbTests += 4;
+    frustumStats.batchedTests++;
+
+#if defined(FRUSTUM_SSE)
+    __m128 centerX = _mm_loadu_ps(centers);
+    __m128 centerY = _mm_loadu_ps(centers + 4);
+    __m128 centerZ = _mm_loadu_ps(centers + 8);
+    __m128 extentX = _mm_loadu_ps(extents);
+    __m128 extentY = _mm_loadu_ps(extents + 4);
+    __m128 extentZ = _mm_loadu_ps(extents + 8);
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 outside = _mm_setzero_ps();
+    __m128 intersects = _mm_setzero_ps();
+
+    for (int i = 0; i < 6; i++) {
+        __m128 planeX = _mm_set1_ps(frustum->planeX[i]);
+        __m128 planeY = _mm_set1_ps(frustum->planeY[i]);
+        __m128 planeZ = _mm_set1_ps(frustum->planeZ[i]);
+
+        __m128 distance = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(planeX, centerX), _mm_mul_ps(planeY, centerY)),
+            _mm_add_ps(_mm_mul_ps(planeZ, centerZ), _mm_set1_ps(frustum->planeW[i])));
+        __m128 radius = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, planeX), extentX), _mm_mul_ps(_mm_andnot_ps(signMask, planeY), extentY)),
+            _mm_mul_ps(_mm_andnot_ps(signMask, planeZ), extentZ));
+
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_xor_ps(radius, signMask)));
+        intersects = _mm_or_ps(intersects, _mm_cmplt_ps(distance, radius));
+    }
+
+    int outsideBits = _mm_movemask_ps(outside);
+    *insideMask = ~_mm_movemask_ps(intersects) & 0xF;
+    return ~outsideBits & 0xF;
+#else
+    int visibleMask = 0;
+    *insideMask = 0;
+
+    for (int box = 0; box < 4; box++) {
+        Vector3 center = { .x = centers[box], .y = centers[box + 4], .z = centers[box + 8] };
+        Vector3 extent = { .x = extents[box], .y = extents[box + 4], .z = extents[box + 8] };
+        FrustumClass result = classifyAABBInFrustum(frustum, &center, &extent);
+
+        visibleMask |= (result != FRUSTUM_OUTSIDE) << box;
+        *insideMask |= (result == FRUSTUM_INSIDE) << box;
+    }
+
+    frustumStats.aabbTests -= 4;
+    return visibleMask;
+#endif
+}
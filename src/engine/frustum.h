@@ -4,6 +4,7 @@
 
 #include <stdbool.h>
 #include "types.h"
+#include "matrix.h"
 
 typedef struct {
     float x, y, z, w;
@@ -11,10 +12,30 @@ typedef struct {
 
 typedef struct {
     Plane planes[6];
+    float planeX[6];
+    float planeY[6];
+    float planeZ[6];
+    float planeW[6];
 } Frustum;
 
-void extractFrustumPlanes(Frustum* frustum);
+typedef enum {
+    FRUSTUM_OUTSIDE,
+    FRUSTUM_INTERSECTS,
+    FRUSTUM_INSIDE
+} FrustumClass;
+
+typedef struct {
+    int aabbTests;
+    int batchedTests;
+} FrustumStats;
+
+void extractFrustumPlanes(Frustum* frustum, const Matrix4* viewProjection);
+void expandFrustum(Frustum* frustum, float margin);
 bool isAABBInFrustum(const Frustum* frustum, const Vector3* center, const Vector3* extents);
+FrustumClass classifyAABBInFrustum(const Frustum* frustum, const Vector3* center, const Vector3* extents);
+int classifyAABBsInFrustum4(const Frustum* frustum, const float* centers, const float* extents, int* insideMask);
+FrustumStats getFrustumStats();
+void resetFrustumStats();
 void getCubeAABB(Vector3 basePosition, Vector3* center, Vector3* extents);
 
 #endif
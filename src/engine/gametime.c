@@ -1,6 +1,8 @@
 #include "gametime.h"
 
 #include <time.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -9,6 +11,10 @@
 long deltaTimeValue = -1;
 long previousTime = -1;
 
+static double frameTimes[FRAME_TIME_HISTORY];
+static int frameTimeCount = 0;
+static int frameTimeNext = 0;
+
 double deltaTime() {
     return deltaTimeValue / 1000.0;
 }
@@ -40,8 +46,41 @@ void processDeltaTime() {
 
     if (previousTime == -1) {
         previousTime = currentTime;
+    } else {
+        frameTimes[frameTimeNext] = (currentTime - previousTime) / 1000.0;
+        frameTimeNext = (frameTimeNext + 1) % FRAME_TIME_HISTORY;
+        frameTimeCount += frameTimeCount < FRAME_TIME_HISTORY;
     }
 
     deltaTimeValue = currentTime - previousTime;
     previousTime = currentTime;
 }
+
+static int compareFrameTimes(const void* a, const void* b) {
+    double first = *(const double*)a;
+    double second = *(const double*)b;
+    return (first > second) - (first < second);
+}
+
+static double getFrameTimePercentile(const double* sorted, int count, int percentile) {
+    int index = (count * percentile + 99) / 100 - 1;
+    return sorted[index < 0 ? 0 : index];
+}
+
+FrameTimeStats getFrameTimeStats() {
+    FrameTimeStats stats = { .p50 = 0, .p95 = 0, .p99 = 0, .max = 0, .samples = frameTimeCount };
+    double sorted[FRAME_TIME_HISTORY];
+
+    if (frameTimeCount == 0) {
+        return stats;
+    }
+
+    memcpy(sorted, frameTimes, frameTimeCount * sizeof(double));
+    qsort(sorted, frameTimeCount, sizeof(double), compareFrameTimes);
+
+    stats.p50 = getFrameTimePercentile(sorted, frameTimeCount, 50);
+    stats.p95 = getFrameTimePercentile(sorted, frameTimeCount, 95);
+    stats.p99 = getFrameTimePercentile(sorted, frameTimeCount, 99);
+    stats.max = sorted[frameTimeCount - 1];
+    return stats;
+}
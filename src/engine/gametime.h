@@ -1,7 +1,18 @@
 #ifndef BLOCKS_GAMETIME
 #define BLOCKS_GAMETIME
 
+#define FRAME_TIME_HISTORY 240
+
+typedef struct FrameTimeStats {
+	double p50;
+	double p95;
+	double p99;
+	double max;
+	int samples;
+} FrameTimeStats;
+
 double deltaTime();
 void processDeltaTime();
+FrameTimeStats getFrameTimeStats();
 
 #endif
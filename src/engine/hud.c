@@ -0,0 +1,387 @@
+#include "hud.h"
+#include "hudfont.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include <GL/glew.h>
+#include <GL/gl.h>
+#endif
+
+#define HUD_ATLAS_WIDTH (HUD_ATLAS_COLUMNS * HUD_CELL_WIDTH)
+#define HUD_ATLAS_HEIGHT (HUD_ATLAS_ROWS * HUD_CELL_HEIGHT)
+#define HUD_SOLID_CELL HUD_GLYPH_COUNT
+
+typedef struct HudVertex {
+    GLfloat x, y;
+    GLfloat u, v;
+    GLubyte color[4];
+} HudVertex;
+
+typedef struct HudCommand {
+    GLfloat x, y;
+    GLfloat width, height;
+    GLuint color;
+    int length;
+} HudCommand;
+
+typedef struct HudCommandBuffer {
+    unsigned char* data;
+    int size;
+    int capacity;
+} HudCommandBuffer;
+
+static GLuint hudProgramId = 0;
+static GLuint hudVertexArrayId = 0;
+static GLuint hudVertexBufferId = 0;
+static GLuint atlasTextureId = 0;
+static GLint screenSizeLocation = -1;
+
+static HudCommandBuffer commandBuffers[2] = { { .data = NULL, .size = 0, .capacity = 0 }, { .data = NULL, .size = 0, .capacity = 0 } };
+static HudCommandBuffer* commands = &commandBuffers[0];
+static HudCommandBuffer* previousCommands = &commandBuffers[1];
+static bool hasPreviousCommands = false;
+
+static HudVertex* vertices = NULL;
+static int vertexCount = 0;
+static int vertexCapacity = 0;
+
+static int screenWidth = 0;
+static int screenHeight = 0;
+static int uniformWidth = 0;
+static int uniformHeight = 0;
+
+static HudStats hudStats = {
+    .glyphCount = 0,
+    .quadCount = 0,
+    .rebuilds = 0,
+    .reuses = 0
+};
+
+static const char* hudVertexShaderSource =
+    "#version 330 core\n"
+    "layout(location = 0) in vec2 position;\n"
+    "layout(location = 1) in vec2 texCoord;\n"
+    "layout(location = 2) in vec4 color;\n"
+    "uniform vec2 screenSize;\n"
+    "out vec2 atlasCoord;\n"
+    "out vec4 glyphColor;\n"
+    "void main() {\n"
+    "    atlasCoord = texCoord;\n"
+    "    glyphColor = color;\n"
+    "    gl_Position = vec4(position / screenSize * 2.0 - 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* hudFragmentShaderSource =
+    "#version 330 core\n"
+    "in vec2 atlasCoord;\n"
+    "in vec4 glyphColor;\n"
+    "uniform sampler2D atlas;\n"
+    "out vec4 fragmentColor;\n"
+    "void main() {\n"
+    "    if (texture(atlas, atlasCoord).r < 0.5) {\n"
+    "        discard;\n"
+    "    }\n"
+    "    fragmentColor = glyphColor;\n"
+    "}\n";
+
+HudStats getHudStats() {
+    return hudStats;
+}
+
+static unsigned char* reserveHudCommand(int size) {
+    if (commands->size + size > commands->capacity) {
+        while (commands->size + size > commands->capacity) {
+            commands->capacity = commands->capacity == 0 ? 4096 : commands->capacity * 2;
+        }
+        commands->data = realloc(commands->data, commands->capacity);
+    }
+
+    unsigned char* data = commands->data + commands->size;
+    commands->size += size;
+    return data;
+}
+
+void beginHud(int width, int height) {
+    screenWidth = width;
+    screenHeight = height;
+    commands->size = 0;
+}
+
+void drawHudText(float x, float y, const char* text, GLuint hexColor) {
+    HudCommand command = { .x = x, .y = y, .width = 0.0f, .height = 0.0f, .color = hexColor, .length = (int)strlen(text) };
+    unsigned char* data = reserveHudCommand(sizeof(HudCommand) + command.length);
+
+    memcpy(data, &command, sizeof(HudCommand));
+    memcpy(data + sizeof(HudCommand), text, command.length);
+}
+
+void drawHudQuad(float x, float y, float width, float height, GLuint hexColor) {
+    HudCommand command = { .x = x, .y = y, .width = width, .height = height, .color = hexColor, .length = -1 };
+    memcpy(reserveHudCommand(sizeof(HudCommand)), &command, sizeof(HudCommand));
+}
+
+static void pushHudQuad(float x, float y, float width, float height, int cell, float cellWidth, float cellHeight, GLuint hexColor) {
+    if (vertexCount + 6 > vertexCapacity) {
+        vertexCapacity = vertexCapacity == 0 ? 6144 : vertexCapacity * 2;
+        vertices = realloc(vertices, vertexCapacity * sizeof(HudVertex));
+    }
+
+    float u0 = (float)(cell % HUD_ATLAS_COLUMNS * HUD_CELL_WIDTH) / HUD_ATLAS_WIDTH;
+    float v0 = (float)(cell / HUD_ATLAS_COLUMNS * HUD_CELL_HEIGHT) / HUD_ATLAS_HEIGHT;
+    float u1 = u0 + cellWidth / HUD_ATLAS_WIDTH;
+    float v1 = v0 + cellHeight / HUD_ATLAS_HEIGHT;
+    float corners[6][4] = {
+        { x, y, u0, v0 },
+        { x + width, y, u1, v0 },
+        { x + width, y + height, u1, v1 },
+        { x, y, u0, v0 },
+        { x + width, y + height, u1, v1 },
+        { x, y + height, u0, v1 }
+    };
+
+    for (int i = 0; i < 6; i++) {
+        HudVertex* vertex = &vertices[vertexCount++];
+        vertex->x = corners[i][0];
+        vertex->y = corners[i][1];
+        vertex->u = corners[i][2];
+        vertex->v = corners[i][3];
+        vertex->color[0] = (GLubyte)((hexColor >> 16) & 0xFF);
+        vertex->color[1] = (GLubyte)((hexColor >> 8) & 0xFF);
+        vertex->color[2] = (GLubyte)(hexColor & 0xFF);
+        vertex->color[3] = 0xFF;
+    }
+}
+
+static void rebuildHudVertices() {
+    vertexCount = 0;
+    hudStats.glyphCount = 0;
+    hudStats.quadCount = 0;
+
+    for (int offset = 0; offset < commands->size;) {
+        HudCommand command;
+        memcpy(&command, commands->data + offset, sizeof(HudCommand));
+        offset += sizeof(HudCommand);
+
+        if (command.length < 0) {
+            pushHudQuad(command.x, command.y, command.width, command.height, HUD_SOLID_CELL, 1.0f, 1.0f, command.color);
+            hudStats.quadCount++;
+            continue;
+        }
+
+        const char* text = (const char*)commands->data + offset;
+        float penX = command.x;
+        offset += command.length;
+
+        for (int i = 0; i < command.length; i++) {
+            int glyph = (unsigned char)text[i] - HUD_FIRST_GLYPH;
+
+            if (glyph < 0 || glyph >= HUD_GLYPH_COUNT) {
+                continue;
+            }
+
+            int advance = hudGlyphAdvances[glyph];
+
+            if (glyph != 0) {
+                pushHudQuad(penX, command.y - HUD_FONT_BASELINE, advance, HUD_FONT_HEIGHT, glyph, advance, HUD_FONT_HEIGHT, command.color);
+                hudStats.glyphCount++;
+            }
+
+            penX += advance;
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, hudVertexBufferId);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(HudVertex), vertices, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void endHud() {
+    if (hasPreviousCommands && commands->size == previousCommands->size
+        && memcmp(commands->data, previousCommands->data, commands->size) == 0) {
+        hudStats.reuses++;
+    } else {
+        rebuildHudVertices();
+        hudStats.rebuilds++;
+
+        HudCommandBuffer* swap = previousCommands;
+        previousCommands = commands;
+        commands = swap;
+        hasPreviousCommands = true;
+    }
+
+    if (vertexCount == 0) {
+        return;
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    glUseProgram(hudProgramId);
+
+    if (screenWidth != uniformWidth || screenHeight != uniformHeight) {
+        glUniform2f(screenSizeLocation, (GLfloat)screenWidth, (GLfloat)screenHeight);
+        uniformWidth = screenWidth;
+        uniformHeight = screenHeight;
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlasTextureId);
+    glBindVertexArray(hudVertexArrayId);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+    glEnable(GL_DEPTH_TEST);
+}
+
+static GLuint compileHudShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    GLint isCompiled = GL_FALSE;
+
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+
+    if (isCompiled != GL_TRUE) {
+        char log[512];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        fprintf(stderr, "HUD shader compilation failed: %s\n", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+static GLuint linkHudProgram() {
+    GLuint vertexShader = compileHudShader(GL_VERTEX_SHADER, hudVertexShaderSource);
+    GLuint fragmentShader = compileHudShader(GL_FRAGMENT_SHADER, hudFragmentShaderSource);
+    GLuint programId = 0;
+    GLint isLinked = GL_FALSE;
+
+    if (vertexShader != 0 && fragmentShader != 0) {
+        programId = glCreateProgram();
+        glAttachShader(programId, vertexShader);
+        glAttachShader(programId, fragmentShader);
+        glLinkProgram(programId);
+        glGetProgramiv(programId, GL_LINK_STATUS, &isLinked);
+
+        if (isLinked != GL_TRUE) {
+            fprintf(stderr, "HUD shader program failed to link\n");
+            glDeleteProgram(programId);
+            programId = 0;
+        }
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    return programId;
+}
+
+static void bakeHudAtlas() {
+    GLubyte* texels = calloc(HUD_ATLAS_WIDTH * HUD_ATLAS_HEIGHT, sizeof(GLubyte));
+
+    for (int glyph = 0; glyph < HUD_GLYPH_COUNT; glyph++) {
+        int cellX = glyph % HUD_ATLAS_COLUMNS * HUD_CELL_WIDTH;
+        int cellY = glyph / HUD_ATLAS_COLUMNS * HUD_CELL_HEIGHT;
+
+        for (int row = 0; row < HUD_FONT_HEIGHT; row++) {
+            uint32_t mask = hudGlyphRows[glyph][row];
+            GLubyte* texelRow = &texels[(cellY + HUD_FONT_HEIGHT - 1 - row) * HUD_ATLAS_WIDTH + cellX];
+
+            for (int x = 0; mask != 0; x++, mask >>= 1) {
+                texelRow[x] = (mask & 1) ? 0xFF : 0x00;
+            }
+        }
+    }
+
+    int solidX = HUD_SOLID_CELL % HUD_ATLAS_COLUMNS * HUD_CELL_WIDTH;
+    int solidY = HUD_SOLID_CELL / HUD_ATLAS_COLUMNS * HUD_CELL_HEIGHT;
+
+    for (int y = 0; y < HUD_CELL_HEIGHT; y++) {
+        memset(&texels[(solidY + y) * HUD_ATLAS_WIDTH + solidX], 0xFF, HUD_CELL_WIDTH);
+    }
+
+    glGenTextures(1, &atlasTextureId);
+    glBindTexture(GL_TEXTURE_2D, atlasTextureId);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, HUD_ATLAS_WIDTH, HUD_ATLAS_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE, texels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    free(texels);
+}
+
+static void initHudVertexArray() {
+    glGenVertexArrays(1, &hudVertexArrayId);
+    glGenBuffers(1, &hudVertexBufferId);
+
+    glBindVertexArray(hudVertexArrayId);
+    glBindBuffer(GL_ARRAY_BUFFER, hudVertexBufferId);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(HudVertex), (const void*)offsetof(HudVertex, x));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(HudVertex), (const void*)offsetof(HudVertex, u));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(HudVertex), (const void*)offsetof(HudVertex, color));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool initHud() {
+    hudProgramId = linkHudProgram();
+
+    if (hudProgramId == 0) {
+        return false;
+    }
+
+    screenSizeLocation = glGetUniformLocation(hudProgramId, "screenSize");
+    glUseProgram(hudProgramId);
+    glUniform1i(glGetUniformLocation(hudProgramId, "atlas"), 0);
+    glUseProgram(0);
+
+    bakeHudAtlas();
+    initHudVertexArray();
+    return true;
+}
+
+void freeHud() {
+    glDeleteVertexArrays(1, &hudVertexArrayId);
+    glDeleteBuffers(1, &hudVertexBufferId);
+    glDeleteTextures(1, &atlasTextureId);
+    hudVertexArrayId = 0;
+    hudVertexBufferId = 0;
+    atlasTextureId = 0;
+
+    if (hudProgramId != 0) {
+        glDeleteProgram(hudProgramId);
+        hudProgramId = 0;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        free(commandBuffers[i].data);
+        commandBuffers[i].data = NULL;
+        commandBuffers[i].size = 0;
+        commandBuffers[i].capacity = 0;
+    }
+
+    free(vertices);
+    vertices = NULL;
+    vertexCount = 0;
+    vertexCapacity = 0;
+    hasPreviousCommands = false;
+    uniformWidth = 0;
+    uniformHeight = 0;
+}
@@ -0,0 +1,31 @@
+#ifndef BLOCKS_HUD
+#define BLOCKS_HUD
+
+#include <stdbool.h>
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#define HUD_ATLAS_COLUMNS 16
+#define HUD_ATLAS_ROWS 6
+#define HUD_CELL_WIDTH 24
+#define HUD_CELL_HEIGHT 24
+
+typedef struct HudStats {
+	int glyphCount;
+	int quadCount;
+	int rebuilds;
+	int reuses;
+} HudStats;
+
+bool initHud();
+void beginHud(int width, int height);
+void drawHudText(float x, float y, const char* text, GLuint hexColor);
+void drawHudQuad(float x, float y, float width, float height, GLuint hexColor);
+void endHud();
+HudStats getHudStats();
+void freeHud();
+
+#endif
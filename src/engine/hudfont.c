@@ -0,0 +1,324 @@
+/*
+ * The glyph data below is taken from the Helvetica 18 bitmap font in freeglut:
+ *
+ * Copyright (c) 1999-2000 Pawel W. Olszta. All Rights Reserved.
+ * Written by Pawel W. Olszta, <olszta@sourceforge.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * PAWEL W. OLSZTA BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "hudfont.h"
+
+// Glyphs of the Adobe Helvetica 18 bitmap font as shipped with freeglut, one bit per pixel, top row first.
+
+const uint8_t hudGlyphAdvances[HUD_GLYPH_COUNT] = {
+    5, 6, 5, 10, 10, 16, 13, 4, 6, 6, 7, 10, 5, 11, 5, 5,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 5, 5, 10, 11, 10, 10,
+    18, 12, 13, 14, 13, 11, 11, 14, 13, 6, 10, 13, 10, 16, 13, 15,
+    12, 15, 12, 13, 12, 13, 14, 18, 13, 14, 12, 5, 5, 5, 9, 10,
+    4, 9, 11, 10, 11, 10, 6, 11, 10, 4, 4, 9, 4, 14, 10, 11,
+    11, 11, 6, 9, 6, 10, 10, 14, 10, 10, 9, 6, 4, 6, 10
+};
+
+const uint32_t hudGlyphRows[HUD_GLYPH_COUNT][HUD_FONT_HEIGHT] = {
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x0000C, 0x0000C, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x00004, 0x00004, 0x00000, 0x00000,
+      0x0000C, 0x0000C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x0001B, 0x0001B, 0x0001B, 0x00009,
+      0x00009, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00090, 0x00090, 0x00090,
+      0x003FE, 0x003FE, 0x00048, 0x00048, 0x00048, 0x001FF, 0x001FF, 0x00024,
+      0x00024, 0x00024, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00020, 0x000F8, 0x001FC, 0x001A6,
+      0x00026, 0x0002E, 0x0003C, 0x000F8, 0x001E0, 0x00320, 0x00326, 0x003AE,
+      0x001FC, 0x000F8, 0x00020, 0x00020, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00C3C, 0x0067E, 0x00666,
+      0x00366, 0x0037E, 0x001BC, 0x00180, 0x03CC0, 0x07EC0, 0x06660, 0x06660,
+      0x07E30, 0x03C30, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00078, 0x000FC, 0x000CC,
+      0x000CC, 0x00078, 0x0007C, 0x006EE, 0x006C6, 0x00786, 0x00386, 0x007CE,
+      0x00EFC, 0x01C78, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00004, 0x00004,
+      0x00002, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00010, 0x00018, 0x0000C, 0x0000C,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x0000C, 0x0000C, 0x00018, 0x00010, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00002, 0x00006, 0x0000C, 0x0000C,
+      0x00018, 0x00018, 0x00018, 0x00018, 0x00018, 0x00018, 0x00018, 0x00018,
+      0x00018, 0x00018, 0x0000C, 0x0000C, 0x00006, 0x00002, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00008, 0x00008, 0x0003E, 0x0001C,
+      0x0001C, 0x00022, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00030, 0x00030, 0x00030, 0x00030, 0x001FE, 0x001FE, 0x00030, 0x00030,
+      0x00030, 0x00030, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00004, 0x00004, 0x00002, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x001FE, 0x001FE, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00018, 0x00018, 0x00008, 0x00008,
+      0x0000C, 0x0000C, 0x00004, 0x00004, 0x00006, 0x00006, 0x00002, 0x00002,
+      0x00003, 0x00003, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00078, 0x000FC, 0x000CC,
+      0x00186, 0x00186, 0x00186, 0x00186, 0x00186, 0x00186, 0x00186, 0x000CC,
+      0x000FC, 0x00078, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00060, 0x0007C, 0x0007C,
+      0x00060, 0x00060, 0x00060, 0x00060, 0x00060, 0x00060, 0x00060, 0x00060,
+      0x00060, 0x00060, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00078, 0x000FE, 0x00186,
+      0x00180, 0x001C0, 0x000E0, 0x00070, 0x00038, 0x0001C, 0x0000E, 0x00006,
+      0x001FE, 0x001FE, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00078, 0x000FC, 0x00186,
+      0x00186, 0x000C0, 0x00070, 0x000F0, 0x001C0, 0x00180, 0x00186, 0x001C6,
+      0x000FC, 0x00078, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00180, 0x001C0, 0x001E0,
+      0x001B0, 0x00198, 0x00198, 0x0018C, 0x00186, 0x003FE, 0x003FE, 0x00180,
+      0x00180, 0x00180, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x000FE, 0x000FE, 0x00006,
+      0x00006, 0x0007E, 0x000FE, 0x001C6, 0x00180, 0x00180, 0x00186, 0x001C6,
+      0x000FE, 0x0007C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00078, 0x001FC, 0x0018C,
+      0x00006, 0x00006, 0x00076, 0x000FE, 0x00186, 0x00186, 0x00186, 0x0018E,
+      0x000FC, 0x00078, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x001FE, 0x001FE, 0x00180,
+      0x000C0, 0x00060, 0x00060, 0x00030, 0x00030, 0x00018, 0x00018, 0x00018,
+      0x0000C, 0x0000C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00078, 0x000FC, 0x001CE,
+      0x00186, 0x00186, 0x000CC, 0x000FC, 0x000CC, 0x00186, 0x00186, 0x001CE,
+      0x000FC, 0x00078, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00078, 0x000FC, 0x001C6,
+      0x00186, 0x00186, 0x00186, 0x001FC, 0x001B8, 0x00180, 0x00180, 0x000C6,
+      0x000FE, 0x0007C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00004, 0x00004, 0x00002, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00180, 0x001E0, 0x00078, 0x0001C, 0x00006, 0x0001C, 0x00078,
+      0x001E0, 0x00180, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x001FC, 0x001FC, 0x00000, 0x00000, 0x001FC, 0x001FC,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00006, 0x0001E, 0x00078, 0x000E0, 0x00180, 0x000E0, 0x00078,
+      0x0001E, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x0007C, 0x000FE, 0x000C6, 0x000C6,
+      0x000E0, 0x00070, 0x00038, 0x00018, 0x00018, 0x00018, 0x00000, 0x00000,
+      0x00018, 0x00018, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x01F80, 0x07FE0, 0x0E070, 0x0C018,
+      0x19B8C, 0x19DCC, 0x198C6, 0x18C66, 0x0CC66, 0x0CC66, 0x06666, 0x03FE6,
+      0x01DCC, 0x0001C, 0x00038, 0x01FF0, 0x00FC0, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00060, 0x00060, 0x000F0, 0x000F0,
+      0x00198, 0x00198, 0x0030C, 0x0030C, 0x003FC, 0x007FE, 0x00606, 0x00606,
+      0x00C03, 0x00C03, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x001FE, 0x003FE, 0x00706, 0x00606,
+      0x00606, 0x00306, 0x003FE, 0x007FE, 0x00E06, 0x00C06, 0x00C06, 0x00E06,
+      0x007FE, 0x003FE, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x003E0, 0x00FF8, 0x01C1C, 0x0180C,
+      0x0000E, 0x00006, 0x00006, 0x00006, 0x00006, 0x0000E, 0x0180C, 0x01C1C,
+      0x00FF8, 0x003E0, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x001FE, 0x003FE, 0x00706, 0x00606,
+      0x00C06, 0x00C06, 0x00C06, 0x00C06, 0x00C06, 0x00C06, 0x00606, 0x00706,
+      0x003FE, 0x001FE, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x003FE, 0x003FE, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x001FE, 0x001FE, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x003FE, 0x003FE, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x003FE, 0x003FE, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x001FE, 0x001FE, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x003E0, 0x00FF8, 0x01C1C, 0x0180C,
+      0x0180E, 0x00006, 0x00006, 0x01F06, 0x01F06, 0x0180E, 0x0180C, 0x01C1C,
+      0x01FF8, 0x01BE0, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00C06, 0x00C06, 0x00C06, 0x00C06,
+      0x00C06, 0x00C06, 0x00FFE, 0x00FFE, 0x00C06, 0x00C06, 0x00C06, 0x00C06,
+      0x00C06, 0x00C06, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x0000C, 0x0000C, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00180, 0x00180, 0x00180, 0x00180,
+      0x00180, 0x00180, 0x00180, 0x00180, 0x00180, 0x00186, 0x00186, 0x001CE,
+      0x000FC, 0x00078, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00E06, 0x00706, 0x00386, 0x001C6,
+      0x000E6, 0x00076, 0x0003E, 0x0007E, 0x000E6, 0x001C6, 0x00386, 0x00706,
+      0x00E06, 0x01C06, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x001FE, 0x001FE, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x06006, 0x06006, 0x0700E, 0x0700E,
+      0x0781E, 0x0781E, 0x06C36, 0x06C36, 0x06666, 0x06666, 0x06246, 0x063C6,
+      0x06186, 0x06186, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00C06, 0x00C0E, 0x00C1E, 0x00C1E,
+      0x00C36, 0x00C66, 0x00C66, 0x00CC6, 0x00CC6, 0x00D86, 0x00F06, 0x00F06,
+      0x00E06, 0x00C06, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x003E0, 0x00FF8, 0x01C1C, 0x0180C,
+      0x0380E, 0x03006, 0x03006, 0x03006, 0x03006, 0x0380E, 0x0180C, 0x01C1C,
+      0x00FF8, 0x003E0, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x001FE, 0x003FE, 0x00706, 0x00606,
+      0x00606, 0x00706, 0x003FE, 0x001FE, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x003E0, 0x00FF8, 0x01C1C, 0x0180C,
+      0x0380E, 0x03006, 0x03006, 0x03006, 0x03006, 0x03B0E, 0x01B0C, 0x01E1C,
+      0x00FF8, 0x01BE0, 0x01800, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x001FE, 0x003FE, 0x00706, 0x00606,
+      0x00606, 0x00706, 0x003FE, 0x001FE, 0x00306, 0x00306, 0x00606, 0x00606,
+      0x00606, 0x00606, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x001F0, 0x007FC, 0x00E0E, 0x00C06,
+      0x0000E, 0x0007C, 0x001F0, 0x00780, 0x00E00, 0x00C00, 0x00C06, 0x00E0E,
+      0x007FC, 0x001F8, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x007FE, 0x007FE, 0x00060, 0x00060,
+      0x00060, 0x00060, 0x00060, 0x00060, 0x00060, 0x00060, 0x00060, 0x00060,
+      0x00060, 0x00060, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00C06, 0x00C06, 0x00C06, 0x00C06,
+      0x00C06, 0x00C06, 0x00C06, 0x00C06, 0x00C06, 0x00C06, 0x00C06, 0x0060C,
+      0x007FC, 0x001F0, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x01806, 0x01806, 0x00C0C, 0x00C0C,
+      0x00C0C, 0x00618, 0x00618, 0x00618, 0x00330, 0x00330, 0x00330, 0x001E0,
+      0x001E0, 0x000C0, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x18306, 0x18306, 0x18306, 0x18786,
+      0x0C78C, 0x0C48C, 0x0CCCC, 0x0CCCC, 0x06CD8, 0x06CD8, 0x06858, 0x03870,
+      0x03030, 0x03030, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00C06, 0x00E0E, 0x0060C, 0x0071C,
+      0x00318, 0x001B0, 0x000E0, 0x000E0, 0x001B0, 0x00318, 0x0071C, 0x0060C,
+      0x00E0E, 0x00C06, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x01806, 0x01806, 0x00C0C, 0x00C0C,
+      0x00618, 0x00618, 0x00330, 0x001E0, 0x000C0, 0x000C0, 0x000C0, 0x000C0,
+      0x000C0, 0x000C0, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x007FE, 0x007FE, 0x00600, 0x00300,
+      0x00180, 0x000C0, 0x00060, 0x00070, 0x00030, 0x00018, 0x0000C, 0x00006,
+      0x007FE, 0x007FE, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x0001E, 0x0001E, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x0001E, 0x0001E, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00003, 0x00003, 0x00002, 0x00002,
+      0x00006, 0x00006, 0x00004, 0x00004, 0x0000C, 0x0000C, 0x00008, 0x00008,
+      0x00018, 0x00018, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x0000F, 0x0000F, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000F, 0x0000F, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00010, 0x00038, 0x0006C,
+      0x000C6, 0x00082, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x003FF, 0x003FF, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00004, 0x00002, 0x00002, 0x00006,
+      0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x0007C, 0x000EE, 0x000C6, 0x000E0, 0x000FC, 0x000CE, 0x000C6, 0x000C6,
+      0x000EE, 0x000DC, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x000F6, 0x001FE, 0x0018E, 0x00306, 0x00306, 0x00306, 0x00306, 0x0018E,
+      0x001FE, 0x000F6, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x000F8, 0x001FC, 0x0018C, 0x00006, 0x00006, 0x00006, 0x00006, 0x0018C,
+      0x001FC, 0x000F8, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00300, 0x00300, 0x00300, 0x00300,
+      0x00378, 0x003FC, 0x0038C, 0x00306, 0x00306, 0x00306, 0x00306, 0x0038C,
+      0x003FC, 0x00378, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00078, 0x000FC, 0x00186, 0x00186, 0x001FE, 0x00006, 0x00006, 0x0018E,
+      0x001FC, 0x00078, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00038, 0x0003C, 0x0000C, 0x0000C,
+      0x0003F, 0x0003F, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00378, 0x003FC, 0x0030C, 0x00306, 0x00306, 0x00306, 0x00306, 0x0038C,
+      0x003FC, 0x00378, 0x00300, 0x0018C, 0x001FC, 0x00070, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x000E6, 0x001F6, 0x0018E, 0x00186, 0x00186, 0x00186, 0x00186, 0x00186,
+      0x00186, 0x00186, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00000, 0x00000,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00007, 0x00003, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x000C6, 0x00066, 0x00036, 0x0001E, 0x0003E, 0x00036, 0x00066, 0x000E6,
+      0x000C6, 0x001C6, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00C66, 0x01EF6, 0x019CE, 0x018C6, 0x018C6, 0x018C6, 0x018C6, 0x018C6,
+      0x018C6, 0x018C6, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x000E6, 0x001F6, 0x0018E, 0x00186, 0x00186, 0x00186, 0x00186, 0x00186,
+      0x00186, 0x00186, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x000F8, 0x001FC, 0x0018C, 0x00306, 0x00306, 0x00306, 0x00306, 0x0018C,
+      0x001FC, 0x000F8, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x000F6, 0x001FE, 0x0018E, 0x00306, 0x00306, 0x00306, 0x00306, 0x0018E,
+      0x001FE, 0x000F6, 0x00006, 0x00006, 0x00006, 0x00006, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00378, 0x003FC, 0x0038C, 0x00306, 0x00306, 0x00306, 0x00306, 0x0038C,
+      0x003FC, 0x00378, 0x00300, 0x00300, 0x00300, 0x00300, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00036, 0x00036, 0x0000E, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00078, 0x000FC, 0x000C6, 0x00006, 0x0007E, 0x000F8, 0x000C0, 0x000C6,
+      0x0007E, 0x0003C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x0000C, 0x0000C, 0x0000C,
+      0x0003F, 0x0003F, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x0000C,
+      0x0001C, 0x00018, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00186, 0x00186, 0x00186, 0x00186, 0x00186, 0x00186, 0x00186, 0x001C6,
+      0x001BE, 0x0019C, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00186, 0x00186, 0x00186, 0x000CC, 0x000CC, 0x000CC, 0x00048, 0x00078,
+      0x00030, 0x00030, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x018C6, 0x018C6, 0x018C6, 0x00CCC, 0x00CCC, 0x00D2C, 0x00528, 0x00738,
+      0x00330, 0x00330, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00186, 0x001CE, 0x000CC, 0x00078, 0x00030, 0x00030, 0x00078, 0x000CC,
+      0x001CE, 0x00186, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00186, 0x00186, 0x00186, 0x000CC, 0x000CC, 0x000CC, 0x00048, 0x00078,
+      0x00030, 0x00030, 0x00030, 0x00030, 0x0001C, 0x0001C, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x000FE, 0x000FE, 0x000C0, 0x00060, 0x00030, 0x00018, 0x0000C, 0x00006,
+      0x000FE, 0x000FE, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00030, 0x00018, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x00006, 0x00003, 0x00006, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x00018, 0x00030, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006,
+      0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00006, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00003, 0x00006, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x00018, 0x00030, 0x00018, 0x0000C, 0x0000C,
+      0x0000C, 0x0000C, 0x0000C, 0x0000C, 0x00006, 0x00003, 0x00000 },
+    { 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00198, 0x000FC, 0x00066, 0x00000, 0x00000,
+      0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000 }
+};
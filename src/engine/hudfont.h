@@ -0,0 +1,15 @@
+#ifndef BLOCKS_HUDFONT
+#define BLOCKS_HUDFONT
+
+#include <stdint.h>
+
+#define HUD_FIRST_GLYPH 32
+#define HUD_GLYPH_COUNT 95
+#define HUD_FONT_HEIGHT 23
+#define HUD_FONT_BASELINE 5
+#define HUD_FONT_MAX_ADVANCE 18
+
+extern const uint8_t hudGlyphAdvances[HUD_GLYPH_COUNT];
+extern const uint32_t hudGlyphRows[HUD_GLYPH_COUNT][HUD_FONT_HEIGHT];
+
+#endif
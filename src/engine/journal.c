@@ -0,0 +1,540 @@
+#include "journal.h"
+#include "region.h"
+#include "workers.h"
+#include "chunkmap.h"
+#include "fileutils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#define JOURNAL_MAGIC "BLKJ"
+#define JOURNAL_VERSION 2
+#define JOURNAL_BLOCK_RECORD -1
+#define JOURNAL_PATH REGION_DIRECTORY "/journal.bin"
+#define JOURNAL_TEMPORARY_PATH REGION_DIRECTORY "/journal.bin.tmp"
+
+typedef struct JournalHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t nextSequence;
+} JournalHeader;
+
+typedef struct JournalRecord {
+    uint64_t sequence;
+    int32_t kind;
+    int32_t x;
+    int32_t y;
+    int32_t z;
+    int32_t oldType;
+    int32_t newType;
+    int32_t maxX;
+    int32_t maxY;
+    int32_t maxZ;
+    float center[3];
+    float inverseRadius[3];
+    uint32_t checksum;
+} JournalRecord;
+
+typedef struct JournalBuffer {
+    JournalRecord* records;
+    int count;
+    int capacity;
+} JournalBuffer;
+
+typedef struct JournalColumn {
+    IntVector3 key;
+    JournalBuffer edits;
+} JournalColumn;
+
+typedef enum CompactionState {
+    COMPACTION_IDLE,
+    COMPACTION_SAVING,
+    COMPACTION_REWRITING
+} CompactionState;
+
+static FILE* journalFile = NULL;
+static size_t journalSize = 0;
+static bool isJournalFailing = false;
+static JournalBuffer journalBuffers[2];
+static JournalBuffer* activeBuffer = &journalBuffers[0];
+static JournalBuffer* flushingBuffer = &journalBuffers[1];
+static WorkerGroup flushGroup = { .pending = 0 };
+
+static JournalColumn* journalColumns = NULL;
+static int journalColumnCount = 0;
+static int journalColumnCapacity = 0;
+static ChunkMap journalColumnMap = { .entries = NULL, .capacity = 0, .count = 0 };
+
+static CompactionState compactionState = COMPACTION_IDLE;
+static JournalBuffer compactionSnapshot = { .records = NULL, .count = 0, .capacity = 0 };
+static uint64_t compactionSequence = 0;
+static int compactionFailedSaves = 0;
+static int compactedRecords = 0;
+static bool isCompactionWritten = false;
+
+static JournalStats journalStats = {
+    .nextSequence = 1,
+    .bufferedRecords = 0,
+    .journalRecords = 0,
+    .replayedRecords = 0,
+    .compactions = 0,
+    .failedWrites = 0
+};
+
+JournalStats getJournalStats() {
+    JournalStats stats = journalStats;
+    stats.bufferedRecords = activeBuffer->count;
+    return stats;
+}
+
+static uint32_t getRecordChecksum(const JournalRecord* record) {
+    const uint8_t* bytes = (const uint8_t*)record;
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < offsetof(JournalRecord, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static void pushJournalRecord(JournalBuffer* buffer, JournalRecord record) {
+    if (buffer->count == buffer->capacity) {
+        buffer->capacity = buffer->capacity == 0 ? 256 : buffer->capacity * 2;
+        buffer->records = realloc(buffer->records, buffer->capacity * sizeof(JournalRecord));
+    }
+
+    buffer->records[buffer->count++] = record;
+}
+
+static void addPendingEdit(JournalRecord record) {
+    IntVector3 key = { .x = record.x >> CHUNK_SHIFT, .y = 0, .z = record.z >> CHUNK_SHIFT };
+    int index = chunkMapGet(&journalColumnMap, key);
+
+    if (index == CHUNK_MAP_EMPTY) {
+        if (journalColumnCount == journalColumnCapacity) {
+            journalColumnCapacity = journalColumnCapacity == 0 ? 64 : journalColumnCapacity * 2;
+            journalColumns = realloc(journalColumns, journalColumnCapacity * sizeof(JournalColumn));
+        }
+
+        index = journalColumnCount++;
+        memset(&journalColumns[index], 0, sizeof(JournalColumn));
+        journalColumns[index].key = key;
+        chunkMapPut(&journalColumnMap, key, index);
+    }
+
+    pushJournalRecord(&journalColumns[index].edits, record);
+}
+
+static BulkEdit getRecordBulkEdit(const JournalRecord* record) {
+    BulkEdit edit = {
+        .kind = (BulkEditKind)record->kind,
+        .min = { .x = record->x, .y = record->y, .z = record->z },
+        .max = { .x = record->maxX, .y = record->maxY, .z = record->maxZ },
+        .fromType = record->oldType,
+        .blockType = record->newType
+    };
+
+    memcpy(edit.center, record->center, sizeof(edit.center));
+    memcpy(edit.inverseRadius, record->inverseRadius, sizeof(edit.inverseRadius));
+    return edit;
+}
+
+static void removeJournalColumn(int index) {
+    free(journalColumns[index].edits.records);
+    chunkMapRemove(&journalColumnMap, journalColumns[index].key);
+
+    int lastIndex = --journalColumnCount;
+    if (index != lastIndex) {
+        journalColumns[index] = journalColumns[lastIndex];
+        chunkMapPut(&journalColumnMap, journalColumns[index].key, index);
+    }
+}
+
+void applyJournalEdits(WorldState* ws, ChunkColumn* column) {
+    if (journalColumnCount == 0) {
+        return;
+    }
+
+    IntVector3 key = { .x = column->x, .y = 0, .z = column->z };
+    int index = chunkMapGet(&journalColumnMap, key);
+
+    if (index == CHUNK_MAP_EMPTY) {
+        return;
+    }
+
+    JournalBuffer* edits = &journalColumns[index].edits;
+    bool isApplied = false;
+
+    for (int i = 0; i < edits->count; i++) {
+        JournalRecord* record = &edits->records[i];
+
+        if (record->sequence <= column->journalSequence) {
+            continue;
+        }
+
+        isApplied = true;
+
+        if (record->kind != JOURNAL_BLOCK_RECORD) {
+            BulkEdit edit = getRecordBulkEdit(record);
+            applyBulkEditToColumn(ws, column, &edit);
+            continue;
+        }
+
+        if (record->y < 0 || record->y >= WORLD_HEIGHT) {
+            continue;
+        }
+
+        int blockIndex = (record->x & CHUNK_MASK)
+            + (record->y & CHUNK_MASK) * CHUNK_SIZE
+            + (record->z & CHUNK_MASK) * CHUNK_SIZE * CHUNK_SIZE;
+
+        if (!setChunkBlock(ws, &column->sections[record->y >> CHUNK_SHIFT], blockIndex, record->newType)) {
+            continue;
+        }
+
+        updateColumnSurface(column, record->x, record->y, record->z, record->newType);
+    }
+
+    column->isModified |= isApplied;
+    removeJournalColumn(index);
+}
+
+static bool readJournal() {
+    FILE* file = fopen(JOURNAL_PATH, "rb");
+
+    if (file == NULL) {
+        return false;
+    }
+
+    JournalHeader header;
+    JournalRecord record;
+    bool isClean = false;
+
+    if (fread(&header, sizeof(header), 1, file) == 1
+        && memcmp(header.magic, JOURNAL_MAGIC, 4) == 0 && header.version == JOURNAL_VERSION) {
+        size_t readSize;
+        isClean = true;
+        journalSize = sizeof(header);
+
+        if (header.nextSequence > journalStats.nextSequence) {
+            journalStats.nextSequence = header.nextSequence;
+        }
+
+        while ((readSize = fread(&record, 1, sizeof(record), file)) == sizeof(record)) {
+            if (record.checksum != getRecordChecksum(&record)) {
+                isClean = false;
+                break;
+            }
+
+            addPendingEdit(record);
+            if (record.sequence >= journalStats.nextSequence) {
+                journalStats.nextSequence = record.sequence + 1;
+            }
+            journalSize += sizeof(record);
+            journalStats.replayedRecords++;
+            journalStats.journalRecords++;
+        }
+
+        if (readSize != 0 && readSize != sizeof(record)) {
+            isClean = false;
+        }
+    }
+
+    fclose(file);
+
+    if (!isClean) {
+        fprintf(stderr, "Recovered %d journal records, discarding the damaged tail\n", journalStats.replayedRecords);
+    }
+
+    return isClean;
+}
+
+static void snapshotJournalColumns(JournalBuffer* snapshot) {
+    snapshot->count = 0;
+
+    for (int i = 0; i < journalColumnCount; i++) {
+        JournalBuffer* edits = &journalColumns[i].edits;
+
+        for (int j = 0; j < edits->count; j++) {
+            pushJournalRecord(snapshot, edits->records[j]);
+        }
+    }
+}
+
+static bool rewriteJournal(const JournalBuffer* snapshot, uint64_t nextSequence) {
+    if (journalFile != NULL) {
+        fclose(journalFile);
+        journalFile = NULL;
+    }
+
+    FILE* file = fopen(JOURNAL_TEMPORARY_PATH, "wb");
+    bool isWritten = false;
+
+    if (file != NULL) {
+        JournalHeader header = { .version = JOURNAL_VERSION, .nextSequence = nextSequence };
+        memcpy(header.magic, JOURNAL_MAGIC, 4);
+
+        isWritten = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(snapshot->records, sizeof(JournalRecord), snapshot->count, file) == (size_t)snapshot->count
+            && syncFile(file);
+        fclose(file);
+
+        isWritten = isWritten && replaceFile(JOURNAL_TEMPORARY_PATH, JOURNAL_PATH);
+
+        if (!isWritten) {
+            remove(JOURNAL_TEMPORARY_PATH);
+        }
+    }
+
+    if (isWritten) {
+        journalSize = sizeof(JournalHeader) + snapshot->count * sizeof(JournalRecord);
+    }
+
+    journalFile = fopen(JOURNAL_PATH, "r+b");
+    return isWritten;
+}
+
+void initJournal() {
+    makeDirectory(REGION_DIRECTORY);
+
+    if (journalColumnMap.entries == NULL) {
+        initChunkMap(&journalColumnMap, 64);
+    }
+
+    if (readJournal()) {
+        journalFile = fopen(JOURNAL_PATH, "r+b");
+    } else {
+        snapshotJournalColumns(&compactionSnapshot);
+
+        if (!rewriteJournal(&compactionSnapshot, journalStats.nextSequence)) {
+            fprintf(stderr, "Failed to create %s\n", JOURNAL_PATH);
+        }
+
+        compactionSnapshot.count = 0;
+    }
+
+    if (journalFile == NULL) {
+        fprintf(stderr, "Failed to open %s, edits are kept in memory until it can be written\n", JOURNAL_PATH);
+        isJournalFailing = true;
+    }
+
+    compactedRecords = journalStats.journalRecords;
+}
+
+void appendJournalEdit(int x, int y, int z, int oldType, int newType) {
+    JournalRecord record = {
+        .sequence = journalStats.nextSequence++,
+        .kind = JOURNAL_BLOCK_RECORD,
+        .x = x,
+        .y = y,
+        .z = z,
+        .oldType = oldType,
+        .newType = newType
+    };
+
+    record.checksum = getRecordChecksum(&record);
+    pushJournalRecord(activeBuffer, record);
+    journalStats.journalRecords++;
+}
+
+void appendJournalBulkEdit(const BulkEdit* edit) {
+    JournalRecord record = {
+        .sequence = journalStats.nextSequence++,
+        .kind = (int32_t)edit->kind,
+        .x = edit->min.x,
+        .y = edit->min.y,
+        .z = edit->min.z,
+        .oldType = edit->fromType,
+        .newType = edit->blockType,
+        .maxX = edit->max.x,
+        .maxY = edit->max.y,
+        .maxZ = edit->max.z
+    };
+
+    memcpy(record.center, edit->center, sizeof(record.center));
+    memcpy(record.inverseRadius, edit->inverseRadius, sizeof(record.inverseRadius));
+    record.checksum = getRecordChecksum(&record);
+    pushJournalRecord(activeBuffer, record);
+    journalStats.journalRecords++;
+}
+
+static void writeJournalBuffer(void* context) {
+    JournalBuffer* buffer = context;
+
+    if (buffer->count == 0) {
+        return;
+    }
+
+    if (journalFile == NULL) {
+        journalFile = fopen(JOURNAL_PATH, "r+b");
+    }
+
+    bool isWritten = journalFile != NULL
+        && fseek(journalFile, (long)journalSize, SEEK_SET) == 0
+        && fwrite(buffer->records, sizeof(JournalRecord), buffer->count, journalFile) == (size_t)buffer->count
+        && syncFile(journalFile);
+
+    if (!isWritten) {
+        if (journalFile != NULL) {
+            fclose(journalFile);
+            journalFile = NULL;
+        }
+        return;
+    }
+
+    journalSize += buffer->count * sizeof(JournalRecord);
+    buffer->count = 0;
+}
+
+static void flushJournal() {
+    if (flushingBuffer->count > 0) {
+        journalStats.failedWrites++;
+
+        if (!isJournalFailing) {
+            fprintf(stderr, "Failed to write %s, keeping %d records for retry\n", JOURNAL_PATH, flushingBuffer->count);
+            isJournalFailing = true;
+        }
+
+        for (int i = 0; i < activeBuffer->count; i++) {
+            pushJournalRecord(flushingBuffer, activeBuffer->records[i]);
+        }
+
+        activeBuffer->count = 0;
+    } else {
+        isJournalFailing = false;
+
+        if (activeBuffer->count == 0) {
+            return;
+        }
+
+        JournalBuffer* buffer = flushingBuffer;
+        flushingBuffer = activeBuffer;
+        activeBuffer = buffer;
+    }
+
+    submitWorkerTask(&flushGroup, writeJournalBuffer, flushingBuffer);
+}
+
+static void runJournalRewrite(void* context) {
+    syncRegionFiles();
+    isCompactionWritten = rewriteJournal(&compactionSnapshot, compactionSequence);
+}
+
+static void startCompaction() {
+    compactionFailedSaves = getRegionStats().failedSaves;
+    queueWorldSave();
+    snapshotJournalColumns(&compactionSnapshot);
+    compactionSequence = journalStats.nextSequence;
+    compactionState = COMPACTION_SAVING;
+}
+
+static void finishCompaction() {
+    if (compactionState == COMPACTION_REWRITING) {
+        if (isCompactionWritten) {
+            journalStats.journalRecords = compactionSnapshot.count + activeBuffer->count + flushingBuffer->count;
+            journalStats.compactions++;
+        } else {
+            fprintf(stderr, "Failed to compact %s\n", JOURNAL_PATH);
+        }
+    }
+
+    compactedRecords = journalStats.journalRecords;
+    compactionSnapshot.count = 0;
+    compactionState = COMPACTION_IDLE;
+}
+
+void updateJournal() {
+    if (!isWorkerGroupDone(&flushGroup)) {
+        return;
+    }
+
+    if (compactionState == COMPACTION_REWRITING) {
+        finishCompaction();
+    }
+
+    if (compactionState == COMPACTION_SAVING) {
+        if (hasPendingChunkColumnSaves()) {
+            return;
+        }
+
+        if (getRegionStats().failedSaves != compactionFailedSaves) {
+            fprintf(stderr, "Keeping %s uncompacted after failed column saves\n", JOURNAL_PATH);
+            finishCompaction();
+        } else {
+            compactionState = COMPACTION_REWRITING;
+            submitWorkerTask(&flushGroup, runJournalRewrite, NULL);
+            return;
+        }
+    }
+
+    if (journalStats.journalRecords - compactedRecords >= JOURNAL_COMPACT_THRESHOLD) {
+        startCompaction();
+        return;
+    }
+
+    flushJournal();
+}
+
+void compactJournal() {
+    waitForWorkerGroup(&flushGroup);
+    finishCompaction();
+    compactionFailedSaves = getRegionStats().failedSaves;
+
+    bool isSaved = saveWorld();
+    finishChunkColumnSaves();
+
+    if (isSaved && getRegionStats().failedSaves == compactionFailedSaves) {
+        syncRegionFiles();
+        snapshotJournalColumns(&compactionSnapshot);
+
+        if (rewriteJournal(&compactionSnapshot, journalStats.nextSequence)) {
+            activeBuffer->count = 0;
+            flushingBuffer->count = 0;
+            journalStats.journalRecords = compactionSnapshot.count;
+            journalStats.compactions++;
+        }
+
+        compactionSnapshot.count = 0;
+    }
+
+    writeJournalBuffer(flushingBuffer);
+    writeJournalBuffer(activeBuffer);
+
+    if (flushingBuffer->count > 0 || activeBuffer->count > 0) {
+        fprintf(stderr, "Failed to write %d journal records\n", flushingBuffer->count + activeBuffer->count);
+    }
+
+    compactedRecords = journalStats.journalRecords;
+}
+
+void closeJournal() {
+    compactJournal();
+
+    if (journalFile != NULL) {
+        fclose(journalFile);
+        journalFile = NULL;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        free(journalBuffers[i].records);
+        journalBuffers[i].records = NULL;
+        journalBuffers[i].count = 0;
+        journalBuffers[i].capacity = 0;
+    }
+
+    free(compactionSnapshot.records);
+    compactionSnapshot.records = NULL;
+    compactionSnapshot.capacity = 0;
+
+    while (journalColumnCount > 0) {
+        removeJournalColumn(journalColumnCount - 1);
+    }
+
+    free(journalColumns);
+    journalColumns = NULL;
+    journalColumnCapacity = 0;
+    freeChunkMap(&journalColumnMap);
+}
@@ -0,0 +1,28 @@
+#ifndef BLOCKS_JOURNAL
+#define BLOCKS_JOURNAL
+
+#include <stdint.h>
+#include "world.h"
+#include "bulkedit.h"
+
+#define JOURNAL_COMPACT_THRESHOLD 8192
+
+typedef struct JournalStats {
+	uint64_t nextSequence;
+	int bufferedRecords;
+	int journalRecords;
+	int replayedRecords;
+	int compactions;
+	int failedWrites;
+} JournalStats;
+
+void initJournal();
+void appendJournalEdit(int x, int y, int z, int oldType, int newType);
+void appendJournalBulkEdit(const BulkEdit* edit);
+void applyJournalEdits(WorldState* worldState, ChunkColumn* column);
+void updateJournal();
+void compactJournal();
+void closeJournal();
+JournalStats getJournalStats();
+
+#endif
@@ -0,0 +1,232 @@
+#include "lod.h"
+#include "cube.h"
+#include "constants.h"
+#include "occlusion.h"
+#include "upload.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define LOD_MAX_CELL_SIZE (1 << (LOD_LEVEL_COUNT - 1))
+#define LOD_MAX_CELL_COUNT ((CHUNK_SIZE / 2) * (CHUNK_SIZE / 2))
+#define LOD_NEIGHBOR_COUNT 9
+
+typedef struct LodCache {
+    int level;
+    int revisions[LOD_NEIGHBOR_COUNT];
+    int instanceOffset;
+    int instanceCount;
+    int bottom;
+    int top;
+} LodCache;
+
+static LodConfig lodConfig = {
+    .levelDistances = { 4, 8, 12 }
+};
+
+static LodStats lodStats = {
+    .columnsPerLevel = { 0 },
+    .drawnColumns = 0,
+    .drawnCells = 0,
+    .occludedCells = 0,
+    .rebuiltColumns = 0
+};
+
+LodConfig getLodConfig() {
+    return lodConfig;
+}
+
+void setLodConfig(LodConfig config) {
+    for (int i = 1; i < LOD_LEVEL_COUNT - 1; i++) {
+        if (config.levelDistances[i] < config.levelDistances[i - 1]) {
+            config.levelDistances[i] = config.levelDistances[i - 1];
+        }
+    }
+
+    lodConfig = config;
+}
+
+LodStats getLodStats() {
+    return lodStats;
+}
+
+void resetLodStats() {
+    for (int i = 0; i < LOD_LEVEL_COUNT; i++) {
+        lodStats.columnsPerLevel[i] = 0;
+    }
+
+    lodStats.drawnColumns = 0;
+    lodStats.drawnCells = 0;
+    lodStats.occludedCells = 0;
+    lodStats.rebuiltColumns = 0;
+}
+
+int getColumnLodLevel(int columnX, int columnZ, Vector3 position) {
+    int centerX = (int)floor(position.x) >> CHUNK_SHIFT;
+    int centerZ = (int)floor(position.z) >> CHUNK_SHIFT;
+    int distanceX = abs(columnX - centerX);
+    int distanceZ = abs(columnZ - centerZ);
+    int distance = distanceX > distanceZ ? distanceX : distanceZ;
+    int level = 0;
+
+    while (level < LOD_LEVEL_COUNT - 1 && distance >= lodConfig.levelDistances[level]) {
+        level++;
+    }
+
+    lodStats.columnsPerLevel[level]++;
+    return level;
+}
+
+static int getMajorityType(const uint8_t* types, int count) {
+    int majorityType = 0;
+    int majorityCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        int typeCount = 0;
+
+        for (int j = i; j < count; j++) {
+            typeCount += types[j] == types[i];
+        }
+
+        if (typeCount > majorityCount) {
+            majorityType = types[i];
+            majorityCount = typeCount;
+        }
+    }
+
+    return majorityType;
+}
+
+static void getNeighborRevisions(WorldState* ws, const ChunkColumn* column, int* revisions) {
+    for (int z = -1; z <= 1; z++) {
+        for (int x = -1; x <= 1; x++) {
+            const ChunkColumn* neighbor = getChunkColumnAt(ws, column->x + x, column->z + z);
+            revisions[(x + 1) + (z + 1) * 3] = neighbor != NULL ? neighbor->revision : -1;
+        }
+    }
+}
+
+static void buildColumnLod(WorldState* ws, const ChunkColumn* column, LodCache* cache) {
+    int cellSize = 1 << cache->level;
+    int originX = column->x * CHUNK_SIZE;
+    int originZ = column->z * CHUNK_SIZE;
+    uint8_t types[LOD_MAX_CELL_SIZE * LOD_MAX_CELL_SIZE];
+    GLuint instances[LOD_MAX_CELL_COUNT];
+
+    cache->instanceCount = 0;
+    cache->bottom = WORLD_HEIGHT;
+    cache->top = SURFACE_NONE;
+
+    for (int cellZ = 0; cellZ < CHUNK_SIZE; cellZ += cellSize) {
+        for (int cellX = 0; cellX < CHUNK_SIZE; cellX += cellSize) {
+            int top = SURFACE_NONE;
+            int bottom = WORLD_HEIGHT;
+            int typeCount = 0;
+
+            for (int z = cellZ; z < cellZ + cellSize; z++) {
+                for (int x = cellX; x < cellX + cellSize; x++) {
+                    int surfaceIndex = x + z * CHUNK_SIZE;
+                    int height = column->surfaceHeights[surfaceIndex];
+
+                    if (height == SURFACE_NONE) {
+                        continue;
+                    }
+
+                    top = height > top ? height : top;
+                    bottom = height < bottom ? height : bottom;
+                    types[typeCount++] = column->surfaceTypes[surfaceIndex];
+                }
+            }
+
+            if (top == SURFACE_NONE) {
+                continue;
+            }
+
+            for (int i = -1; i <= cellSize; i++) {
+                int ringHeights[4] = {
+                    getSurfaceHeight(ws, originX + cellX + i, originZ + cellZ - 1),
+                    getSurfaceHeight(ws, originX + cellX + i, originZ + cellZ + cellSize),
+                    getSurfaceHeight(ws, originX + cellX - 1, originZ + cellZ + i),
+                    getSurfaceHeight(ws, originX + cellX + cellSize, originZ + cellZ + i)
+                };
+
+                for (int j = 0; j < 4; j++) {
+                    if (ringHeights[j] != SURFACE_NONE && ringHeights[j] < bottom) {
+                        bottom = ringHeights[j];
+                    }
+                }
+            }
+
+            instances[cache->instanceCount++] = PACK_CUBE_BOX_INSTANCE(cellX / cellSize, cellZ / cellSize,
+                bottom, top - bottom + 1, getMajorityType(types, typeCount));
+            cache->top = top > cache->top ? top : cache->top;
+            cache->bottom = bottom < cache->bottom ? bottom : cache->bottom;
+        }
+    }
+
+    if (cache->instanceCount > 0) {
+        uploadGeometry(cache->instanceOffset, instances, cache->instanceCount * sizeof(GLuint));
+    }
+
+    lodStats.rebuiltColumns++;
+}
+
+void drawColumnLod(WorldState* ws, ChunkColumn* column, int level, const Frustum* frustum) {
+    LodCache* cache = column->lodCache;
+    int revisions[LOD_NEIGHBOR_COUNT];
+
+    if (cache == NULL) {
+        cache = calloc(1, sizeof(LodCache));
+        cache->level = -1;
+        cache->instanceOffset = allocateGeometry(LOD_MAX_CELL_COUNT * sizeof(GLuint));
+        column->lodCache = cache;
+    }
+
+    if (cache->instanceOffset == GEOMETRY_NONE) {
+        return;
+    }
+
+    getNeighborRevisions(ws, column, revisions);
+
+    if (cache->level != level || memcmp(cache->revisions, revisions, sizeof(revisions)) != 0) {
+        cache->level = level;
+        memcpy(cache->revisions, revisions, sizeof(revisions));
+        buildColumnLod(ws, column, cache);
+    }
+
+    if (cache->instanceCount == 0) {
+        return;
+    }
+
+    Vector3 center = {
+        .x = column->x * CHUNK_SIZE + CHUNK_SIZE * 0.5,
+        .y = (cache->top + cache->bottom) * 0.5 - 1.0,
+        .z = column->z * CHUNK_SIZE + CHUNK_SIZE * 0.5
+    };
+    Vector3 extents = { .x = CHUNK_SIZE * 0.5, .y = (cache->top - cache->bottom + 1) * 0.5, .z = CHUNK_SIZE * 0.5 };
+
+    if (!isAABBInFrustum(frustum, &center, &extents)) {
+        return;
+    }
+
+    if (isAABBOccluded(&center, &extents)) {
+        lodStats.occludedCells += cache->instanceCount;
+        return;
+    }
+
+    Vector3 origin = { .x = column->x * CHUNK_SIZE, .y = -1.5, .z = column->z * CHUNK_SIZE };
+    drawCubeBoxes(origin, 1 << level, cache->instanceOffset, cache->instanceCount, DEFAULT_OUTLINE_COLOR);
+    lodStats.drawnColumns++;
+    lodStats.drawnCells += cache->instanceCount;
+}
+
+void freeColumnLod(ChunkColumn* column) {
+    if (column->lodCache == NULL) {
+        return;
+    }
+
+    freeGeometry(column->lodCache->instanceOffset, LOD_MAX_CELL_COUNT * sizeof(GLuint));
+    free(column->lodCache);
+    column->lodCache = NULL;
+}
@@ -0,0 +1,31 @@
+#ifndef BLOCKS_LOD
+#define BLOCKS_LOD
+
+#include "types.h"
+#include "world.h"
+#include "frustum.h"
+
+#define LOD_LEVEL_COUNT 4
+
+typedef struct LodConfig {
+	int levelDistances[LOD_LEVEL_COUNT - 1];
+} LodConfig;
+
+typedef struct LodStats {
+	int columnsPerLevel[LOD_LEVEL_COUNT];
+	int drawnColumns;
+	int drawnCells;
+	int occludedCells;
+	int rebuiltColumns;
+} LodStats;
+
+LodConfig getLodConfig();
+void setLodConfig(LodConfig config);
+LodStats getLodStats();
+void resetLodStats();
+
+int getColumnLodLevel(int columnX, int columnZ, Vector3 position);
+void drawColumnLod(WorldState* worldState, ChunkColumn* column, int level, const Frustum* frustum);
+void freeColumnLod(ChunkColumn* column);
+
+#endif
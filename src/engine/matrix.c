@@ -0,0 +1,133 @@
+#include "matrix.h"
+
+#include <math.h>
+
+#define MATRIX_PI 3.14159265358979323846
+
+Matrix4 getIdentityMatrix() {
+    Matrix4 result = { .m = { 0 } };
+    result.m[0] = 1.0f;
+    result.m[5] = 1.0f;
+    result.m[10] = 1.0f;
+    result.m[15] = 1.0f;
+    return result;
+}
+
+Matrix4 multiplyMatrices(Matrix4 a, Matrix4 b) {
+    Matrix4 result;
+
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            result.m[column * 4 + row] = a.m[row] * b.m[column * 4]
+                + a.m[4 + row] * b.m[column * 4 + 1]
+                + a.m[8 + row] * b.m[column * 4 + 2]
+                + a.m[12 + row] * b.m[column * 4 + 3];
+        }
+    }
+
+    return result;
+}
+
+Matrix4 getPerspectiveMatrix(double fovY, double aspect, double zNear, double zFar) {
+    Matrix4 result = { .m = { 0 } };
+    double f = 1.0 / tan(fovY * MATRIX_PI / 360.0);
+
+    result.m[0] = (float)(f / aspect);
+    result.m[5] = (float)f;
+    result.m[10] = (float)((zFar + zNear) / (zNear - zFar));
+    result.m[11] = -1.0f;
+    result.m[14] = (float)(2.0 * zFar * zNear / (zNear - zFar));
+    return result;
+}
+
+Matrix4 getOrthographicMatrix(double left, double right, double bottom, double top, double zNear, double zFar) {
+    Matrix4 result = getIdentityMatrix();
+
+    result.m[0] = (float)(2.0 / (right - left));
+    result.m[5] = (float)(2.0 / (top - bottom));
+    result.m[10] = (float)(-2.0 / (zFar - zNear));
+    result.m[12] = (float)(-(right + left) / (right - left));
+    result.m[13] = (float)(-(top + bottom) / (top - bottom));
+    result.m[14] = (float)(-(zFar + zNear) / (zFar - zNear));
+    return result;
+}
+
+static Vector3 normalizeVector(Vector3 v) {
+    double length = sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+
+    if (length > 0.0) {
+        v.x /= length;
+        v.y /= length;
+        v.z /= length;
+    }
+
+    return v;
+}
+
+static Vector3 crossVectors(Vector3 a, Vector3 b) {
+    Vector3 result = {
+        .x = a.y * b.z - a.z * b.y,
+        .y = a.z * b.x - a.x * b.z,
+        .z = a.x * b.y - a.y * b.x
+    };
+    return result;
+}
+
+Matrix4 getLookAtMatrix(Vector3 eye, Vector3 center, Vector3 up) {
+    Vector3 forward = { .x = center.x - eye.x, .y = center.y - eye.y, .z = center.z - eye.z };
+    forward = normalizeVector(forward);
+
+    Vector3 side = normalizeVector(crossVectors(forward, up));
+    Vector3 upward = crossVectors(side, forward);
+
+    Matrix4 result = getIdentityMatrix();
+    result.m[0] = (float)side.x;
+    result.m[4] = (float)side.y;
+    result.m[8] = (float)side.z;
+    result.m[1] = (float)upward.x;
+    result.m[5] = (float)upward.y;
+    result.m[9] = (float)upward.z;
+    result.m[2] = (float)-forward.x;
+    result.m[6] = (float)-forward.y;
+    result.m[10] = (float)-forward.z;
+    result.m[12] = (float)-(side.x * eye.x + side.y * eye.y + side.z * eye.z);
+    result.m[13] = (float)-(upward.x * eye.x + upward.y * eye.y + upward.z * eye.z);
+    result.m[14] = (float)(forward.x * eye.x + forward.y * eye.y + forward.z * eye.z);
+    return result;
+}
+
+Matrix4 getTranslationMatrix(double x, double y, double z) {
+    Matrix4 result = getIdentityMatrix();
+    result.m[12] = (float)x;
+    result.m[13] = (float)y;
+    result.m[14] = (float)z;
+    return result;
+}
+
+Matrix4 getRotationMatrix(double angle, double x, double y, double z) {
+    Vector3 axis = normalizeVector((Vector3) { .x = x, .y = y, .z = z });
+    double radians = angle * MATRIX_PI / 180.0;
+    double c = cos(radians);
+    double s = sin(radians);
+    double t = 1.0 - c;
+
+    Matrix4 result = getIdentityMatrix();
+    result.m[0] = (float)(t * axis.x * axis.x + c);
+    result.m[1] = (float)(t * axis.x * axis.y + s * axis.z);
+    result.m[2] = (float)(t * axis.x * axis.z - s * axis.y);
+    result.m[4] = (float)(t * axis.x * axis.y - s * axis.z);
+    result.m[5] = (float)(t * axis.y * axis.y + c);
+    result.m[6] = (float)(t * axis.y * axis.z + s * axis.x);
+    result.m[8] = (float)(t * axis.x * axis.z + s * axis.y);
+    result.m[9] = (float)(t * axis.y * axis.z - s * axis.x);
+    result.m[10] = (float)(t * axis.z * axis.z + c);
+    return result;
+}
+
+Matrix4 getScaleMatrix(double x, double y, double z) {
+    Matrix4 result = getIdentityMatrix();
+    result.m[0] = (float)x;
+    result.m[5] = (float)y;
+    result.m[10] = (float)z;
+    return result;
+}
@@ -0,0 +1,19 @@
+#ifndef BLOCKS_MATRIX
+#define BLOCKS_MATRIX
+
+#include "types.h"
+
+typedef struct Matrix4 {
+	float m[16];
+} Matrix4;
+
+Matrix4 getIdentityMatrix();
+Matrix4 multiplyMatrices(Matrix4 a, Matrix4 b);
+Matrix4 getPerspectiveMatrix(double fovY, double aspect, double zNear, double zFar);
+Matrix4 getOrthographicMatrix(double left, double right, double bottom, double top, double zNear, double zFar);
+Matrix4 getLookAtMatrix(Vector3 eye, Vector3 center, Vector3 up);
+Matrix4 getTranslationMatrix(double x, double y, double z);
+Matrix4 getRotationMatrix(double angle, double x, double y, double z);
+Matrix4 getScaleMatrix(double x, double y, double z);
+
+#endif
@@ -0,0 +1,303 @@
+#include "mesh.h"
+#include "cube.h"
+#include "visibility.h"
+#include "constants.h"
+#include "upload.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include <GL/glew.h>
+#include <GL/gl.h>
+#endif
+
+static ChunkSnapshot syncSnapshot;
+static MeshBuffer syncBuffer = { .vertices = NULL, .count = 0, .capacity = 0 };
+
+static void uploadChunkGeometry(int* offset, int* capacity, const void* data, int size) {
+    if (size > *capacity) {
+        freeGeometry(*offset, *capacity);
+        *capacity = (size + size / 4 + GEOMETRY_ALIGNMENT - 1) & ~(GEOMETRY_ALIGNMENT - 1);
+        *offset = allocateGeometry(*capacity);
+
+        if (*offset == GEOMETRY_NONE) {
+            *capacity = 0;
+            return;
+        }
+    }
+
+    uploadGeometry(*offset, data, size);
+}
+
+static void pushMeshValue(MeshBuffer* buffer, GLuint value) {
+    if (buffer->count == buffer->capacity) {
+        buffer->capacity = buffer->capacity == 0 ? 4096 : buffer->capacity * 2;
+        buffer->vertices = realloc(buffer->vertices, buffer->capacity * sizeof(GLuint));
+    }
+
+    buffer->vertices[buffer->count++] = value;
+}
+
+static void pushMeshVertex(MeshBuffer* buffer, const int* position, int face, int type) {
+    pushMeshValue(buffer, PACK_CUBE_VERTEX(position[0], position[1], position[2], face, type));
+}
+
+static void getFaceAxes(int face, int* layerAxis, int* uAxis, int* vAxis) {
+    switch (face) {
+    case BLOCK_FACE_TOP:
+    case BLOCK_FACE_BOTTOM:
+        *layerAxis = 1; *uAxis = 0; *vAxis = 2;
+        break;
+    case BLOCK_FACE_FRONT:
+    case BLOCK_FACE_BACK:
+        *layerAxis = 2; *uAxis = 0; *vAxis = 1;
+        break;
+    default:
+        *layerAxis = 0; *uAxis = 2; *vAxis = 1;
+        break;
+    }
+}
+
+static void pushFaceCorner(MeshBuffer* buffer, int layerAxis, int uAxis, int vAxis, int plane, int u, int v, int face, int type) {
+    int position[3];
+    position[layerAxis] = plane;
+    position[uAxis] = u;
+    position[vAxis] = v;
+    pushMeshVertex(buffer, position, face, type);
+}
+
+void snapshotChunk(const Chunk* chunk, ChunkSnapshot* snapshot) {
+    snapshot->visibleFaceCount = chunk->visibleFaceCount;
+
+    if (chunk->visibleFaces == NULL || chunk->visibleFaceCount == 0) {
+        memset(snapshot->visibleFaces, 0, sizeof(snapshot->visibleFaces));
+        snapshot->visibleFaceCount = 0;
+        return;
+    }
+
+    memcpy(snapshot->visibleFaces, chunk->visibleFaces, sizeof(snapshot->visibleFaces));
+
+    for (int r = 0; r < CHUNK_ROW_COUNT; r++) {
+        uint16_t visibleRow = getVisibleRowMask(chunk, r);
+
+        for (int bit = 0; visibleRow != 0; bit++, visibleRow >>= 1) {
+            if (visibleRow & 1) {
+                int index = (r << CHUNK_SHIFT) + bit;
+                snapshot->types[index] = (uint8_t)getChunkBlock(chunk, index);
+            }
+        }
+    }
+}
+
+static void meshChunkFace(const ChunkSnapshot* snapshot, MeshBuffer* buffer, int face) {
+    int layerAxis, uAxis, vAxis;
+    int types[CHUNK_SIZE * CHUNK_SIZE];
+    int isPositive = face == BLOCK_FACE_TOP || face == BLOCK_FACE_FRONT || face == BLOCK_FACE_RIGHT;
+
+    getFaceAxes(face, &layerAxis, &uAxis, &vAxis);
+
+    for (int layer = 0; layer < CHUNK_SIZE; layer++) {
+        int faceCount = 0;
+
+        for (int v = 0; v < CHUNK_SIZE; v++) {
+            for (int u = 0; u < CHUNK_SIZE; u++) {
+                int local[3];
+                local[layerAxis] = layer;
+                local[uAxis] = u;
+                local[vAxis] = v;
+
+                int row = local[1] + local[2] * CHUNK_SIZE;
+                int isVisible = (snapshot->visibleFaces[face][row] >> local[0]) & 1;
+
+                types[u + v * CHUNK_SIZE] = isVisible ? snapshot->types[(row << CHUNK_SHIFT) + local[0]] : 0;
+                faceCount += isVisible;
+            }
+        }
+
+        if (faceCount == 0) {
+            continue;
+        }
+
+        int plane = layer + isPositive;
+
+        for (int v = 0; v < CHUNK_SIZE; v++) {
+            for (int u = 0; u < CHUNK_SIZE; ) {
+                int type = types[u + v * CHUNK_SIZE];
+
+                if (type == 0) {
+                    u++;
+                    continue;
+                }
+
+                int width = 1;
+                while (u + width < CHUNK_SIZE && types[u + width + v * CHUNK_SIZE] == type) {
+                    width++;
+                }
+
+                int height = 1;
+                while (v + height < CHUNK_SIZE) {
+                    int k = 0;
+                    while (k < width && types[u + k + (v + height) * CHUNK_SIZE] == type) {
+                        k++;
+                    }
+                    if (k < width) {
+                        break;
+                    }
+                    height++;
+                }
+
+                for (int dv = 0; dv < height; dv++) {
+                    for (int du = 0; du < width; du++) {
+                        types[u + du + (v + dv) * CHUNK_SIZE] = 0;
+                    }
+                }
+
+                pushFaceCorner(buffer, layerAxis, uAxis, vAxis, plane, u, v, face, type);
+                pushFaceCorner(buffer, layerAxis, uAxis, vAxis, plane, u + width, v, face, type);
+                pushFaceCorner(buffer, layerAxis, uAxis, vAxis, plane, u + width, v + height, face, type);
+                pushFaceCorner(buffer, layerAxis, uAxis, vAxis, plane, u, v + height, face, type);
+
+                u += width;
+            }
+        }
+    }
+}
+
+void buildMeshVertices(const ChunkSnapshot* snapshot, MeshBuffer* buffer) {
+    buffer->count = 0;
+
+    if (snapshot->visibleFaceCount == 0) {
+        return;
+    }
+
+    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+        meshChunkFace(snapshot, buffer, face);
+    }
+}
+
+void uploadChunkMesh(Chunk* chunk, const MeshBuffer* buffer) {
+    if (buffer->count == 0) {
+        freeChunkMesh(chunk);
+        return;
+    }
+
+    uploadChunkGeometry(&chunk->meshOffset, &chunk->meshCapacity, buffer->vertices, buffer->count * sizeof(GLuint));
+    chunk->meshVertexCount = buffer->count;
+}
+
+void buildChunkMesh(Chunk* chunk) {
+    chunk->isMeshDirty = false;
+    snapshotChunk(chunk, &syncSnapshot);
+    buildMeshVertices(&syncSnapshot, &syncBuffer);
+    uploadChunkMesh(chunk, &syncBuffer);
+}
+
+void freeChunkMesh(Chunk* chunk) {
+    freeGeometry(chunk->meshOffset, chunk->meshCapacity);
+    chunk->meshOffset = GEOMETRY_NONE;
+    chunk->meshCapacity = 0;
+    chunk->meshVertexCount = 0;
+}
+
+void drawChunkMesh(const Chunk* chunk) {
+    if (chunk->meshVertexCount == 0) {
+        return;
+    }
+
+    Vector3 origin = {
+        .x = chunk->position.x * CHUNK_SIZE,
+        .y = chunk->position.y * CHUNK_SIZE - 1.5,
+        .z = chunk->position.z * CHUNK_SIZE
+    };
+
+    drawCubeMesh(origin, chunk->meshOffset / sizeof(GLuint), chunk->meshVertexCount / 4, DEFAULT_OUTLINE_COLOR);
+}
+
+void queueChunkMesh(const Chunk* chunk) {
+    if (chunk->meshVertexCount == 0) {
+        return;
+    }
+
+    Vector3 origin = {
+        .x = chunk->position.x * CHUNK_SIZE,
+        .y = chunk->position.y * CHUNK_SIZE - 1.5,
+        .z = chunk->position.z * CHUNK_SIZE
+    };
+
+    addCubeMeshToBatch(origin, chunk->meshOffset / sizeof(GLuint), chunk->meshVertexCount / 4);
+}
+
+void buildInstanceVertices(const ChunkSnapshot* snapshot, MeshBuffer* buffer) {
+    buffer->count = 0;
+
+    for (int r = 0; r < CHUNK_ROW_COUNT && snapshot->visibleFaceCount > 0; r++) {
+        uint16_t visibleRow = 0;
+
+        for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+            visibleRow |= snapshot->visibleFaces[face][r];
+        }
+
+        for (int bit = 0; visibleRow != 0; bit++, visibleRow >>= 1) {
+            if ((visibleRow & 1) == 0) {
+                continue;
+            }
+
+            int index = (r << CHUNK_SHIFT) + bit;
+            int y = r & CHUNK_MASK;
+            int z = r >> CHUNK_SHIFT;
+
+            pushMeshValue(buffer, PACK_CUBE_INSTANCE(bit, y, z, snapshot->types[index]));
+        }
+    }
+}
+
+void uploadChunkInstances(Chunk* chunk, const MeshBuffer* buffer) {
+    if (buffer->count == 0) {
+        freeChunkInstances(chunk);
+        return;
+    }
+
+    uploadChunkGeometry(&chunk->instanceOffset, &chunk->instanceCapacity, buffer->vertices, buffer->count * sizeof(GLuint));
+    chunk->instanceCount = buffer->count;
+}
+
+void buildChunkInstances(Chunk* chunk) {
+    chunk->isInstanceDirty = false;
+    snapshotChunk(chunk, &syncSnapshot);
+    buildInstanceVertices(&syncSnapshot, &syncBuffer);
+    uploadChunkInstances(chunk, &syncBuffer);
+}
+
+void freeChunkInstances(Chunk* chunk) {
+    freeGeometry(chunk->instanceOffset, chunk->instanceCapacity);
+    chunk->instanceOffset = GEOMETRY_NONE;
+    chunk->instanceCapacity = 0;
+    chunk->instanceCount = 0;
+}
+
+void drawChunkInstances(const Chunk* chunk) {
+    if (chunk->instanceCount == 0) {
+        return;
+    }
+
+    Vector3 origin = {
+        .x = chunk->position.x * CHUNK_SIZE,
+        .y = chunk->position.y * CHUNK_SIZE - 1.5,
+        .z = chunk->position.z * CHUNK_SIZE
+    };
+
+    drawCubeInstances(origin, chunk->instanceOffset, chunk->instanceCount, DEFAULT_OUTLINE_COLOR);
+}
+
+void freeMeshBuffer(MeshBuffer* buffer) {
+    free(buffer->vertices);
+    buffer->vertices = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+}
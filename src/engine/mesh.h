@@ -0,0 +1,40 @@
+#ifndef BLOCKS_MESH
+#define BLOCKS_MESH
+
+#include <stdint.h>
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif
+#include "world.h"
+#include "visibility.h"
+
+typedef struct ChunkSnapshot {
+	uint16_t visibleFaces[BLOCK_FACE_COUNT][CHUNK_ROW_COUNT];
+	uint8_t types[CHUNK_ROW_COUNT * CHUNK_SIZE];
+	int visibleFaceCount;
+} ChunkSnapshot;
+
+typedef struct MeshBuffer {
+	GLuint* vertices;
+	int count;
+	int capacity;
+} MeshBuffer;
+
+void snapshotChunk(const Chunk* chunk, ChunkSnapshot* snapshot);
+void buildMeshVertices(const ChunkSnapshot* snapshot, MeshBuffer* buffer);
+void buildInstanceVertices(const ChunkSnapshot* snapshot, MeshBuffer* buffer);
+void uploadChunkMesh(Chunk* chunk, const MeshBuffer* buffer);
+void uploadChunkInstances(Chunk* chunk, const MeshBuffer* buffer);
+void freeMeshBuffer(MeshBuffer* buffer);
+
+void buildChunkMesh(Chunk* chunk);
+void freeChunkMesh(Chunk* chunk);
+void drawChunkMesh(const Chunk* chunk);
+void queueChunkMesh(const Chunk* chunk);
+void buildChunkInstances(Chunk* chunk);
+void freeChunkInstances(Chunk* chunk);
+void drawChunkInstances(const Chunk* chunk);
+
+#endif
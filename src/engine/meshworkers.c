@@ -0,0 +1,241 @@
+#include "meshworkers.h"
+#include "mesh.h"
+#include "workers.h"
+
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+typedef struct MeshJob {
+    struct MeshJob* next;
+    MeshJobKind kind;
+    IntVector3 position;
+    int id;
+    ChunkSnapshot snapshot;
+    MeshBuffer buffer;
+} MeshJob;
+
+static MeshJob* volatile completedJobs = NULL;
+static MeshJob* readyJobs = NULL;
+static MeshJob* readyJobsTail = NULL;
+static MeshJob* freeJobs = NULL;
+static WorkerGroup meshGroup = { .pending = 0 };
+static int nextJobId = 1;
+static bool isEnabled = true;
+
+static MeshWorkerStats meshWorkerStats = {
+    .pendingJobs = 0,
+    .pooledJobs = 0,
+    .submittedJobs = 0,
+    .uploadedJobs = 0,
+    .discardedJobs = 0,
+    .frameUploadedJobs = 0,
+    .frameDeferredJobs = 0
+};
+
+MeshWorkerStats getMeshWorkerStats() {
+    return meshWorkerStats;
+}
+
+bool isMeshWorkersEnabled() {
+    return isEnabled;
+}
+
+void setMeshWorkersEnabled(bool enabled) {
+    isEnabled = enabled;
+}
+
+static void pushCompletedJob(MeshJob* job) {
+#if defined(_WIN32)
+    MeshJob* head;
+
+    do {
+        head = completedJobs;
+        job->next = head;
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)&completedJobs, job, head) != head);
+#else
+    MeshJob* head = __atomic_load_n(&completedJobs, __ATOMIC_RELAXED);
+
+    do {
+        job->next = head;
+    } while (!__atomic_compare_exchange_n(&completedJobs, &head, job, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#endif
+}
+
+static MeshJob* takeCompletedJobs() {
+#if defined(_WIN32)
+    return InterlockedExchangePointer((PVOID volatile*)&completedJobs, NULL);
+#else
+    return __atomic_exchange_n(&completedJobs, NULL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void buildMeshJob(void* context) {
+    MeshJob* job = context;
+
+    if (job->kind == MESH_JOB_MESH) {
+        buildMeshVertices(&job->snapshot, &job->buffer);
+    } else {
+        buildInstanceVertices(&job->snapshot, &job->buffer);
+    }
+
+    pushCompletedJob(job);
+}
+
+static MeshJob* acquireJob() {
+    MeshJob* job = freeJobs;
+
+    if (job != NULL) {
+        freeJobs = job->next;
+        return job;
+    }
+
+    if (meshWorkerStats.pooledJobs == MESH_MAX_PENDING_JOBS) {
+        return NULL;
+    }
+
+    meshWorkerStats.pooledJobs++;
+    return calloc(1, sizeof(MeshJob));
+}
+
+static void releaseJob(MeshJob* job) {
+    job->next = freeJobs;
+    freeJobs = job;
+    meshWorkerStats.pendingJobs--;
+}
+
+bool submitChunkMeshJob(Chunk* chunk, MeshJobKind kind) {
+    MeshJob* job = acquireJob();
+
+    if (job == NULL) {
+        return false;
+    }
+
+    job->kind = kind;
+    job->position = chunk->position;
+    job->id = nextJobId++;
+    snapshotChunk(chunk, &job->snapshot);
+
+    if (kind == MESH_JOB_MESH) {
+        chunk->isMeshDirty = false;
+        chunk->meshJob = job->id;
+    } else {
+        chunk->isInstanceDirty = false;
+        chunk->instanceJob = job->id;
+    }
+
+    meshWorkerStats.pendingJobs++;
+    meshWorkerStats.submittedJobs++;
+    submitWorkerTask(&meshGroup, buildMeshJob, job);
+    return true;
+}
+
+static void collectCompletedJobs() {
+    MeshJob* reversed = NULL;
+    MeshJob* job = takeCompletedJobs();
+
+    while (job != NULL) {
+        MeshJob* next = job->next;
+        job->next = reversed;
+        reversed = job;
+        job = next;
+    }
+
+    if (reversed == NULL) {
+        return;
+    }
+
+    if (readyJobsTail != NULL) {
+        readyJobsTail->next = reversed;
+    } else {
+        readyJobs = reversed;
+    }
+
+    for (readyJobsTail = reversed; readyJobsTail->next != NULL; readyJobsTail = readyJobsTail->next) {
+    }
+}
+
+static bool uploadJob(WorldState* ws, MeshJob* job) {
+    Chunk* chunk = getChunkAt(ws, job->position.x, job->position.y, job->position.z);
+
+    if (chunk == NULL) {
+        return false;
+    }
+
+    if (job->kind == MESH_JOB_MESH && chunk->meshJob == job->id) {
+        uploadChunkMesh(chunk, &job->buffer);
+        chunk->meshJob = 0;
+        return true;
+    }
+
+    if (job->kind == MESH_JOB_INSTANCES && chunk->instanceJob == job->id) {
+        uploadChunkInstances(chunk, &job->buffer);
+        chunk->instanceJob = 0;
+        return true;
+    }
+
+    return false;
+}
+
+int uploadFinishedMeshes(WorldState* ws) {
+    int uploadedBytes = 0;
+
+    collectCompletedJobs();
+    meshWorkerStats.frameUploadedJobs = 0;
+    meshWorkerStats.frameDeferredJobs = 0;
+
+    while (readyJobs != NULL) {
+        MeshJob* job = readyJobs;
+        int size = job->buffer.count * (int)sizeof(GLuint);
+
+        if (meshWorkerStats.frameUploadedJobs > 0 && uploadedBytes + size > MESH_UPLOAD_BUDGET_BYTES) {
+            break;
+        }
+
+        readyJobs = job->next;
+        if (readyJobs == NULL) {
+            readyJobsTail = NULL;
+        }
+
+        if (uploadJob(ws, job)) {
+            uploadedBytes += size;
+            meshWorkerStats.frameUploadedJobs++;
+            meshWorkerStats.uploadedJobs++;
+        } else {
+            meshWorkerStats.discardedJobs++;
+        }
+
+        releaseJob(job);
+    }
+
+    for (MeshJob* job = readyJobs; job != NULL; job = job->next) {
+        meshWorkerStats.frameDeferredJobs++;
+    }
+
+    return meshWorkerStats.frameUploadedJobs;
+}
+
+static void freeJobList(MeshJob* job) {
+    while (job != NULL) {
+        MeshJob* next = job->next;
+        freeMeshBuffer(&job->buffer);
+        free(job);
+        job = next;
+    }
+}
+
+void freeMeshWorkers() {
+    waitForWorkerGroup(&meshGroup);
+
+    freeJobList(takeCompletedJobs());
+    freeJobList(readyJobs);
+    freeJobList(freeJobs);
+    readyJobs = NULL;
+    readyJobsTail = NULL;
+    freeJobs = NULL;
+
+    meshWorkerStats.pendingJobs = 0;
+    meshWorkerStats.pooledJobs = 0;
+}
@@ -0,0 +1,32 @@
+#ifndef BLOCKS_MESHWORKERS
+#define BLOCKS_MESHWORKERS
+
+#include <stdbool.h>
+#include "world.h"
+
+#define MESH_MAX_PENDING_JOBS 64
+#define MESH_UPLOAD_BUDGET_BYTES (512 * 1024)
+
+typedef enum MeshJobKind {
+	MESH_JOB_MESH,
+	MESH_JOB_INSTANCES
+} MeshJobKind;
+
+typedef struct MeshWorkerStats {
+	int pendingJobs;
+	int pooledJobs;
+	int submittedJobs;
+	int uploadedJobs;
+	int discardedJobs;
+	int frameUploadedJobs;
+	int frameDeferredJobs;
+} MeshWorkerStats;
+
+bool isMeshWorkersEnabled();
+void setMeshWorkersEnabled(bool isEnabled);
+bool submitChunkMeshJob(Chunk* chunk, MeshJobKind kind);
+int uploadFinishedMeshes(WorldState* worldState);
+void freeMeshWorkers();
+MeshWorkerStats getMeshWorkerStats();
+
+#endif
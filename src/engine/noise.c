@@ -0,0 +1,320 @@
+#include "noise.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NOISE_X86_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(NOISE_X86_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define NOISE_TARGET_SSE2 __attribute__((target("sse2")))
+#define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NOISE_TARGET_SSE2
+#define NOISE_TARGET_AVX2
+#endif
+
+#define NOISE_OCTAVES 4
+#define NOISE_BASE_FREQUENCY 0.08f
+#define NOISE_X_PHASE 13.37f
+#define NOISE_Z_PHASE 7.13f
+
+#define INV_PI 0.318309886183790671538f
+#define PI_PART_A 3.140625f
+#define PI_PART_B 9.67502593994140625e-4f
+#define PI_PART_C 1.509957990978376432e-7f
+
+#define SIN_C3 -1.66666667e-1f
+#define SIN_C5 8.33333333e-3f
+#define SIN_C7 -1.98412698e-4f
+#define SIN_C9 2.75573192e-6f
+#define SIN_C11 -2.50521084e-8f
+
+#define COS_C2 -0.5f
+#define COS_C4 4.16666667e-2f
+#define COS_C6 -1.38888889e-3f
+#define COS_C8 2.48015873e-5f
+#define COS_C10 -2.75573192e-7f
+#define COS_C12 2.08767570e-9f
+
+typedef void (*HeightmapKernel)(int originX, int originZ, float* heights);
+
+static HeightmapKernel heightmapKernel = NULL;
+static const char* heightmapKernelName = "scalar";
+
+float valueNoise2d(float x, float z) {
+    float total = 0.0f;
+    float frequency = NOISE_BASE_FREQUENCY;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+    int octaves = NOISE_OCTAVES;
+
+    for (int i = 0; i < octaves; i++) {
+        float n = sinf(x * frequency + i * NOISE_X_PHASE) * cosf(z * frequency + i * NOISE_Z_PHASE);
+        total += n * amplitude;
+        maxValue += amplitude;
+        amplitude *= 0.5f;
+        frequency *= 2.0f;
+    }
+    return total / maxValue;
+}
+
+static void fillHeightmapScalar(int originX, int originZ, float* heights) {
+    float sines[NOISE_OCTAVES][NOISE_HEIGHTMAP_SIZE];
+    float cosines[NOISE_OCTAVES][NOISE_HEIGHTMAP_SIZE];
+    float frequency = NOISE_BASE_FREQUENCY;
+
+    for (int i = 0; i < NOISE_OCTAVES; i++) {
+        for (int j = 0; j < NOISE_HEIGHTMAP_SIZE; j++) {
+            sines[i][j] = sinf((float)(originX + j) * frequency + i * NOISE_X_PHASE);
+            cosines[i][j] = cosf((float)(originZ + j) * frequency + i * NOISE_Z_PHASE);
+        }
+        frequency *= 2.0f;
+    }
+
+    for (int z = 0; z < NOISE_HEIGHTMAP_SIZE; z++) {
+        for (int x = 0; x < NOISE_HEIGHTMAP_SIZE; x++) {
+            float total = 0.0f;
+            float amplitude = 1.0f;
+            float maxValue = 0.0f;
+
+            for (int i = 0; i < NOISE_OCTAVES; i++) {
+                float n = sines[i][x] * cosines[i][z];
+                total += n * amplitude;
+                maxValue += amplitude;
+                amplitude *= 0.5f;
+            }
+
+            heights[x + z * NOISE_HEIGHTMAP_SIZE] = total / maxValue;
+        }
+    }
+}
+
+#if defined(NOISE_X86_SIMD)
+NOISE_TARGET_SSE2
+static void sinCosSse2(__m128 x, __m128* sine, __m128* cosine) {
+    __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(INV_PI)));
+    __m128 k = _mm_cvtepi32_ps(quadrant);
+
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(PI_PART_A)));
+    r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(PI_PART_B)));
+    r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(PI_PART_C)));
+    __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 s = _mm_set1_ps(SIN_C11);
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(SIN_C9));
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(SIN_C7));
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(SIN_C5));
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(SIN_C3));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+
+    __m128 c = _mm_set1_ps(COS_C12);
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_C10));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_C8));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_C6));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_C4));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_C2));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(1.0f));
+
+    __m128 sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), 31));
+    *sine = _mm_xor_ps(s, sign);
+    *cosine = _mm_xor_ps(c, sign);
+}
+
+NOISE_TARGET_SSE2
+static void fillHeightmapSse2(int originX, int originZ, float* heights) {
+    __m128 sines[NOISE_OCTAVES][NOISE_HEIGHTMAP_SIZE / 4];
+    float cosines[NOISE_OCTAVES][NOISE_HEIGHTMAP_SIZE];
+    float frequency = NOISE_BASE_FREQUENCY;
+    __m128 unused;
+
+    for (int i = 0; i < NOISE_OCTAVES; i++) {
+        for (int j = 0; j < NOISE_HEIGHTMAP_SIZE / 4; j++) {
+            __m128 xs = _mm_add_ps(_mm_set1_ps((float)originX), _mm_setr_ps((float)(j * 4), (float)(j * 4 + 1), (float)(j * 4 + 2), (float)(j * 4 + 3)));
+            __m128 zs = _mm_add_ps(_mm_set1_ps((float)originZ), _mm_setr_ps((float)(j * 4), (float)(j * 4 + 1), (float)(j * 4 + 2), (float)(j * 4 + 3)));
+            __m128 cosine;
+
+            sinCosSse2(_mm_add_ps(_mm_mul_ps(xs, _mm_set1_ps(frequency)), _mm_set1_ps(i * NOISE_X_PHASE)), &sines[i][j], &unused);
+            sinCosSse2(_mm_add_ps(_mm_mul_ps(zs, _mm_set1_ps(frequency)), _mm_set1_ps(i * NOISE_Z_PHASE)), &unused, &cosine);
+            _mm_storeu_ps(&cosines[i][j * 4], cosine);
+        }
+        frequency *= 2.0f;
+    }
+
+    __m128 maxValue = _mm_set1_ps(1.0f + 0.5f + 0.25f + 0.125f);
+
+    for (int z = 0; z < NOISE_HEIGHTMAP_SIZE; z++) {
+        for (int j = 0; j < NOISE_HEIGHTMAP_SIZE / 4; j++) {
+            __m128 total = _mm_setzero_ps();
+            float amplitude = 1.0f;
+
+            for (int i = 0; i < NOISE_OCTAVES; i++) {
+                __m128 n = _mm_mul_ps(sines[i][j], _mm_set1_ps(cosines[i][z]));
+                total = _mm_add_ps(total, _mm_mul_ps(n, _mm_set1_ps(amplitude)));
+                amplitude *= 0.5f;
+            }
+
+            _mm_storeu_ps(&heights[z * NOISE_HEIGHTMAP_SIZE + j * 4], _mm_div_ps(total, maxValue));
+        }
+    }
+}
+
+NOISE_TARGET_AVX2
+static void sinCosAvx2(__m256 x, __m256* sine, __m256* cosine) {
+    __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(INV_PI)));
+    __m256 k = _mm256_cvtepi32_ps(quadrant);
+
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(k, _mm256_set1_ps(PI_PART_A)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(k, _mm256_set1_ps(PI_PART_B)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(k, _mm256_set1_ps(PI_PART_C)));
+    __m256 r2 = _mm256_mul_ps(r, r);
+
+    __m256 s = _mm256_set1_ps(SIN_C11);
+    s = _mm256_add_ps(_mm256_mul_ps(s, r2), _mm256_set1_ps(SIN_C9));
+    s = _mm256_add_ps(_mm256_mul_ps(s, r2), _mm256_set1_ps(SIN_C7));
+    s = _mm256_add_ps(_mm256_mul_ps(s, r2), _mm256_set1_ps(SIN_C5));
+    s = _mm256_add_ps(_mm256_mul_ps(s, r2), _mm256_set1_ps(SIN_C3));
+    s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(s, r2), r), r);
+
+    __m256 c = _mm256_set1_ps(COS_C12);
+    c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(COS_C10));
+    c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(COS_C8));
+    c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(COS_C6));
+    c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(COS_C4));
+    c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(COS_C2));
+    c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(1.0f));
+
+    __m256 sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(1)), 31));
+    *sine = _mm256_xor_ps(s, sign);
+    *cosine = _mm256_xor_ps(c, sign);
+}
+
+NOISE_TARGET_AVX2
+static void fillHeightmapAvx2(int originX, int originZ, float* heights) {
+    __m256 sines[NOISE_OCTAVES][NOISE_HEIGHTMAP_SIZE / 8];
+    float cosines[NOISE_OCTAVES][NOISE_HEIGHTMAP_SIZE];
+    float frequency = NOISE_BASE_FREQUENCY;
+    __m256 unused;
+
+    for (int i = 0; i < NOISE_OCTAVES; i++) {
+        for (int j = 0; j < NOISE_HEIGHTMAP_SIZE / 8; j++) {
+            __m256 offsets = _mm256_setr_ps(
+                (float)(j * 8), (float)(j * 8 + 1), (float)(j * 8 + 2), (float)(j * 8 + 3),
+                (float)(j * 8 + 4), (float)(j * 8 + 5), (float)(j * 8 + 6), (float)(j * 8 + 7));
+            __m256 xs = _mm256_add_ps(_mm256_set1_ps((float)originX), offsets);
+            __m256 zs = _mm256_add_ps(_mm256_set1_ps((float)originZ), offsets);
+            __m256 cosine;
+
+            sinCosAvx2(_mm256_add_ps(_mm256_mul_ps(xs, _mm256_set1_ps(frequency)), _mm256_set1_ps(i * NOISE_X_PHASE)), &sines[i][j], &unused);
+            sinCosAvx2(_mm256_add_ps(_mm256_mul_ps(zs, _mm256_set1_ps(frequency)), _mm256_set1_ps(i * NOISE_Z_PHASE)), &unused, &cosine);
+            _mm256_storeu_ps(&cosines[i][j * 8], cosine);
+        }
+        frequency *= 2.0f;
+    }
+
+    __m256 maxValue = _mm256_set1_ps(1.0f + 0.5f + 0.25f + 0.125f);
+
+    for (int z = 0; z < NOISE_HEIGHTMAP_SIZE; z++) {
+        for (int j = 0; j < NOISE_HEIGHTMAP_SIZE / 8; j++) {
+            __m256 total = _mm256_setzero_ps();
+            float amplitude = 1.0f;
+
+            for (int i = 0; i < NOISE_OCTAVES; i++) {
+                __m256 n = _mm256_mul_ps(sines[i][j], _mm256_set1_ps(cosines[i][z]));
+                total = _mm256_add_ps(total, _mm256_mul_ps(n, _mm256_set1_ps(amplitude)));
+                amplitude *= 0.5f;
+            }
+
+            _mm256_storeu_ps(&heights[z * NOISE_HEIGHTMAP_SIZE + j * 8], _mm256_div_ps(total, maxValue));
+        }
+    }
+}
+
+static int cpuSupportsSse2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] >> 26) & 1;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+static int cpuSupportsAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    if (((info[2] >> 27) & 1) == 0 || ((info[2] >> 28) & 1) == 0) {
+        return 0;
+    }
+    if ((_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 5) & 1;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+void initNoise() {
+    if (heightmapKernel != NULL) {
+        return;
+    }
+
+    heightmapKernel = fillHeightmapScalar;
+    heightmapKernelName = "scalar";
+
+#if defined(NOISE_X86_SIMD)
+    if (cpuSupportsAvx2()) {
+        heightmapKernel = fillHeightmapAvx2;
+        heightmapKernelName = "avx2";
+    } else if (cpuSupportsSse2()) {
+        heightmapKernel = fillHeightmapSse2;
+        heightmapKernelName = "sse2";
+    }
+#endif
+}
+
+const char* getNoiseKernelName() {
+    return heightmapKernelName;
+}
+
+bool selectNoiseKernel(const char* name) {
+    if (strcmp(name, "scalar") == 0) {
+        heightmapKernel = fillHeightmapScalar;
+        heightmapKernelName = "scalar";
+        return true;
+    }
+
+#if defined(NOISE_X86_SIMD)
+    if (strcmp(name, "sse2") == 0 && cpuSupportsSse2()) {
+        heightmapKernel = fillHeightmapSse2;
+        heightmapKernelName = "sse2";
+        return true;
+    }
+
+    if (strcmp(name, "avx2") == 0 && cpuSupportsAvx2()) {
+        heightmapKernel = fillHeightmapAvx2;
+        heightmapKernelName = "avx2";
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+void fillNoiseHeightmap(int originX, int originZ, float* heights) {
+    if (heightmapKernel == NULL) {
+        initNoise();
+    }
+
+    heightmapKernel(originX, originZ, heights);
+}
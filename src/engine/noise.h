@@ -0,0 +1,15 @@
+#ifndef BLOCKS_NOISE
+#define BLOCKS_NOISE
+
+#include <stdbool.h>
+
+#define NOISE_HEIGHTMAP_SIZE 16
+
+float valueNoise2d(float x, float z);
+
+void initNoise();
+const char* getNoiseKernelName();
+bool selectNoiseKernel(const char* name);
+void fillNoiseHeightmap(int originX, int originZ, float* heights);
+
+#endif
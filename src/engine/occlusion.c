@@ -0,0 +1,466 @@
+#include "occlusion.h"
+#include "workers.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define OCCLUSION_SSE
+#include <xmmintrin.h>
+#endif
+
+#define OCCLUSION_NEAR_W 0.1f
+#define OCCLUSION_DEPTH_BIAS 0.001f
+#define OCCLUSION_BAND_HEIGHT (OCCLUSION_HEIGHT / OCCLUSION_BAND_COUNT)
+#define OCCLUSION_TILES_X (OCCLUSION_WIDTH / OCCLUSION_TILE_SIZE)
+#define OCCLUSION_TILES_Y (OCCLUSION_HEIGHT / OCCLUSION_TILE_SIZE)
+#define OCCLUSION_COARSE_X (OCCLUSION_WIDTH / OCCLUSION_COARSE_TILE_SIZE)
+#define OCCLUSION_COARSE_Y (OCCLUSION_HEIGHT / OCCLUSION_COARSE_TILE_SIZE)
+#define OCCLUSION_COARSE_RATIO (OCCLUSION_COARSE_TILE_SIZE / OCCLUSION_TILE_SIZE)
+
+typedef struct ClipVertex {
+    float x;
+    float y;
+    float w;
+} ClipVertex;
+
+typedef struct OccluderTriangle {
+    float edgeA[3];
+    float edgeB[3];
+    float edgeC[3];
+    float depthA;
+    float depthB;
+    float depthC;
+    int minX;
+    int maxX;
+    int minY;
+    int maxY;
+} OccluderTriangle;
+
+static const int boxFaceCorners[6][4] = {
+    { 2, 6, 7, 3 },
+    { 0, 1, 5, 4 },
+    { 4, 5, 7, 6 },
+    { 0, 2, 3, 1 },
+    { 1, 3, 7, 5 },
+    { 0, 4, 6, 2 }
+};
+
+static float depthBuffer[OCCLUSION_WIDTH * OCCLUSION_HEIGHT];
+static float tileDepths[OCCLUSION_TILES_X * OCCLUSION_TILES_Y];
+static float coarseDepths[OCCLUSION_COARSE_X * OCCLUSION_COARSE_Y];
+
+static Matrix4 occlusionViewProjection;
+static OccluderTriangle* triangles = NULL;
+static int triangleCount = 0;
+static int triangleCapacity = 0;
+static bool isEnabled = true;
+static bool isBufferReady = false;
+
+static OcclusionStats occlusionStats = {
+    .occluderBoxes = 0,
+    .occluderTriangles = 0,
+    .testedBoxes = 0,
+    .occludedBoxes = 0
+};
+
+OcclusionStats getOcclusionStats() {
+    return occlusionStats;
+}
+
+bool isOcclusionEnabled() {
+    return isEnabled;
+}
+
+void setOcclusionEnabled(bool enabled) {
+    isEnabled = enabled;
+    isBufferReady = false;
+}
+
+void beginOcclusionFrame(const Matrix4* viewProjection) {
+    occlusionViewProjection = *viewProjection;
+    triangleCount = 0;
+    isBufferReady = false;
+
+    occlusionStats.occluderBoxes = 0;
+    occlusionStats.occluderTriangles = 0;
+    occlusionStats.testedBoxes = 0;
+    occlusionStats.occludedBoxes = 0;
+}
+
+static ClipVertex transformPoint(float x, float y, float z) {
+    const float* m = occlusionViewProjection.m;
+    ClipVertex result = {
+        .x = m[0] * x + m[4] * y + m[8] * z + m[12],
+        .y = m[1] * x + m[5] * y + m[9] * z + m[13],
+        .w = m[3] * x + m[7] * y + m[11] * z + m[15]
+    };
+    return result;
+}
+
+static int clipPolygonToNearPlane(const ClipVertex* input, int count, ClipVertex* output) {
+    int outputCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        const ClipVertex* current = &input[i];
+        const ClipVertex* next = &input[(i + 1) % count];
+        float currentDistance = current->w - OCCLUSION_NEAR_W;
+        float nextDistance = next->w - OCCLUSION_NEAR_W;
+
+        if (currentDistance >= 0.0f) {
+            output[outputCount++] = *current;
+        }
+
+        if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f)) {
+            float t = currentDistance / (currentDistance - nextDistance);
+            output[outputCount].x = current->x + (next->x - current->x) * t;
+            output[outputCount].y = current->y + (next->y - current->y) * t;
+            output[outputCount].w = current->w + (next->w - current->w) * t;
+            outputCount++;
+        }
+    }
+
+    return outputCount;
+}
+
+static void addOccluderTriangle(const float* xs, const float* ys, const float* depths) {
+    float area = (xs[1] - xs[0]) * (ys[2] - ys[0]) - (xs[2] - xs[0]) * (ys[1] - ys[0]);
+
+    if (area <= 0.0f) {
+        return;
+    }
+
+    float minX = fminf(xs[0], fminf(xs[1], xs[2]));
+    float maxX = fmaxf(xs[0], fmaxf(xs[1], xs[2]));
+    float minY = fminf(ys[0], fminf(ys[1], ys[2]));
+    float maxY = fmaxf(ys[0], fmaxf(ys[1], ys[2]));
+
+    if (maxX < 0.0f || maxY < 0.0f || minX > OCCLUSION_WIDTH || minY > OCCLUSION_HEIGHT) {
+        return;
+    }
+
+    OccluderTriangle triangle;
+    triangle.minX = minX > 0.0f ? (int)ceilf(minX - 0.5f) : 0;
+    triangle.maxX = maxX < OCCLUSION_WIDTH ? (int)floorf(maxX - 0.5f) : OCCLUSION_WIDTH - 1;
+    triangle.minY = minY > 0.0f ? (int)ceilf(minY - 0.5f) : 0;
+    triangle.maxY = maxY < OCCLUSION_HEIGHT ? (int)floorf(maxY - 0.5f) : OCCLUSION_HEIGHT - 1;
+
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+        return;
+    }
+
+    float inverseArea = 1.0f / area;
+    triangle.depthA = 0.0f;
+    triangle.depthB = 0.0f;
+    triangle.depthC = 0.0f;
+
+    for (int i = 0; i < 3; i++) {
+        int from = (i + 1) % 3;
+        int to = (i + 2) % 3;
+
+        triangle.edgeA[i] = ys[from] - ys[to];
+        triangle.edgeB[i] = xs[to] - xs[from];
+        triangle.edgeC[i] = xs[from] * ys[to] - xs[to] * ys[from];
+        triangle.depthA += triangle.edgeA[i] * depths[i] * inverseArea;
+        triangle.depthB += triangle.edgeB[i] * depths[i] * inverseArea;
+        triangle.depthC += triangle.edgeC[i] * depths[i] * inverseArea;
+    }
+
+    if (triangleCount == triangleCapacity) {
+        triangleCapacity = triangleCapacity == 0 ? 1024 : triangleCapacity * 2;
+        triangles = realloc(triangles, triangleCapacity * sizeof(OccluderTriangle));
+    }
+
+    triangles[triangleCount++] = triangle;
+    occlusionStats.occluderTriangles++;
+}
+
+static void addOccluderQuad(const ClipVertex* corners) {
+    ClipVertex clipped[5];
+    int count = clipPolygonToNearPlane(corners, 4, clipped);
+
+    if (count < 3) {
+        return;
+    }
+
+    float xs[5];
+    float ys[5];
+    float depths[5];
+
+    for (int i = 0; i < count; i++) {
+        depths[i] = 1.0f / clipped[i].w;
+        xs[i] = (clipped[i].x * depths[i] * 0.5f + 0.5f) * OCCLUSION_WIDTH;
+        ys[i] = (clipped[i].y * depths[i] * 0.5f + 0.5f) * OCCLUSION_HEIGHT;
+    }
+
+    for (int i = 1; i + 1 < count; i++) {
+        float triangleXs[3] = { xs[0], xs[i], xs[i + 1] };
+        float triangleYs[3] = { ys[0], ys[i], ys[i + 1] };
+        float triangleDepths[3] = { depths[0], depths[i], depths[i + 1] };
+        addOccluderTriangle(triangleXs, triangleYs, triangleDepths);
+    }
+}
+
+void addOccluderBox(Vector3 min, Vector3 max, int faceMask) {
+    if (!isEnabled) {
+        return;
+    }
+
+    ClipVertex corners[8];
+
+    for (int i = 0; i < 8; i++) {
+        corners[i] = transformPoint(
+            (float)((i & 1) ? max.x : min.x),
+            (float)((i & 2) ? max.y : min.y),
+            (float)((i & 4) ? max.z : min.z));
+    }
+
+    for (int face = 0; face < 6; face++) {
+        if ((faceMask & (1 << face)) == 0) {
+            continue;
+        }
+
+        ClipVertex quad[4];
+
+        for (int i = 0; i < 4; i++) {
+            quad[i] = corners[boxFaceCorners[face][i]];
+        }
+
+        addOccluderQuad(quad);
+    }
+
+    occlusionStats.occluderBoxes++;
+}
+
+static void rasterizeTriangleRows(const OccluderTriangle* triangle, int fromY, int toY) {
+#if defined(OCCLUSION_SSE)
+    __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    __m128 zero = _mm_setzero_ps();
+    __m128 edgeA0 = _mm_set1_ps(triangle->edgeA[0]);
+    __m128 edgeA1 = _mm_set1_ps(triangle->edgeA[1]);
+    __m128 edgeA2 = _mm_set1_ps(triangle->edgeA[2]);
+    __m128 depthA = _mm_set1_ps(triangle->depthA);
+    int startX = triangle->minX & ~3;
+
+    for (int y = fromY; y <= toY; y++) {
+        float pixelY = y + 0.5f;
+        float* row = &depthBuffer[y * OCCLUSION_WIDTH];
+        __m128 edgeRow0 = _mm_set1_ps(triangle->edgeB[0] * pixelY + triangle->edgeC[0]);
+        __m128 edgeRow1 = _mm_set1_ps(triangle->edgeB[1] * pixelY + triangle->edgeC[1]);
+        __m128 edgeRow2 = _mm_set1_ps(triangle->edgeB[2] * pixelY + triangle->edgeC[2]);
+        __m128 depthRow = _mm_set1_ps(triangle->depthB * pixelY + triangle->depthC);
+
+        for (int x = startX; x <= triangle->maxX; x += 4) {
+            __m128 pixelX = _mm_add_ps(_mm_set1_ps((float)x), pixelOffsets);
+            __m128 inside = _mm_and_ps(
+                _mm_and_ps(
+                    _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA0, pixelX), edgeRow0), zero),
+                    _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA1, pixelX), edgeRow1), zero)),
+                _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA2, pixelX), edgeRow2), zero));
+
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+
+            __m128 depth = _mm_and_ps(inside, _mm_add_ps(_mm_mul_ps(depthA, pixelX), depthRow));
+            _mm_storeu_ps(&row[x], _mm_max_ps(_mm_loadu_ps(&row[x]), depth));
+        }
+    }
+#else
+    for (int y = fromY; y <= toY; y++) {
+        float pixelY = y + 0.5f;
+        float* row = &depthBuffer[y * OCCLUSION_WIDTH];
+
+        for (int x = triangle->minX; x <= triangle->maxX; x++) {
+            float pixelX = x + 0.5f;
+            bool isInside = true;
+
+            for (int i = 0; i < 3; i++) {
+                isInside = isInside && triangle->edgeA[i] * pixelX + triangle->edgeB[i] * pixelY + triangle->edgeC[i] >= 0.0f;
+            }
+
+            float depth = triangle->depthA * pixelX + triangle->depthB * pixelY + triangle->depthC;
+
+            if (isInside && depth > row[x]) {
+                row[x] = depth;
+            }
+        }
+    }
+#endif
+}
+
+static void buildTileDepths(int fromY, int toY) {
+    for (int tileY = fromY / OCCLUSION_TILE_SIZE; tileY <= toY / OCCLUSION_TILE_SIZE; tileY++) {
+        for (int tileX = 0; tileX < OCCLUSION_TILES_X; tileX++) {
+            float minDepth = INFINITY;
+
+            for (int y = 0; y < OCCLUSION_TILE_SIZE; y++) {
+                const float* row = &depthBuffer[(tileY * OCCLUSION_TILE_SIZE + y) * OCCLUSION_WIDTH + tileX * OCCLUSION_TILE_SIZE];
+
+                for (int x = 0; x < OCCLUSION_TILE_SIZE; x++) {
+                    minDepth = row[x] < minDepth ? row[x] : minDepth;
+                }
+            }
+
+            tileDepths[tileY * OCCLUSION_TILES_X + tileX] = minDepth;
+        }
+    }
+}
+
+static void rasterizeBand(int band, void* context) {
+    int fromY = band * OCCLUSION_BAND_HEIGHT;
+    int toY = fromY + OCCLUSION_BAND_HEIGHT - 1;
+
+    memset(&depthBuffer[fromY * OCCLUSION_WIDTH], 0, OCCLUSION_BAND_HEIGHT * OCCLUSION_WIDTH * sizeof(float));
+
+    for (int i = 0; i < triangleCount; i++) {
+        const OccluderTriangle* triangle = &triangles[i];
+
+        if (triangle->maxY < fromY || triangle->minY > toY) {
+            continue;
+        }
+
+        rasterizeTriangleRows(triangle, triangle->minY > fromY ? triangle->minY : fromY,
+            triangle->maxY < toY ? triangle->maxY : toY);
+    }
+
+    buildTileDepths(fromY, toY);
+}
+
+static void buildCoarseDepths() {
+    for (int coarseY = 0; coarseY < OCCLUSION_COARSE_Y; coarseY++) {
+        for (int coarseX = 0; coarseX < OCCLUSION_COARSE_X; coarseX++) {
+            float minDepth = INFINITY;
+
+            for (int y = 0; y < OCCLUSION_COARSE_RATIO; y++) {
+                for (int x = 0; x < OCCLUSION_COARSE_RATIO; x++) {
+                    float depth = tileDepths[(coarseY * OCCLUSION_COARSE_RATIO + y) * OCCLUSION_TILES_X
+                        + coarseX * OCCLUSION_COARSE_RATIO + x];
+                    minDepth = depth < minDepth ? depth : minDepth;
+                }
+            }
+
+            coarseDepths[coarseY * OCCLUSION_COARSE_X + coarseX] = minDepth;
+        }
+    }
+}
+
+void rasterizeOccluders() {
+    if (!isEnabled || triangleCount == 0) {
+        return;
+    }
+
+    runWorkersParallel(OCCLUSION_BAND_COUNT, rasterizeBand, NULL);
+    buildCoarseDepths();
+    isBufferReady = true;
+}
+
+static bool isRectCoveredByTile(int tileX, int tileY, int fromX, int fromY, int toX, int toY, float depth) {
+    if (tileDepths[tileY * OCCLUSION_TILES_X + tileX] > depth) {
+        return true;
+    }
+
+    int startX = tileX * OCCLUSION_TILE_SIZE > fromX ? tileX * OCCLUSION_TILE_SIZE : fromX;
+    int startY = tileY * OCCLUSION_TILE_SIZE > fromY ? tileY * OCCLUSION_TILE_SIZE : fromY;
+    int endX = (tileX + 1) * OCCLUSION_TILE_SIZE - 1 < toX ? (tileX + 1) * OCCLUSION_TILE_SIZE - 1 : toX;
+    int endY = (tileY + 1) * OCCLUSION_TILE_SIZE - 1 < toY ? (tileY + 1) * OCCLUSION_TILE_SIZE - 1 : toY;
+
+    for (int y = startY; y <= endY; y++) {
+        const float* row = &depthBuffer[y * OCCLUSION_WIDTH];
+
+        for (int x = startX; x <= endX; x++) {
+            if (row[x] <= depth) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool isRectOccluded(int fromX, int fromY, int toX, int toY, float depth) {
+    bool isCoarseCovered = true;
+
+    for (int y = fromY / OCCLUSION_COARSE_TILE_SIZE; y <= toY / OCCLUSION_COARSE_TILE_SIZE && isCoarseCovered; y++) {
+        for (int x = fromX / OCCLUSION_COARSE_TILE_SIZE; x <= toX / OCCLUSION_COARSE_TILE_SIZE; x++) {
+            if (coarseDepths[y * OCCLUSION_COARSE_X + x] <= depth) {
+                isCoarseCovered = false;
+                break;
+            }
+        }
+    }
+
+    if (isCoarseCovered) {
+        return true;
+    }
+
+    for (int y = fromY / OCCLUSION_TILE_SIZE; y <= toY / OCCLUSION_TILE_SIZE; y++) {
+        for (int x = fromX / OCCLUSION_TILE_SIZE; x <= toX / OCCLUSION_TILE_SIZE; x++) {
+            if (!isRectCoveredByTile(x, y, fromX, fromY, toX, toY, depth)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool isAABBOccluded(const Vector3* center, const Vector3* extents) {
+    if (!isEnabled || !isBufferReady) {
+        return false;
+    }
+
+    occlusionStats.testedBoxes++;
+
+    float minX = INFINITY;
+    float minY = INFINITY;
+    float maxX = -INFINITY;
+    float maxY = -INFINITY;
+    float nearestDepth = 0.0f;
+
+    for (int i = 0; i < 8; i++) {
+        ClipVertex corner = transformPoint(
+            (float)(center->x + ((i & 1) ? extents->x : -extents->x)),
+            (float)(center->y + ((i & 2) ? extents->y : -extents->y)),
+            (float)(center->z + ((i & 4) ? extents->z : -extents->z)));
+
+        if (corner.w < OCCLUSION_NEAR_W) {
+            return false;
+        }
+
+        float depth = 1.0f / corner.w;
+        float x = (corner.x * depth * 0.5f + 0.5f) * OCCLUSION_WIDTH;
+        float y = (corner.y * depth * 0.5f + 0.5f) * OCCLUSION_HEIGHT;
+
+        minX = x < minX ? x : minX;
+        minY = y < minY ? y : minY;
+        maxX = x > maxX ? x : maxX;
+        maxY = y > maxY ? y : maxY;
+        nearestDepth = depth > nearestDepth ? depth : nearestDepth;
+    }
+
+    if (maxX < 0.0f || maxY < 0.0f || minX >= OCCLUSION_WIDTH || minY >= OCCLUSION_HEIGHT) {
+        return false;
+    }
+
+    int fromX = minX > 1.0f ? (int)minX - 1 : 0;
+    int fromY = minY > 1.0f ? (int)minY - 1 : 0;
+    int toX = maxX < OCCLUSION_WIDTH - 1 ? (int)maxX + 1 : OCCLUSION_WIDTH - 1;
+    int toY = maxY < OCCLUSION_HEIGHT - 1 ? (int)maxY + 1 : OCCLUSION_HEIGHT - 1;
+
+    if (!isRectOccluded(fromX, fromY, toX, toY, nearestDepth * (1.0f + OCCLUSION_DEPTH_BIAS))) {
+        return false;
+    }
+
+    occlusionStats.occludedBoxes++;
+    return true;
+}
+
+void freeOcclusion() {
+    free(triangles);
+    triangles = NULL;
+    triangleCount = 0;
+    triangleCapacity = 0;
+    isBufferReady = false;
+}
@@ -0,0 +1,31 @@
+#ifndef BLOCKS_OCCLUSION
+#define BLOCKS_OCCLUSION
+
+#include <stdbool.h>
+#include "types.h"
+#include "matrix.h"
+
+#define OCCLUSION_WIDTH 256
+#define OCCLUSION_HEIGHT 128
+#define OCCLUSION_TILE_SIZE 8
+#define OCCLUSION_COARSE_TILE_SIZE 32
+#define OCCLUSION_BAND_COUNT 8
+#define OCCLUSION_FACE_ALL 0x3F
+
+typedef struct OcclusionStats {
+	int occluderBoxes;
+	int occluderTriangles;
+	int testedBoxes;
+	int occludedBoxes;
+} OcclusionStats;
+
+bool isOcclusionEnabled();
+void setOcclusionEnabled(bool isEnabled);
+void beginOcclusionFrame(const Matrix4* viewProjection);
+void addOccluderBox(Vector3 min, Vector3 max, int faceMask);
+void rasterizeOccluders();
+bool isAABBOccluded(const Vector3* center, const Vector3* extents);
+OcclusionStats getOcclusionStats();
+void freeOcclusion();
+
+#endif
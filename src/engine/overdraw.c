@@ -0,0 +1,101 @@
+#include "overdraw.h"
+
+typedef struct OverdrawQuery {
+    GLuint id;
+    long long coveredSamples;
+    bool isPending;
+} OverdrawQuery;
+
+static OverdrawQuery queries[OVERDRAW_QUERY_COUNT];
+static int nextQuery = 0;
+static int sampleCount = 1;
+static bool isQueryActive = false;
+
+static OverdrawStats overdrawStats = {
+    .samplesPassed = 0,
+    .coveredSamples = 0,
+    .completedQueries = 0,
+    .skippedQueries = 0
+};
+
+OverdrawStats getOverdrawStats() {
+    return overdrawStats;
+}
+
+bool initOverdrawQueries() {
+    GLint samples = 0;
+    glGetIntegerv(GL_SAMPLES, &samples);
+    sampleCount = samples > 1 ? samples : 1;
+
+    for (int i = 0; i < OVERDRAW_QUERY_COUNT; i++) {
+        glGenQueries(1, &queries[i].id);
+        queries[i].isPending = false;
+    }
+
+    return queries[0].id != 0;
+}
+
+static void collectQueryResults() {
+    for (int i = 0; i < OVERDRAW_QUERY_COUNT; i++) {
+        OverdrawQuery* query = &queries[i];
+        GLint isAvailable = 0;
+
+        if (!query->isPending) {
+            continue;
+        }
+
+        glGetQueryObjectiv(query->id, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+        if (!isAvailable) {
+            continue;
+        }
+
+        GLuint samplesPassed = 0;
+        glGetQueryObjectuiv(query->id, GL_QUERY_RESULT, &samplesPassed);
+
+        overdrawStats.samplesPassed += samplesPassed;
+        overdrawStats.coveredSamples += query->coveredSamples;
+        overdrawStats.completedQueries++;
+        query->isPending = false;
+    }
+}
+
+void beginOverdrawQuery(int width, int height) {
+    collectQueryResults();
+
+    OverdrawQuery* query = &queries[nextQuery];
+
+    if (query->id == 0 || query->isPending) {
+        overdrawStats.skippedQueries++;
+        return;
+    }
+
+    query->coveredSamples = (long long)width * height * sampleCount;
+    glBeginQuery(GL_SAMPLES_PASSED, query->id);
+    isQueryActive = true;
+}
+
+void endOverdrawQuery() {
+    if (!isQueryActive) {
+        return;
+    }
+
+    glEndQuery(GL_SAMPLES_PASSED);
+    queries[nextQuery].isPending = true;
+    nextQuery = (nextQuery + 1) % OVERDRAW_QUERY_COUNT;
+    isQueryActive = false;
+}
+
+void freeOverdrawQueries() {
+    for (int i = 0; i < OVERDRAW_QUERY_COUNT; i++) {
+        if (queries[i].id != 0) {
+            glDeleteQueries(1, &queries[i].id);
+            queries[i].id = 0;
+        }
+
+        queries[i].isPending = false;
+    }
+
+    nextQuery = 0;
+    isQueryActive = false;
+}
@@ -0,0 +1,26 @@
+#ifndef BLOCKS_OVERDRAW
+#define BLOCKS_OVERDRAW
+
+#include <stdbool.h>
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#define OVERDRAW_QUERY_COUNT 4
+
+typedef struct OverdrawStats {
+	long long samplesPassed;
+	long long coveredSamples;
+	int completedQueries;
+	int skippedQueries;
+} OverdrawStats;
+
+bool initOverdrawQueries();
+void beginOverdrawQuery(int width, int height);
+void endOverdrawQuery();
+OverdrawStats getOverdrawStats();
+void freeOverdrawQueries();
+
+#endif
@@ -24,7 +24,11 @@ PlayerState currentPlayerState = {
 	.height = 1.8,
 	.speed = 0.004,
 	.inAir = false,
-	.lookingAtBlock = NULL,
+	.lookingAtBlock = {
+		.x = 0.0,
+		.y = 0.0,
+		.z = 0.0
+	},
 	.isLookingAtBlock = false
 };
 
@@ -33,19 +37,13 @@ PlayerState getPlayerState() {
 }
 
 void drawInHandItem() {
-    glPushMatrix();
-
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-
-    glTranslatef(0.5f, 0.0f, -0.5f);
-	glRotatef(20.0f, 0.0f, 1.0f, 0.0f);
-	glRotatef(-15.0f, 1.0f, 0.0f, 0.0f);
-    glScalef(0.6f, 0.8f, 0.8f);
-
-    drawCube((Vector3) { -0.5f, 0.0f, -0.5f }, getColorByType(1), DEFAULT_OUTLINE_COLOR);
+    Matrix4 handMatrix = getTranslationMatrix(0.5, 0.0, -0.5);
+    handMatrix = multiplyMatrices(handMatrix, getRotationMatrix(20.0, 0.0, 1.0, 0.0));
+    handMatrix = multiplyMatrices(handMatrix, getRotationMatrix(-15.0, 1.0, 0.0, 0.0));
+    handMatrix = multiplyMatrices(handMatrix, getScaleMatrix(0.6, 0.8, 0.8));
 
-    glPopMatrix();
+    setCubeViewProjection(&handMatrix);
+    drawCube((Vector3) { -0.5f, 0.0f, -0.5f }, 1, DEFAULT_OUTLINE_COLOR);
 }
 
 void playerFollowViewport() {
@@ -74,7 +72,6 @@ void updateLookingAtBlock() {
     PlayerState ps = getPlayerState();
 
     currentPlayerState.isLookingAtBlock = false;
-    currentPlayerState.lookingAtBlock = NULL;
     currentPlayerState.lookingAtBlockSurfacePoint = (Vector3){0.0f, 0.0f, 0.0f};
 
     Vector3 rayOrigin;
@@ -102,13 +99,13 @@ void updateLookingAtBlock() {
         int blockY = floorf(checkPos.y);
         int blockZ = floorf(checkPos.z);
 
-        GameElement* block = getBlockAtGlobal(ws, blockX, blockY, blockZ);
+        GameElement block;
 
-        if (block != NULL && block->elementType != 0) {
+        if (getBlockAtGlobal(ws, blockX, blockY, blockZ, &block)) {
             Vector3 blockCenter;
-            blockCenter.x = block->position.x + 0.5f;
-            blockCenter.y = block->position.y + 0.5f;
-            blockCenter.z = block->position.z + 0.5f;
+            blockCenter.x = block.position.x + 0.5f;
+            blockCenter.y = block.position.y + 0.5f;
+            blockCenter.z = block.position.z + 0.5f;
 
             float dx = blockCenter.x - rayOrigin.x;
             float dy = blockCenter.y - rayOrigin.y;
@@ -117,11 +114,10 @@ void updateLookingAtBlock() {
 
             if (actualDistanceToBlockCenter <= 4.0f) {
                 currentPlayerState.isLookingAtBlock = true;
-                currentPlayerState.lookingAtBlock = (Vector3*)&block->position;
+                currentPlayerState.lookingAtBlock = block.position;
                 currentPlayerState.lookingAtBlockSurfacePoint = checkPos;
             } else {
                 currentPlayerState.isLookingAtBlock = false;
-                currentPlayerState.lookingAtBlock = NULL;
             }
             return;
         }
@@ -129,12 +125,12 @@ void updateLookingAtBlock() {
 }
 
 int getBlockFace() {
-    if (!currentPlayerState.isLookingAtBlock || currentPlayerState.lookingAtBlock == NULL) {
+    if (!currentPlayerState.isLookingAtBlock) {
         return BLOCK_FACE_NONE;
     }
 
     Vector3 intersectionPoint = currentPlayerState.lookingAtBlockSurfacePoint;
-    Vector3 targetBlockIntegerCoordinates = *currentPlayerState.lookingAtBlock;
+    Vector3 targetBlockIntegerCoordinates = currentPlayerState.lookingAtBlock;
 
     float blockCenterX = targetBlockIntegerCoordinates.x + 0.5f;
     float blockCenterY = targetBlockIntegerCoordinates.y + 0.5f;
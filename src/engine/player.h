@@ -12,7 +12,7 @@ typedef struct PlayerState {
 	double height;
 	double speed;
 	bool inAir;
-	Vector3* lookingAtBlock;
+	Vector3 lookingAtBlock;
 	bool isLookingAtBlock;
 	Vector3 lookingAtBlockSurfacePoint;
 } PlayerState;
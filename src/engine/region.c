@@ -0,0 +1,882 @@
+#include "region.h"
+#include "visibility.h"
+#include "fileutils.h"
+#include "workers.h"
+#include "journal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+
+static SRWLOCK regionMutex = SRWLOCK_INIT;
+
+#define lockRegionFiles() AcquireSRWLockExclusive(&regionMutex)
+#define unlockRegionFiles() ReleaseSRWLockExclusive(&regionMutex)
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static pthread_mutex_t regionMutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define lockRegionFiles() pthread_mutex_lock(&regionMutex)
+#define unlockRegionFiles() pthread_mutex_unlock(&regionMutex)
+#endif
+
+#define REGION_MAGIC "BLKR"
+#define REGION_VERSION 2
+#define REGION_CACHE_SIZE 8
+#define REGION_COMPACT_SLACK (64 * 1024)
+#define REGION_MAPPING_SLACK (1024 * 1024)
+#define REGION_PATH_LENGTH 256
+#define REGION_UNSYNCED_CAPACITY 16
+#define MAX_PENDING_SAVES 32
+
+typedef struct RegionEntry {
+    uint32_t offset;
+    uint32_t compressedSize;
+    uint32_t rawSize;
+    uint32_t checksum;
+    uint64_t journalSequence;
+} RegionEntry;
+
+typedef struct RegionHeader {
+    char magic[4];
+    uint32_t version;
+    RegionEntry entries[REGION_COLUMN_COUNT];
+} RegionHeader;
+
+typedef struct RegionFile {
+    int x;
+    int z;
+    bool inUse;
+    unsigned int lastUse;
+    const uint8_t* data;
+    size_t size;
+    size_t mappedSize;
+    FILE* writer;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} RegionFile;
+
+typedef struct SaveJob {
+    int x;
+    int z;
+    uint8_t* raw;
+    size_t rawSize;
+    uint64_t journalSequence;
+    WorldState* world;
+    int revision;
+    unsigned int submitOrder;
+    WorkerGroup group;
+    bool isSaved;
+    bool inUse;
+} SaveJob;
+
+typedef struct PayloadReader {
+    const uint8_t* cursor;
+    const uint8_t* end;
+} PayloadReader;
+
+static RegionFile regionFiles[REGION_CACHE_SIZE];
+static unsigned int regionUseCounter = 0;
+
+static SaveJob saveJobs[MAX_PENDING_SAVES];
+static unsigned int saveSubmitCounter = 0;
+
+static IntVector3 unsyncedRegions[REGION_UNSYNCED_CAPACITY];
+static int unsyncedRegionCount = 0;
+
+static RegionStats regionStats = {
+    .loadedColumns = 0,
+    .savedColumns = 0,
+    .compactedRegions = 0,
+    .failedSaves = 0,
+    .loadedBytes = 0
+};
+
+RegionStats getRegionStats() {
+    lockRegionFiles();
+    RegionStats stats = regionStats;
+    unlockRegionFiles();
+
+    return stats;
+}
+
+static void getRegionPath(int regionX, int regionZ, const char* suffix, char* path) {
+    snprintf(path, REGION_PATH_LENGTH, "%s/r.%d.%d.bin%s", REGION_DIRECTORY, regionX, regionZ, suffix);
+}
+
+static int getRegionColumnIndex(int columnX, int columnZ) {
+    return (columnX & (REGION_SIZE - 1)) + (columnZ & (REGION_SIZE - 1)) * REGION_SIZE;
+}
+
+static uint32_t getChecksum(const uint8_t* data, size_t size) {
+    uint32_t a = 1;
+    uint32_t b = 0;
+
+    while (size > 0) {
+        size_t blockSize = size < 5552 ? size : 5552;
+        size -= blockSize;
+
+        while (blockSize-- > 0) {
+            a += *data++;
+            b += a;
+        }
+
+        a %= 65521;
+        b %= 65521;
+    }
+
+    return (b << 16) | a;
+}
+
+static size_t compressPayload(const uint8_t* input, size_t size, uint8_t* output) {
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < size) {
+        size_t run = 1;
+        while (in + run < size && run < 130 && input[in + run] == input[in]) {
+            run++;
+        }
+
+        if (run >= 3) {
+            output[out++] = (uint8_t)(run + 125);
+            output[out++] = input[in];
+            in += run;
+            continue;
+        }
+
+        size_t literalStart = in;
+        size_t literal = 0;
+
+        while (in < size && literal < 128) {
+            if (in + 2 < size && input[in] == input[in + 1] && input[in] == input[in + 2]) {
+                break;
+            }
+
+            in++;
+            literal++;
+        }
+
+        output[out++] = (uint8_t)(literal - 1);
+        memcpy(output + out, input + literalStart, literal);
+        out += literal;
+    }
+
+    return out;
+}
+
+static bool decompressPayload(const uint8_t* input, size_t size, uint8_t* output, size_t outputSize) {
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < size) {
+        uint8_t control = input[in++];
+
+        if (control < 128) {
+            size_t literal = (size_t)control + 1;
+
+            if (in + literal > size || out + literal > outputSize) {
+                return false;
+            }
+
+            memcpy(output + out, input + in, literal);
+            in += literal;
+            out += literal;
+        } else {
+            size_t run = (size_t)control - 125;
+
+            if (in >= size || out + run > outputSize) {
+                return false;
+            }
+
+            memset(output + out, input[in++], run);
+            out += run;
+        }
+    }
+
+    return out == outputSize;
+}
+
+static size_t getMaxColumnPayloadSize() {
+    size_t maxSectionSize = sizeof(int32_t) + sizeof(uint8_t) + sizeof(uint16_t)
+        + ((size_t)1 << BLOCK_STORAGE_MAX_BITS) * sizeof(int32_t)
+        + BLOCK_STORAGE_SIZE * BLOCK_STORAGE_MAX_BITS / 8;
+
+    return CHUNK_SECTION_COUNT * maxSectionSize;
+}
+
+static uint8_t* writeBytes(uint8_t* cursor, const void* source, size_t size) {
+    memcpy(cursor, source, size);
+    return cursor + size;
+}
+
+static bool readBytes(PayloadReader* reader, void* destination, size_t size) {
+    if ((size_t)(reader->end - reader->cursor) < size) {
+        return false;
+    }
+
+    memcpy(destination, reader->cursor, size);
+    reader->cursor += size;
+    return true;
+}
+
+static size_t writeChunkColumn(const ChunkColumn* column, uint8_t* output) {
+    uint8_t* cursor = output;
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        const Chunk* chunk = &column->sections[section];
+        int32_t uniformType = chunk->uniformType;
+
+        cursor = writeBytes(cursor, &uniformType, sizeof(uniformType));
+
+        if (uniformType != CHUNK_MIXED) {
+            continue;
+        }
+
+        uint8_t bitsPerBlock = (uint8_t)chunk->blocks.bitsPerBlock;
+        uint16_t paletteSize = (uint16_t)chunk->blocks.paletteSize;
+
+        cursor = writeBytes(cursor, &bitsPerBlock, sizeof(bitsPerBlock));
+        cursor = writeBytes(cursor, &paletteSize, sizeof(paletteSize));
+
+        for (int i = 0; i < paletteSize; i++) {
+            int32_t type = chunk->blocks.palette[i];
+            cursor = writeBytes(cursor, &type, sizeof(type));
+        }
+
+        cursor = writeBytes(cursor, chunk->blocks.data, BLOCK_STORAGE_SIZE * bitsPerBlock / 8);
+    }
+
+    return cursor - output;
+}
+
+static bool readChunkSection(Chunk* chunk, PayloadReader* reader) {
+    int32_t uniformType;
+
+    if (!readBytes(reader, &uniformType, sizeof(uniformType)) || uniformType < CHUNK_MIXED) {
+        return false;
+    }
+
+    chunk->uniformType = uniformType;
+
+    if (uniformType != CHUNK_MIXED) {
+        return true;
+    }
+
+    uint8_t bitsPerBlock;
+    uint16_t paletteSize;
+
+    if (!readBytes(reader, &bitsPerBlock, sizeof(bitsPerBlock))
+        || !readBytes(reader, &paletteSize, sizeof(paletteSize))) {
+        return false;
+    }
+
+    if ((bitsPerBlock != 1 && bitsPerBlock != 2 && bitsPerBlock != 4 && bitsPerBlock != 8)
+        || paletteSize == 0 || paletteSize > 1 << bitsPerBlock) {
+        return false;
+    }
+
+    chunk->blocks.bitsPerBlock = bitsPerBlock;
+    chunk->blocks.paletteSize = paletteSize;
+    chunk->blocks.palette = calloc((size_t)1 << bitsPerBlock, sizeof(int));
+    chunk->blocks.data = malloc(BLOCK_STORAGE_SIZE * bitsPerBlock / 8);
+    chunk->solidRows = calloc(CHUNK_ROW_COUNT, sizeof(uint16_t));
+
+    for (int i = 0; i < paletteSize; i++) {
+        int32_t type;
+
+        if (!readBytes(reader, &type, sizeof(type))) {
+            return false;
+        }
+
+        chunk->blocks.palette[i] = type;
+    }
+
+    if (!readBytes(reader, chunk->blocks.data, BLOCK_STORAGE_SIZE * bitsPerBlock / 8)) {
+        return false;
+    }
+
+    fillStorageOccupancy(&chunk->blocks, chunk->solidRows);
+    return true;
+}
+
+static bool readChunkColumn(ChunkColumn* column, const uint8_t* input, size_t size) {
+    PayloadReader reader = { .cursor = input, .end = input + size };
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        Chunk* chunk = &column->sections[section];
+
+        memset(chunk, 0, sizeof(Chunk));
+        chunk->position.x = column->x;
+        chunk->position.y = section;
+        chunk->position.z = column->z;
+    }
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        if (!readChunkSection(&column->sections[section], &reader)) {
+            freeChunkColumn(column);
+            return false;
+        }
+    }
+
+    if (reader.cursor != reader.end) {
+        freeChunkColumn(column);
+        return false;
+    }
+
+    rebuildColumnSurface(column);
+    return true;
+}
+
+static void unmapRegionFile(RegionFile* region) {
+#if defined(_WIN32)
+    if (region->data != NULL) {
+        UnmapViewOfFile(region->data);
+    }
+    if (region->mapping != NULL) {
+        CloseHandle(region->mapping);
+    }
+    if (region->file != NULL) {
+        CloseHandle(region->file);
+    }
+    region->file = NULL;
+    region->mapping = NULL;
+#else
+    if (region->data != NULL) {
+        munmap((void*)region->data, region->mappedSize);
+    }
+#endif
+
+    region->data = NULL;
+    region->size = 0;
+    region->mappedSize = 0;
+}
+
+static void mapRegionFile(RegionFile* region) {
+    char path[REGION_PATH_LENGTH];
+    getRegionPath(region->x, region->z, "", path);
+
+    region->data = NULL;
+    region->size = 0;
+    region->mappedSize = 0;
+
+#if defined(_WIN32)
+    region->mapping = NULL;
+    region->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (region->file == INVALID_HANDLE_VALUE) {
+        region->file = NULL;
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(region->file, &fileSize) && fileSize.QuadPart >= (LONGLONG)sizeof(RegionHeader)) {
+        region->mapping = CreateFileMappingA(region->file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (region->mapping != NULL) {
+            region->data = MapViewOfFile(region->mapping, FILE_MAP_READ, 0, 0, 0);
+            region->size = region->data != NULL ? (size_t)fileSize.QuadPart : 0;
+            region->mappedSize = region->size;
+        }
+    }
+#else
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size >= (off_t)sizeof(RegionHeader)) {
+        size_t mappedSize = (size_t)fileStat.st_size + REGION_MAPPING_SLACK;
+        void* data = mmap(NULL, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+
+        if (data != MAP_FAILED) {
+            region->data = data;
+            region->size = (size_t)fileStat.st_size;
+            region->mappedSize = mappedSize;
+        }
+    }
+
+    close(fd);
+#endif
+
+    if (region->data != NULL) {
+        uint32_t version;
+        memcpy(&version, region->data + offsetof(RegionHeader, version), sizeof(version));
+
+        if (memcmp(region->data, REGION_MAGIC, 4) != 0 || version != REGION_VERSION) {
+            fprintf(stderr, "Ignoring invalid region file %s\n", path);
+            unmapRegionFile(region);
+        }
+    }
+}
+
+static void releaseRegionFile(RegionFile* region) {
+    if (region->writer != NULL) {
+        fclose(region->writer);
+        region->writer = NULL;
+    }
+
+    unmapRegionFile(region);
+    region->inUse = false;
+}
+
+static void growRegionMapping(RegionFile* region, size_t fileSize) {
+    if (region->data != NULL && fileSize <= region->mappedSize) {
+        region->size = fileSize;
+        return;
+    }
+
+    unmapRegionFile(region);
+    mapRegionFile(region);
+}
+
+static RegionFile* getRegionFile(int regionX, int regionZ) {
+    RegionFile* slot = NULL;
+
+    for (int i = 0; i < REGION_CACHE_SIZE; i++) {
+        RegionFile* region = &regionFiles[i];
+
+        if (region->inUse && region->x == regionX && region->z == regionZ) {
+            region->lastUse = ++regionUseCounter;
+            return region;
+        }
+
+        if (slot == NULL || !region->inUse || (slot->inUse && region->lastUse < slot->lastUse)) {
+            slot = region;
+        }
+    }
+
+    if (slot->inUse) {
+        releaseRegionFile(slot);
+    }
+
+    slot->x = regionX;
+    slot->z = regionZ;
+    slot->inUse = true;
+    slot->lastUse = ++regionUseCounter;
+    mapRegionFile(slot);
+
+    return slot;
+}
+
+static void closeRegionFile(int regionX, int regionZ) {
+    for (int i = 0; i < REGION_CACHE_SIZE; i++) {
+        RegionFile* region = &regionFiles[i];
+
+        if (region->inUse && region->x == regionX && region->z == regionZ) {
+            releaseRegionFile(region);
+        }
+    }
+}
+
+void closeRegionFiles() {
+    lockRegionFiles();
+
+    for (int i = 0; i < REGION_CACHE_SIZE; i++) {
+        if (regionFiles[i].inUse) {
+            releaseRegionFile(&regionFiles[i]);
+        }
+    }
+
+    unlockRegionFiles();
+}
+
+static RegionEntry getRegionEntry(const RegionFile* region, int index) {
+    RegionEntry entry;
+    memcpy(&entry, region->data + offsetof(RegionHeader, entries) + index * sizeof(RegionEntry), sizeof(RegionEntry));
+    return entry;
+}
+
+static bool readColumnPayload(int columnX, int columnZ, uint8_t* raw, RegionEntry* entry) {
+    RegionFile* region = getRegionFile(columnX >> REGION_SHIFT, columnZ >> REGION_SHIFT);
+
+    if (region->data == NULL) {
+        return false;
+    }
+
+    *entry = getRegionEntry(region, getRegionColumnIndex(columnX, columnZ));
+
+    if (entry->compressedSize == 0 || entry->offset < sizeof(RegionHeader)
+        || entry->offset > region->size || entry->compressedSize > region->size - entry->offset
+        || entry->rawSize > getMaxColumnPayloadSize()) {
+        return false;
+    }
+
+    const uint8_t* payload = region->data + entry->offset;
+
+    if (getChecksum(payload, entry->compressedSize) != entry->checksum) {
+        fprintf(stderr, "Checksum mismatch for column %d, %d\n", columnX, columnZ);
+        return false;
+    }
+
+    return decompressPayload(payload, entry->compressedSize, raw, entry->rawSize);
+}
+
+bool loadChunkColumn(ChunkColumn* column) {
+    RegionEntry entry;
+    uint8_t* raw = malloc(getMaxColumnPayloadSize());
+
+    lockRegionFiles();
+    bool isLoaded = readColumnPayload(column->x, column->z, raw, &entry);
+    unlockRegionFiles();
+
+    isLoaded = isLoaded && readChunkColumn(column, raw, entry.rawSize);
+    free(raw);
+
+    if (isLoaded) {
+        column->isModified = false;
+        column->journalSequence = entry.journalSequence;
+
+        lockRegionFiles();
+        regionStats.loadedColumns++;
+        regionStats.loadedBytes += entry.compressedSize;
+        unlockRegionFiles();
+    }
+
+    return isLoaded;
+}
+
+static FILE* openRegionFileForWriting(int regionX, int regionZ) {
+    char path[REGION_PATH_LENGTH];
+    getRegionPath(regionX, regionZ, "", path);
+
+    FILE* file = fopen(path, "r+b");
+
+    if (file != NULL) {
+        char magic[4];
+        uint32_t version;
+
+        if (fread(magic, sizeof(magic), 1, file) == 1 && fread(&version, sizeof(version), 1, file) == 1
+            && memcmp(magic, REGION_MAGIC, 4) == 0 && version == REGION_VERSION) {
+            return file;
+        }
+
+        fclose(file);
+    }
+
+    makeDirectory(REGION_DIRECTORY);
+    file = fopen(path, "w+b");
+
+    if (file == NULL) {
+        return NULL;
+    }
+
+    RegionHeader* header = calloc(1, sizeof(RegionHeader));
+    memcpy(header->magic, REGION_MAGIC, 4);
+    header->version = REGION_VERSION;
+
+    bool isWritten = fwrite(header, sizeof(RegionHeader), 1, file) == 1;
+    free(header);
+
+    if (!isWritten) {
+        fclose(file);
+        return NULL;
+    }
+
+    return file;
+}
+
+static void compactRegionFile(int regionX, int regionZ) {
+    RegionFile* region = getRegionFile(regionX, regionZ);
+
+    if (region->data == NULL) {
+        return;
+    }
+
+    size_t liveBytes = 0;
+    for (int i = 0; i < REGION_COLUMN_COUNT; i++) {
+        liveBytes += getRegionEntry(region, i).compressedSize;
+    }
+
+    if (region->size - sizeof(RegionHeader) <= liveBytes * 2 + REGION_COMPACT_SLACK) {
+        return;
+    }
+
+    char path[REGION_PATH_LENGTH];
+    char temporaryPath[REGION_PATH_LENGTH];
+    getRegionPath(regionX, regionZ, "", path);
+    getRegionPath(regionX, regionZ, ".tmp", temporaryPath);
+
+    FILE* file = fopen(temporaryPath, "wb");
+
+    if (file == NULL) {
+        return;
+    }
+
+    RegionHeader* header = calloc(1, sizeof(RegionHeader));
+    memcpy(header->magic, REGION_MAGIC, 4);
+    header->version = REGION_VERSION;
+
+    uint32_t offset = sizeof(RegionHeader);
+    bool isWritten = fseek(file, sizeof(RegionHeader), SEEK_SET) == 0;
+
+    for (int i = 0; i < REGION_COLUMN_COUNT && isWritten; i++) {
+        RegionEntry entry = getRegionEntry(region, i);
+
+        if (entry.compressedSize == 0 || entry.offset > region->size
+            || entry.compressedSize > region->size - entry.offset) {
+            continue;
+        }
+
+        isWritten = fwrite(region->data + entry.offset, 1, entry.compressedSize, file) == entry.compressedSize;
+        entry.offset = offset;
+        header->entries[i] = entry;
+        offset += entry.compressedSize;
+    }
+
+    isWritten = isWritten
+        && fseek(file, 0, SEEK_SET) == 0
+        && fwrite(header, sizeof(RegionHeader), 1, file) == 1
+        && syncFile(file);
+
+    free(header);
+    fclose(file);
+    closeRegionFile(regionX, regionZ);
+
+    if (!isWritten) {
+        remove(temporaryPath);
+        return;
+    }
+
+    if (replaceFile(temporaryPath, path)) {
+        regionStats.compactedRegions++;
+    }
+}
+
+static void syncRegionFile(int regionX, int regionZ) {
+    char path[REGION_PATH_LENGTH];
+    getRegionPath(regionX, regionZ, "", path);
+    syncFileAtPath(path);
+}
+
+static void syncUnsyncedRegionFiles() {
+    for (int i = 0; i < unsyncedRegionCount; i++) {
+        syncRegionFile(unsyncedRegions[i].x, unsyncedRegions[i].z);
+    }
+
+    unsyncedRegionCount = 0;
+}
+
+void syncRegionFiles() {
+    lockRegionFiles();
+    syncUnsyncedRegionFiles();
+    unlockRegionFiles();
+}
+
+static void markRegionUnsynced(int regionX, int regionZ) {
+    for (int i = 0; i < unsyncedRegionCount; i++) {
+        if (unsyncedRegions[i].x == regionX && unsyncedRegions[i].z == regionZ) {
+            return;
+        }
+    }
+
+    if (unsyncedRegionCount == REGION_UNSYNCED_CAPACITY) {
+        syncUnsyncedRegionFiles();
+    }
+
+    IntVector3 region = { .x = regionX, .y = 0, .z = regionZ };
+    unsyncedRegions[unsyncedRegionCount++] = region;
+}
+
+static bool writeColumnPayload(int columnX, int columnZ, const uint8_t* raw, size_t rawSize, uint64_t journalSequence) {
+    int regionX = columnX >> REGION_SHIFT;
+    int regionZ = columnZ >> REGION_SHIFT;
+
+    uint8_t* payload = malloc(rawSize + rawSize / 128 + 1);
+    size_t payloadSize = compressPayload(raw, rawSize, payload);
+
+    RegionEntry entry = {
+        .offset = 0,
+        .compressedSize = (uint32_t)payloadSize,
+        .rawSize = (uint32_t)rawSize,
+        .checksum = getChecksum(payload, payloadSize),
+        .journalSequence = journalSequence
+    };
+
+    lockRegionFiles();
+    RegionFile* region = getRegionFile(regionX, regionZ);
+
+    if (region->writer == NULL) {
+        region->writer = openRegionFileForWriting(regionX, regionZ);
+    }
+
+    FILE* file = region->writer;
+
+    if (file == NULL) {
+        regionStats.failedSaves++;
+        unlockRegionFiles();
+        free(payload);
+        fprintf(stderr, "Failed to open region for column %d, %d\n", columnX, columnZ);
+        return false;
+    }
+
+    bool isWritten = fseek(file, 0, SEEK_END) == 0;
+    long end = ftell(file);
+    entry.offset = (uint32_t)end;
+
+    isWritten = isWritten && end >= (long)sizeof(RegionHeader)
+        && fwrite(payload, 1, payloadSize, file) == payloadSize
+        && fseek(file, (long)(offsetof(RegionHeader, entries) + getRegionColumnIndex(columnX, columnZ) * sizeof(RegionEntry)), SEEK_SET) == 0
+        && fwrite(&entry, sizeof(RegionEntry), 1, file) == 1
+        && fflush(file) == 0;
+
+    free(payload);
+
+    if (!isWritten) {
+        releaseRegionFile(region);
+        regionStats.failedSaves++;
+        unlockRegionFiles();
+        fprintf(stderr, "Failed to save column %d, %d\n", columnX, columnZ);
+        return false;
+    }
+
+    growRegionMapping(region, (size_t)end + payloadSize);
+    regionStats.savedColumns++;
+    markRegionUnsynced(regionX, regionZ);
+    compactRegionFile(regionX, regionZ);
+    unlockRegionFiles();
+
+    return true;
+}
+
+bool saveChunkColumn(ChunkColumn* column) {
+    uint8_t* raw = malloc(getMaxColumnPayloadSize());
+    size_t rawSize = writeChunkColumn(column, raw);
+    uint64_t journalSequence = getJournalStats().nextSequence - 1;
+    bool isSaved = writeColumnPayload(column->x, column->z, raw, rawSize, journalSequence);
+    free(raw);
+
+    if (isSaved) {
+        column->isModified = false;
+        column->journalSequence = journalSequence;
+    }
+
+    return isSaved;
+}
+
+static void runSaveJob(void* context) {
+    SaveJob* job = context;
+    job->isSaved = writeColumnPayload(job->x, job->z, job->raw, job->rawSize, job->journalSequence);
+}
+
+static void finishSaveJob(SaveJob* job) {
+    waitForWorkerGroup(&job->group);
+
+    ChunkColumn* column = getChunkColumnAt(job->world, job->x, job->z);
+
+    if (job->isSaved && column != NULL && column->revision == job->revision) {
+        column->isModified = false;
+        column->journalSequence = job->journalSequence;
+    }
+
+    free(job->raw);
+    job->raw = NULL;
+    job->inUse = false;
+}
+
+static SaveJob* getFreeSaveJob() {
+    SaveJob* oldest = NULL;
+
+    for (int i = 0; i < MAX_PENDING_SAVES; i++) {
+        SaveJob* job = &saveJobs[i];
+
+        if (job->inUse && isWorkerGroupDone(&job->group)) {
+            finishSaveJob(job);
+        }
+
+        if (!job->inUse) {
+            return job;
+        }
+
+        if (oldest == NULL || job->submitOrder < oldest->submitOrder) {
+            oldest = job;
+        }
+    }
+
+    finishSaveJob(oldest);
+    return oldest;
+}
+
+void queueChunkColumnSave(WorldState* ws, ChunkColumn* column) {
+    for (int i = 0; i < MAX_PENDING_SAVES; i++) {
+        if (saveJobs[i].inUse && saveJobs[i].x == column->x && saveJobs[i].z == column->z) {
+            finishSaveJob(&saveJobs[i]);
+        }
+    }
+
+    SaveJob* job = getFreeSaveJob();
+
+    job->x = column->x;
+    job->z = column->z;
+    job->raw = malloc(getMaxColumnPayloadSize());
+    job->rawSize = writeChunkColumn(column, job->raw);
+    job->journalSequence = getJournalStats().nextSequence - 1;
+    job->world = ws;
+    job->revision = column->revision;
+    job->submitOrder = ++saveSubmitCounter;
+    job->group.pending = 0;
+    job->isSaved = false;
+    job->inUse = true;
+
+    submitWorkerTask(&job->group, runSaveJob, job);
+}
+
+bool isChunkColumnSaving(int columnX, int columnZ) {
+    for (int i = 0; i < MAX_PENDING_SAVES; i++) {
+        SaveJob* job = &saveJobs[i];
+
+        if (!job->inUse || job->x != columnX || job->z != columnZ) {
+            continue;
+        }
+
+        if (!isWorkerGroupDone(&job->group)) {
+            return true;
+        }
+
+        finishSaveJob(job);
+    }
+
+    return false;
+}
+
+bool hasPendingChunkColumnSaves() {
+    bool isPending = false;
+
+    for (int i = 0; i < MAX_PENDING_SAVES; i++) {
+        SaveJob* job = &saveJobs[i];
+
+        if (!job->inUse) {
+            continue;
+        }
+
+        if (isWorkerGroupDone(&job->group)) {
+            finishSaveJob(job);
+        } else {
+            isPending = true;
+        }
+    }
+
+    return isPending;
+}
+
+void finishChunkColumnSaves() {
+    for (int i = 0; i < MAX_PENDING_SAVES; i++) {
+        if (saveJobs[i].inUse) {
+            finishSaveJob(&saveJobs[i]);
+        }
+    }
+}
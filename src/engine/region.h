@@ -0,0 +1,31 @@
+#ifndef BLOCKS_REGION
+#define BLOCKS_REGION
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "world.h"
+
+#define REGION_DIRECTORY "world"
+#define REGION_SHIFT 5
+#define REGION_SIZE (1 << REGION_SHIFT)
+#define REGION_COLUMN_COUNT (REGION_SIZE * REGION_SIZE)
+
+typedef struct RegionStats {
+	int loadedColumns;
+	int savedColumns;
+	int compactedRegions;
+	int failedSaves;
+	size_t loadedBytes;
+} RegionStats;
+
+bool loadChunkColumn(ChunkColumn* column);
+bool saveChunkColumn(ChunkColumn* column);
+void queueChunkColumnSave(WorldState* worldState, ChunkColumn* column);
+bool isChunkColumnSaving(int columnX, int columnZ);
+bool hasPendingChunkColumnSaves();
+void finishChunkColumnSaves();
+void syncRegionFiles();
+void closeRegionFiles();
+RegionStats getRegionStats();
+
+#endif
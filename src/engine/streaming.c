@@ -0,0 +1,203 @@
+#include "streaming.h"
+#include "world.h"
+#include "visibility.h"
+#include "workers.h"
+#include "chunkmap.h"
+#include "region.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#define MAX_STREAMING_JOBS 64
+
+typedef struct StreamingJob {
+    ChunkColumn column;
+    WorkerGroup group;
+    bool inUse;
+} StreamingJob;
+
+static StreamingConfig streamingConfig = {
+    .loadRadius = 3,
+    .unloadRadius = 4,
+    .maxPendingChunks = 8,
+    .maxIntegratedChunksPerFrame = 4
+};
+
+static StreamingStats streamingStats = {
+    .residentChunks = 0,
+    .pendingChunks = 0,
+    .evictedChunks = 0,
+    .discardedChunks = 0,
+    .elidedSections = 0
+};
+
+static StreamingJob jobs[MAX_STREAMING_JOBS];
+static ChunkMap pendingChunks = { .entries = NULL, .capacity = 0, .count = 0 };
+
+StreamingConfig getChunkStreamingConfig() {
+    return streamingConfig;
+}
+
+void setChunkStreamingConfig(StreamingConfig config) {
+    if (config.unloadRadius < config.loadRadius) {
+        config.unloadRadius = config.loadRadius;
+    }
+
+    if (config.maxPendingChunks > MAX_STREAMING_JOBS) {
+        config.maxPendingChunks = MAX_STREAMING_JOBS;
+    }
+
+    streamingConfig = config;
+}
+
+StreamingStats getChunkStreamingStats() {
+    return streamingStats;
+}
+
+double getViewDistance() {
+    double viewDistance = (streamingConfig.loadRadius + 1) * CHUNK_SIZE * 1.5;
+    return viewDistance > MIN_VIEW_DISTANCE ? viewDistance : MIN_VIEW_DISTANCE;
+}
+
+static void loadStreamingJob(void* context) {
+    StreamingJob* job = context;
+
+    if (!loadChunkColumn(&job->column)) {
+        generateChunkColumn(&job->column);
+    }
+}
+
+static int getColumnDistance(int columnX, int columnZ, int centerX, int centerZ) {
+    int distanceX = abs(columnX - centerX);
+    int distanceZ = abs(columnZ - centerZ);
+
+    return distanceX > distanceZ ? distanceX : distanceZ;
+}
+
+static void integrateFinishedJobs(WorldState* ws, int centerX, int centerZ) {
+    int integratedCount = 0;
+
+    for (int i = 0; i < MAX_STREAMING_JOBS && integratedCount < streamingConfig.maxIntegratedChunksPerFrame; i++) {
+        StreamingJob* job = &jobs[i];
+
+        if (!job->inUse || !isWorkerGroupDone(&job->group)) {
+            continue;
+        }
+
+        IntVector3 key = { .x = job->column.x, .y = 0, .z = job->column.z };
+        chunkMapRemove(&pendingChunks, key);
+        job->inUse = false;
+
+        if (getColumnDistance(key.x, key.z, centerX, centerZ) > streamingConfig.unloadRadius
+            || getChunkColumnAt(ws, key.x, key.z) != NULL) {
+            freeChunkColumn(&job->column);
+            streamingStats.discardedChunks++;
+            continue;
+        }
+
+        addChunkColumn(ws, &job->column);
+        updateChunkColumnNeighborhoodVisibility(ws, key.x, key.z);
+        integratedCount++;
+    }
+}
+
+static void evictDistantChunks(WorldState* ws, int centerX, int centerZ) {
+    for (int i = ws->columnCount - 1; i >= 0; i--) {
+        int columnX = ws->columns[i].x;
+        int columnZ = ws->columns[i].z;
+
+        if (getColumnDistance(columnX, columnZ, centerX, centerZ) > streamingConfig.unloadRadius) {
+            if (ws->columns[i].isModified) {
+                queueChunkColumnSave(ws, &ws->columns[i]);
+            }
+
+            removeChunkColumn(ws, columnX, columnZ);
+            updateChunkColumnNeighborhoodVisibility(ws, columnX, columnZ);
+            streamingStats.evictedChunks++;
+        }
+    }
+}
+
+static bool scheduleColumn(WorldState* ws, IntVector3 key) {
+    if (getChunkColumnAt(ws, key.x, key.z) != NULL
+        || chunkMapGet(&pendingChunks, key) != CHUNK_MAP_EMPTY
+        || isChunkColumnSaving(key.x, key.z)) {
+        return true;
+    }
+
+    if (pendingChunks.count >= streamingConfig.maxPendingChunks) {
+        return false;
+    }
+
+    for (int i = 0; i < MAX_STREAMING_JOBS; i++) {
+        StreamingJob* job = &jobs[i];
+
+        if (job->inUse) {
+            continue;
+        }
+
+        memset(&job->column, 0, sizeof(ChunkColumn));
+        job->column.x = key.x;
+        job->column.z = key.z;
+        job->group.pending = 0;
+        job->inUse = true;
+
+        chunkMapPut(&pendingChunks, key, i);
+        submitWorkerTask(&job->group, loadStreamingJob, job);
+        return true;
+    }
+
+    return false;
+}
+
+static void scheduleMissingColumns(WorldState* ws, int centerX, int centerZ) {
+    for (int ring = 0; ring <= streamingConfig.loadRadius; ring++) {
+        for (int dx = -ring; dx <= ring; dx++) {
+            for (int dz = -ring; dz <= ring; dz++) {
+                if (abs(dx) != ring && abs(dz) != ring) {
+                    continue;
+                }
+
+                IntVector3 key = { .x = centerX + dx, .y = 0, .z = centerZ + dz };
+
+                if (!scheduleColumn(ws, key)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void updateChunkStreaming(Vector3 position) {
+    WorldState* ws = getWorldStateGlobal();
+    int centerX = (int)floor(position.x) >> CHUNK_SHIFT;
+    int centerZ = (int)floor(position.z) >> CHUNK_SHIFT;
+
+    if (pendingChunks.entries == NULL) {
+        initChunkMap(&pendingChunks, MAX_STREAMING_JOBS);
+    }
+
+    integrateFinishedJobs(ws, centerX, centerZ);
+    evictDistantChunks(ws, centerX, centerZ);
+    scheduleMissingColumns(ws, centerX, centerZ);
+
+    streamingStats.residentChunks = ws->columnCount;
+    streamingStats.pendingChunks = pendingChunks.count;
+    streamingStats.elidedSections = ws->elidedSectionCount;
+}
+
+void finishChunkStreaming() {
+    for (int i = 0; i < MAX_STREAMING_JOBS; i++) {
+        if (jobs[i].inUse) {
+            waitForWorkerGroup(&jobs[i].group);
+            freeChunkColumn(&jobs[i].column);
+            jobs[i].inUse = false;
+        }
+    }
+
+    finishChunkColumnSaves();
+    freeChunkMap(&pendingChunks);
+    streamingStats.pendingChunks = 0;
+}
@@ -0,0 +1,31 @@
+#ifndef BLOCKS_STREAMING
+#define BLOCKS_STREAMING
+
+#include "types.h"
+
+#define MIN_VIEW_DISTANCE 100.0
+
+typedef struct StreamingConfig {
+	int loadRadius;
+	int unloadRadius;
+	int maxPendingChunks;
+	int maxIntegratedChunksPerFrame;
+} StreamingConfig;
+
+typedef struct StreamingStats {
+	int residentChunks;
+	int pendingChunks;
+	int evictedChunks;
+	int discardedChunks;
+	int elidedSections;
+} StreamingStats;
+
+StreamingConfig getChunkStreamingConfig();
+void setChunkStreamingConfig(StreamingConfig config);
+StreamingStats getChunkStreamingStats();
+double getViewDistance();
+
+void updateChunkStreaming(Vector3 position);
+void finishChunkStreaming();
+
+#endif
@@ -7,6 +7,12 @@ typedef struct Vector3 {
 	double z;
 } Vector3;
 
+typedef struct IntVector3 {
+	int x;
+	int y;
+	int z;
+} IntVector3;
+
 typedef struct RelativeVector3 {
 	double forward;
 	double upward;
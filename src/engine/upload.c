@@ -0,0 +1,293 @@
+#include "upload.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include <GL/glew.h>
+#include <GL/gl.h>
+#endif
+
+#define UPLOAD_REGION_SIZE (UPLOAD_RING_SIZE / UPLOAD_FRAME_COUNT)
+#define UPLOAD_FENCE_TIMEOUT 1000000000ull
+
+typedef struct GeometryRange {
+    int offset;
+    int size;
+} GeometryRange;
+
+static GLuint ringBufferId = 0;
+static GLubyte* ringMapping = NULL;
+static GLsync regionFences[UPLOAD_FRAME_COUNT];
+static int currentRegion = 0;
+static int regionUsedBytes = 0;
+static bool isRegionReady = false;
+
+static GLuint arenaBufferId = 0;
+static GeometryRange* freeRanges = NULL;
+static int freeRangeCount = 0;
+static int freeRangeCapacity = 0;
+
+static UploadStats uploadStats = {
+    .frameUploadedBytes = 0,
+    .totalUploadedBytes = 0,
+    .fenceWaits = 0,
+    .fallbackUploads = 0,
+    .arenaBytes = 0,
+    .arenaUsedBytes = 0,
+    .arenaGrowths = 0,
+    .allocationCount = 0,
+    .isPersistentMapped = false
+};
+
+UploadStats getUploadStats() {
+    return uploadStats;
+}
+
+GLuint getGeometryBuffer() {
+    return arenaBufferId;
+}
+
+static void insertFreeRange(int index, int offset, int size) {
+    if (freeRangeCount == freeRangeCapacity) {
+        freeRangeCapacity = freeRangeCapacity == 0 ? 64 : freeRangeCapacity * 2;
+        freeRanges = realloc(freeRanges, freeRangeCapacity * sizeof(GeometryRange));
+    }
+
+    memmove(&freeRanges[index + 1], &freeRanges[index], (freeRangeCount - index) * sizeof(GeometryRange));
+    freeRanges[index].offset = offset;
+    freeRanges[index].size = size;
+    freeRangeCount++;
+}
+
+static void removeFreeRange(int index) {
+    memmove(&freeRanges[index], &freeRanges[index + 1], (freeRangeCount - index - 1) * sizeof(GeometryRange));
+    freeRangeCount--;
+}
+
+static void releaseRange(int offset, int size) {
+    int index = 0;
+
+    while (index < freeRangeCount && freeRanges[index].offset < offset) {
+        index++;
+    }
+
+    bool mergesPrevious = index > 0 && freeRanges[index - 1].offset + freeRanges[index - 1].size == offset;
+    bool mergesNext = index < freeRangeCount && offset + size == freeRanges[index].offset;
+
+    if (mergesPrevious && mergesNext) {
+        freeRanges[index - 1].size += size + freeRanges[index].size;
+        removeFreeRange(index);
+    } else if (mergesPrevious) {
+        freeRanges[index - 1].size += size;
+    } else if (mergesNext) {
+        freeRanges[index].offset = offset;
+        freeRanges[index].size += size;
+    } else {
+        insertFreeRange(index, offset, size);
+    }
+}
+
+static void growGeometryArena(int requiredSize) {
+    int oldSize = uploadStats.arenaBytes;
+    int newSize = oldSize * 2;
+
+    while (newSize - oldSize < requiredSize) {
+        newSize *= 2;
+    }
+
+    GLuint newBufferId;
+    glGenBuffers(1, &newBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBufferId);
+    glBufferData(GL_COPY_WRITE_BUFFER, newSize, NULL, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, arenaBufferId);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldSize);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glDeleteBuffers(1, &arenaBufferId);
+
+    arenaBufferId = newBufferId;
+    uploadStats.arenaBytes = newSize;
+    uploadStats.arenaGrowths++;
+    releaseRange(oldSize, newSize - oldSize);
+}
+
+int allocateGeometry(int size) {
+    if (size <= 0) {
+        return GEOMETRY_NONE;
+    }
+
+    size = (size + GEOMETRY_ALIGNMENT - 1) & ~(GEOMETRY_ALIGNMENT - 1);
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        for (int i = 0; i < freeRangeCount; i++) {
+            if (freeRanges[i].size < size) {
+                continue;
+            }
+
+            int offset = freeRanges[i].offset;
+            freeRanges[i].offset += size;
+            freeRanges[i].size -= size;
+
+            if (freeRanges[i].size == 0) {
+                removeFreeRange(i);
+            }
+
+            uploadStats.arenaUsedBytes += size;
+            uploadStats.allocationCount++;
+            return offset;
+        }
+
+        growGeometryArena(size);
+    }
+
+    return GEOMETRY_NONE;
+}
+
+void freeGeometry(int offset, int size) {
+    if (offset == GEOMETRY_NONE || size <= 0) {
+        return;
+    }
+
+    size = (size + GEOMETRY_ALIGNMENT - 1) & ~(GEOMETRY_ALIGNMENT - 1);
+    releaseRange(offset, size);
+
+    uploadStats.arenaUsedBytes -= size;
+    uploadStats.allocationCount--;
+}
+
+static void waitForRegion(int region) {
+    if (regionFences[region] == NULL) {
+        return;
+    }
+
+    GLenum status = glClientWaitSync(regionFences[region], 0, 0);
+
+    if (status == GL_TIMEOUT_EXPIRED) {
+        uploadStats.fenceWaits++;
+
+        do {
+            status = glClientWaitSync(regionFences[region], GL_SYNC_FLUSH_COMMANDS_BIT, UPLOAD_FENCE_TIMEOUT);
+        } while (status == GL_TIMEOUT_EXPIRED);
+    }
+
+    glDeleteSync(regionFences[region]);
+    regionFences[region] = NULL;
+}
+
+void uploadGeometry(int offset, const void* data, int size) {
+    if (offset == GEOMETRY_NONE || size <= 0) {
+        return;
+    }
+
+    uploadStats.frameUploadedBytes += size;
+    uploadStats.totalUploadedBytes += size;
+
+    if (ringMapping == NULL || regionUsedBytes + size > UPLOAD_REGION_SIZE) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, arenaBufferId);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        uploadStats.fallbackUploads += ringMapping != NULL;
+        return;
+    }
+
+    if (!isRegionReady) {
+        waitForRegion(currentRegion);
+        isRegionReady = true;
+    }
+
+    int ringOffset = currentRegion * UPLOAD_REGION_SIZE + regionUsedBytes;
+    memcpy(ringMapping + ringOffset, data, size);
+    regionUsedBytes += (size + GEOMETRY_ALIGNMENT - 1) & ~(GEOMETRY_ALIGNMENT - 1);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, ringBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, arenaBufferId);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, ringOffset, offset, size);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void beginUploadFrame() {
+    uploadStats.frameUploadedBytes = 0;
+    regionUsedBytes = 0;
+    isRegionReady = false;
+}
+
+void endUploadFrame() {
+    if (ringMapping != NULL && regionUsedBytes > 0) {
+        regionFences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    currentRegion = (currentRegion + 1) % UPLOAD_FRAME_COUNT;
+}
+
+static void initUploadRing() {
+#if !defined(__APPLE__)
+    if (!GLEW_VERSION_4_4 && !GLEW_ARB_buffer_storage) {
+        return;
+    }
+
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1, &ringBufferId);
+    glBindBuffer(GL_COPY_READ_BUFFER, ringBufferId);
+    glBufferStorage(GL_COPY_READ_BUFFER, UPLOAD_RING_SIZE, NULL, flags);
+    ringMapping = glMapBufferRange(GL_COPY_READ_BUFFER, 0, UPLOAD_RING_SIZE, flags);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    if (ringMapping == NULL) {
+        fprintf(stderr, "Persistent upload buffer mapping failed, using glBufferSubData\n");
+        glDeleteBuffers(1, &ringBufferId);
+        ringBufferId = 0;
+    }
+#endif
+
+    uploadStats.isPersistentMapped = ringMapping != NULL;
+}
+
+bool initUploads() {
+    glGenBuffers(1, &arenaBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, arenaBufferId);
+    glBufferData(GL_COPY_WRITE_BUFFER, GEOMETRY_ARENA_INITIAL_SIZE, NULL, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    uploadStats.arenaBytes = GEOMETRY_ARENA_INITIAL_SIZE;
+    releaseRange(0, GEOMETRY_ARENA_INITIAL_SIZE);
+
+    initUploadRing();
+    return arenaBufferId != 0;
+}
+
+void freeUploads() {
+    for (int i = 0; i < UPLOAD_FRAME_COUNT; i++) {
+        if (regionFences[i] != NULL) {
+            glDeleteSync(regionFences[i]);
+            regionFences[i] = NULL;
+        }
+    }
+
+    if (ringBufferId != 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, ringBufferId);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &ringBufferId);
+        ringBufferId = 0;
+        ringMapping = NULL;
+    }
+
+    glDeleteBuffers(1, &arenaBufferId);
+    arenaBufferId = 0;
+
+    free(freeRanges);
+    freeRanges = NULL;
+    freeRangeCount = 0;
+    freeRangeCapacity = 0;
+}
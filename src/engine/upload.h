@@ -0,0 +1,41 @@
+#ifndef BLOCKS_UPLOAD
+#define BLOCKS_UPLOAD
+
+#include <stdbool.h>
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#define UPLOAD_FRAME_COUNT 3
+#define UPLOAD_RING_SIZE (6 * 1024 * 1024)
+#define GEOMETRY_ARENA_INITIAL_SIZE (16 * 1024 * 1024)
+#define GEOMETRY_ALIGNMENT 256
+#define GEOMETRY_NONE -1
+
+typedef struct UploadStats {
+	int frameUploadedBytes;
+	long long totalUploadedBytes;
+	int fenceWaits;
+	int fallbackUploads;
+	int arenaBytes;
+	int arenaUsedBytes;
+	int arenaGrowths;
+	int allocationCount;
+	bool isPersistentMapped;
+} UploadStats;
+
+bool initUploads();
+void freeUploads();
+void beginUploadFrame();
+void endUploadFrame();
+
+int allocateGeometry(int size);
+void freeGeometry(int offset, int size);
+void uploadGeometry(int offset, const void* data, int size);
+GLuint getGeometryBuffer();
+
+UploadStats getUploadStats();
+
+#endif
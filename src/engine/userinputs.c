@@ -4,6 +4,11 @@
 #include "gametime.h"
 #include "world.h"
 #include "player.h"
+#include "occlusion.h"
+#include "connectivity.h"
+#include "meshworkers.h"
+#include "visibleset.h"
+#include "bulkedit.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -88,6 +93,26 @@ void processKeyboardButtonActions(GLFWwindow* window, int key, int scancode, int
             }
         }
 
+        if (key == GLFW_KEY_F3) {
+            setRenderMode((RenderMode)((getRenderMode() + 1) % RENDER_MODE_COUNT));
+        }
+
+        if (key == GLFW_KEY_F4) {
+            setOcclusionEnabled(!isOcclusionEnabled());
+        }
+
+        if (key == GLFW_KEY_F5) {
+            setCaveCullingEnabled(!isCaveCullingEnabled());
+        }
+
+        if (key == GLFW_KEY_F6) {
+            setMeshWorkersEnabled(!isMeshWorkersEnabled());
+        }
+
+        if (key == GLFW_KEY_F7) {
+            setVisibleSetCacheEnabled(!isVisibleSetCacheEnabled());
+        }
+
         if (key == GLFW_KEY_ESCAPE) {
             glfwSetWindowShouldClose(window, GL_TRUE);
         }
@@ -99,13 +124,16 @@ void processMouseButtonActions(GLFWwindow* window, int button, int action, int m
         PlayerState ps = getPlayerState();
 
         if (button == GLFW_MOUSE_BUTTON_LEFT) {
-            if (ps.isLookingAtBlock && ps.lookingAtBlock != NULL) {
-                destroyBlock(getWorldStateGlobal(), (int)ps.lookingAtBlock->x, (int)ps.lookingAtBlock->y, (int)ps.lookingAtBlock->z);
+            if (ps.isLookingAtBlock) {
+                destroyBlock(getWorldStateGlobal(), (int)ps.lookingAtBlock.x, (int)ps.lookingAtBlock.y, (int)ps.lookingAtBlock.z);
+            }
+        } else if (button == GLFW_MOUSE_BUTTON_MIDDLE) {
+            if (ps.isLookingAtBlock) {
+                carveSphere(getWorldStateGlobal(), ps.lookingAtBlock, CARVE_SPHERE_RADIUS);
             }
         } else if (button == GLFW_MOUSE_BUTTON_RIGHT) {
-            if (ps.isLookingAtBlock && ps.lookingAtBlock != NULL) {
-                GameElement* targetBlock = getBlockAtGlobal(getWorldStateGlobal(), (int)ps.lookingAtBlock->x, (int)ps.lookingAtBlock->y, (int)ps.lookingAtBlock->z);
-                if (targetBlock == NULL || targetBlock->elementType == 0) {
+            if (ps.isLookingAtBlock) {
+                if (getBlockTypeAtGlobal(getWorldStateGlobal(), (int)ps.lookingAtBlock.x, (int)ps.lookingAtBlock.y, (int)ps.lookingAtBlock.z) == 0) {
                     return;
                 }
 
@@ -114,9 +142,9 @@ void processMouseButtonActions(GLFWwindow* window, int button, int action, int m
                     return;
                 }
 
-                int targetX = (int)ps.lookingAtBlock->x;
-                int targetY = (int)ps.lookingAtBlock->y;
-                int targetZ = (int)ps.lookingAtBlock->z;
+                int targetX = (int)ps.lookingAtBlock.x;
+                int targetY = (int)ps.lookingAtBlock.y;
+                int targetZ = (int)ps.lookingAtBlock.z;
 
                 int newBlockX = targetX;
                 int newBlockY = targetY;
@@ -2,6 +2,9 @@
 #define BLOCKS_USERINPUTS
 
 #include <stdbool.h>
+#if defined(__APPLE__)
+#define GLFW_INCLUDE_GLCOREARB
+#endif
 #include <GLFW/glfw3.h>
 
 typedef struct InputState {
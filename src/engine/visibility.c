@@ -0,0 +1,275 @@
+#include "visibility.h"
+#include "constants.h"
+
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define popcount16(value) ((int)__popcnt16(value))
+static int ctz16(uint16_t value) { unsigned long index; _BitScanForward(&index, value); return (int)index; }
+static int clz16(uint16_t value) { unsigned long index; _BitScanReverse(&index, value); return 15 - (int)index; }
+#else
+#define popcount16(value) __builtin_popcount(value)
+#define ctz16(value) __builtin_ctz(value)
+#define clz16(value) (__builtin_clz(value) - 16)
+#endif
+
+#define FULL_ROWS_4 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF
+#define FULL_ROWS_16 FULL_ROWS_4, FULL_ROWS_4, FULL_ROWS_4, FULL_ROWS_4
+#define FULL_ROWS_64 FULL_ROWS_16, FULL_ROWS_16, FULL_ROWS_16, FULL_ROWS_16
+#define FULL_ROWS_256 FULL_ROWS_64, FULL_ROWS_64, FULL_ROWS_64, FULL_ROWS_64
+
+static const uint16_t emptyRows[CHUNK_ROW_COUNT] = { 0 };
+static const uint16_t fullRows[CHUNK_ROW_COUNT] = { FULL_ROWS_256 };
+
+static const uint16_t* getChunkSolidRows(const Chunk* chunk) {
+    if (chunk == NULL || chunk->uniformType == 0) {
+        return emptyRows;
+    }
+
+    if (chunk->uniformType != CHUNK_MIXED) {
+        return fullRows;
+    }
+
+    return chunk->solidRows;
+}
+
+void setChunkOccupancy(Chunk* chunk, int index, bool isSolid) {
+    uint16_t bit = (uint16_t)(1u << (index & CHUNK_MASK));
+
+    if (isSolid) {
+        chunk->solidRows[index >> CHUNK_SHIFT] |= bit;
+    } else {
+        chunk->solidRows[index >> CHUNK_SHIFT] &= (uint16_t)~bit;
+    }
+}
+
+bool isChunkOccupied(const Chunk* chunk, int index) {
+    return (getChunkSolidRows(chunk)[index >> CHUNK_SHIFT] >> (index & CHUNK_MASK)) & 1;
+}
+
+static void clearChunkVisibleFaces(Chunk* chunk) {
+    free(chunk->visibleFaces);
+    chunk->visibleFaces = NULL;
+    chunk->visibleFaceCount = 0;
+}
+
+static void updateChunkVisibleBounds(Chunk* chunk) {
+    IntVector3 visibleMin = { .x = CHUNK_MASK, .y = CHUNK_MASK, .z = CHUNK_MASK };
+    IntVector3 visibleMax = { .x = 0, .y = 0, .z = 0 };
+
+    for (int r = 0; r < CHUNK_ROW_COUNT; r++) {
+        uint16_t mask = getVisibleRowMask(chunk, r);
+
+        if (mask == 0) {
+            continue;
+        }
+
+        int y = r & CHUNK_MASK;
+        int z = r >> CHUNK_SHIFT;
+        int minX = ctz16(mask);
+        int maxX = CHUNK_MASK - clz16(mask);
+
+        visibleMin.x = minX < visibleMin.x ? minX : visibleMin.x;
+        visibleMax.x = maxX > visibleMax.x ? maxX : visibleMax.x;
+        visibleMin.y = y < visibleMin.y ? y : visibleMin.y;
+        visibleMax.y = y > visibleMax.y ? y : visibleMax.y;
+        visibleMin.z = z < visibleMin.z ? z : visibleMin.z;
+        visibleMax.z = z > visibleMax.z ? z : visibleMax.z;
+    }
+
+    chunk->visibleMin = visibleMin;
+    chunk->visibleMax = visibleMax;
+}
+
+void updateChunkVisibilitySlices(WorldState* worldState, Chunk* chunk, uint16_t slices) {
+    chunk->isMeshDirty = true;
+    chunk->isInstanceDirty = true;
+
+    if (chunk->uniformType == 0) {
+        clearChunkVisibleFaces(chunk);
+        return;
+    }
+
+    const uint16_t* rightRows = getChunkSolidRows(getChunkAt(worldState, chunk->position.x + 1, chunk->position.y, chunk->position.z));
+    const uint16_t* leftRows = getChunkSolidRows(getChunkAt(worldState, chunk->position.x - 1, chunk->position.y, chunk->position.z));
+    const uint16_t* topRows = getChunkSolidRows(getChunkAt(worldState, chunk->position.x, chunk->position.y + 1, chunk->position.z));
+    const uint16_t* bottomRows = getChunkSolidRows(getChunkAt(worldState, chunk->position.x, chunk->position.y - 1, chunk->position.z));
+    const uint16_t* frontRows = getChunkSolidRows(getChunkAt(worldState, chunk->position.x, chunk->position.y, chunk->position.z + 1));
+    const uint16_t* backRows = getChunkSolidRows(getChunkAt(worldState, chunk->position.x, chunk->position.y, chunk->position.z - 1));
+
+    const uint16_t* rows = getChunkSolidRows(chunk);
+
+    if (rows == fullRows && rightRows == fullRows && leftRows == fullRows
+        && topRows == fullRows && bottomRows == fullRows && frontRows == fullRows && backRows == fullRows) {
+        clearChunkVisibleFaces(chunk);
+        return;
+    }
+
+    if (chunk->visibleFaces == NULL) {
+        chunk->visibleFaces = calloc(BLOCK_FACE_COUNT * CHUNK_ROW_COUNT, sizeof(uint16_t));
+        chunk->visibleFaceCount = 0;
+    }
+
+    uint16_t (*visibleFaces)[CHUNK_ROW_COUNT] = chunk->visibleFaces;
+    int visibleFaceCount = chunk->visibleFaceCount;
+
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        if (((slices >> z) & 1) == 0) {
+            continue;
+        }
+
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            int r = y + z * CHUNK_SIZE;
+            uint16_t row = rows[r];
+
+            uint16_t rightRow = (uint16_t)((row >> 1) | ((rightRows[r] & 1u) << CHUNK_MASK));
+            uint16_t leftRow = (uint16_t)((row << 1) | (leftRows[r] >> CHUNK_MASK));
+            uint16_t topRow = y < CHUNK_MASK ? rows[r + 1] : topRows[z * CHUNK_SIZE];
+            uint16_t bottomRow = y > 0 ? rows[r - 1] : bottomRows[CHUNK_MASK + z * CHUNK_SIZE];
+            uint16_t frontRow = z < CHUNK_MASK ? rows[r + CHUNK_SIZE] : frontRows[y];
+            uint16_t backRow = z > 0 ? rows[r - CHUNK_SIZE] : backRows[y + CHUNK_MASK * CHUNK_SIZE];
+
+            for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+                visibleFaceCount -= popcount16(visibleFaces[face][r]);
+            }
+
+            visibleFaces[BLOCK_FACE_TOP][r] = row & (uint16_t)~topRow;
+            visibleFaces[BLOCK_FACE_BOTTOM][r] = row & (uint16_t)~bottomRow;
+            visibleFaces[BLOCK_FACE_FRONT][r] = row & (uint16_t)~frontRow;
+            visibleFaces[BLOCK_FACE_BACK][r] = row & (uint16_t)~backRow;
+            visibleFaces[BLOCK_FACE_RIGHT][r] = row & (uint16_t)~rightRow;
+            visibleFaces[BLOCK_FACE_LEFT][r] = row & (uint16_t)~leftRow;
+
+            for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+                visibleFaceCount += popcount16(visibleFaces[face][r]);
+            }
+        }
+    }
+
+    if (visibleFaceCount == 0) {
+        clearChunkVisibleFaces(chunk);
+        return;
+    }
+
+    chunk->visibleFaceCount = visibleFaceCount;
+    updateChunkVisibleBounds(chunk);
+}
+
+void updateChunkVisibility(WorldState* worldState, Chunk* chunk) {
+    updateChunkVisibilitySlices(worldState, chunk, 0xFFFF);
+}
+
+static void updateChunkVisibilityEdge(WorldState* worldState, Chunk* chunk, int face) {
+    if (chunk->uniformType == 0) {
+        return;
+    }
+
+    if (chunk->visibleFaces == NULL) {
+        updateChunkVisibility(worldState, chunk);
+        return;
+    }
+
+    int neighborX = chunk->position.x + (face == BLOCK_FACE_RIGHT ? 1 : -1);
+    const uint16_t* neighborRows = getChunkSolidRows(getChunkAt(worldState, neighborX, chunk->position.y, chunk->position.z));
+    const uint16_t* rows = getChunkSolidRows(chunk);
+    uint16_t* visibleRows = chunk->visibleFaces[face];
+    int visibleFaceCount = chunk->visibleFaceCount;
+    bool isChanged = false;
+
+    for (int r = 0; r < CHUNK_ROW_COUNT; r++) {
+        uint16_t edge = face == BLOCK_FACE_RIGHT ? (uint16_t)(1u << CHUNK_MASK) : 1;
+        uint16_t neighborEdge = face == BLOCK_FACE_RIGHT
+            ? (uint16_t)((neighborRows[r] & 1u) << CHUNK_MASK)
+            : (uint16_t)(neighborRows[r] >> CHUNK_MASK);
+        uint16_t visibleRow = (uint16_t)((visibleRows[r] & ~edge) | (rows[r] & edge & ~neighborEdge));
+
+        if (visibleRow != visibleRows[r]) {
+            visibleFaceCount += popcount16(visibleRow) - popcount16(visibleRows[r]);
+            visibleRows[r] = visibleRow;
+            isChanged = true;
+        }
+    }
+
+    if (!isChanged) {
+        return;
+    }
+
+    chunk->isMeshDirty = true;
+    chunk->isInstanceDirty = true;
+
+    if (visibleFaceCount == 0) {
+        clearChunkVisibleFaces(chunk);
+        return;
+    }
+
+    chunk->visibleFaceCount = visibleFaceCount;
+    updateChunkVisibleBounds(chunk);
+}
+
+static void updateChunkColumnBorderVisibility(WorldState* worldState, ChunkColumn* column, int face) {
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        Chunk* chunk = &column->sections[section];
+
+        if (face == BLOCK_FACE_FRONT) {
+            updateChunkVisibilitySlices(worldState, chunk, (uint16_t)(1u << CHUNK_MASK));
+        } else if (face == BLOCK_FACE_BACK) {
+            updateChunkVisibilitySlices(worldState, chunk, 1);
+        } else {
+            updateChunkVisibilityEdge(worldState, chunk, face);
+        }
+    }
+}
+
+void updateChunkColumnNeighborhoodVisibility(WorldState* worldState, int columnX, int columnZ) {
+    int dx[] = {-1, 1, 0, 0};
+    int dz[] = {0, 0, -1, 1};
+    int faces[] = {BLOCK_FACE_RIGHT, BLOCK_FACE_LEFT, BLOCK_FACE_FRONT, BLOCK_FACE_BACK};
+    ChunkColumn* column = getChunkColumnAt(worldState, columnX, columnZ);
+
+    if (column != NULL) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            updateChunkVisibility(worldState, &column->sections[section]);
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        ChunkColumn* neighbor = getChunkColumnAt(worldState, columnX + dx[i], columnZ + dz[i]);
+
+        if (neighbor != NULL) {
+            updateChunkColumnBorderVisibility(worldState, neighbor, faces[i]);
+        }
+    }
+
+    worldState->revision++;
+}
+
+int getVisibleFaceMask(const Chunk* chunk, int index) {
+    if (chunk->visibleFaces == NULL) {
+        return 0;
+    }
+
+    int r = index >> CHUNK_SHIFT;
+    int bit = index & CHUNK_MASK;
+    int mask = 0;
+
+    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+        mask |= ((chunk->visibleFaces[face][r] >> bit) & 1) << face;
+    }
+
+    return mask;
+}
+
+uint16_t getVisibleRowMask(const Chunk* chunk, int row) {
+    uint16_t mask = 0;
+
+    if (chunk->visibleFaces == NULL) {
+        return mask;
+    }
+
+    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+        mask |= chunk->visibleFaces[face][row];
+    }
+
+    return mask;
+}
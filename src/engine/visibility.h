@@ -0,0 +1,18 @@
+#ifndef BLOCKS_VISIBILITY
+#define BLOCKS_VISIBILITY
+
+#include <stdbool.h>
+#include "world.h"
+
+#define CHUNK_ROW_COUNT (CHUNK_SIZE * CHUNK_SIZE)
+#define BLOCK_FACE_COUNT 6
+
+void setChunkOccupancy(Chunk* chunk, int index, bool isSolid);
+bool isChunkOccupied(const Chunk* chunk, int index);
+void updateChunkVisibility(WorldState* worldState, Chunk* chunk);
+void updateChunkVisibilitySlices(WorldState* worldState, Chunk* chunk, uint16_t slices);
+void updateChunkColumnNeighborhoodVisibility(WorldState* worldState, int columnX, int columnZ);
+int getVisibleFaceMask(const Chunk* chunk, int index);
+uint16_t getVisibleRowMask(const Chunk* chunk, int row);
+
+#endif
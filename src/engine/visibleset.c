@@ -0,0 +1,146 @@
+#include "visibleset.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+static VisibleChunk* visibleChunks = NULL;
+static int visibleChunkCount = 0;
+static int visibleChunkCapacity = 0;
+
+static Vector3 setPosition = { .x = 0.0, .y = 0.0, .z = 0.0 };
+static Vector3 setDirection = { .x = 0.0, .y = 0.0, .z = 0.0 };
+static double setHorizontalSpread = 0.0;
+static double setVerticalSpread = 0.0;
+static int setRevision = 0;
+static int setSettings = 0;
+static bool isSetValid = false;
+static bool isEnabled = true;
+
+static VisibleSetStats visibleSetStats = {
+    .rebuilds = 0,
+    .reuses = 0,
+    .visibleChunks = 0,
+    .isCached = false
+};
+
+VisibleSetStats getVisibleSetStats() {
+    return visibleSetStats;
+}
+
+bool isVisibleSetCacheEnabled() {
+    return isEnabled;
+}
+
+void setVisibleSetCacheEnabled(bool enabled) {
+    isEnabled = enabled;
+    isSetValid = false;
+}
+
+double getVisibleSetMargin(double viewDistance) {
+    return VISIBLE_SET_MOVE_THRESHOLD + 2.0 * viewDistance * sin(VISIBLE_SET_TURN_THRESHOLD * M_PI / 180.0);
+}
+
+static Vector3 normalizeDirection(Vector3 direction) {
+    double length = sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+
+    if (length > 0.0) {
+        direction.x /= length;
+        direction.y /= length;
+        direction.z /= length;
+    }
+
+    return direction;
+}
+
+static double getPlaneSpread(const Plane* first, const Plane* second) {
+    return first->x * second->x + first->y * second->y + first->z * second->z;
+}
+
+bool isVisibleSetCurrent(Vector3 position, Vector3 direction, const Frustum* frustum, int revision, int settings) {
+    visibleSetStats.isCached = false;
+
+    if (!isEnabled || !isSetValid || revision != setRevision || settings != setSettings) {
+        return false;
+    }
+
+    double dx = position.x - setPosition.x;
+    double dy = position.y - setPosition.y;
+    double dz = position.z - setPosition.z;
+
+    if (dx * dx + dy * dy + dz * dz > VISIBLE_SET_MOVE_THRESHOLD * VISIBLE_SET_MOVE_THRESHOLD) {
+        return false;
+    }
+
+    direction = normalizeDirection(direction);
+    double alignment = direction.x * setDirection.x + direction.y * setDirection.y + direction.z * setDirection.z;
+
+    if (alignment < cos(VISIBLE_SET_TURN_THRESHOLD * M_PI / 180.0)) {
+        return false;
+    }
+
+    if (fabs(getPlaneSpread(&frustum->planes[0], &frustum->planes[1]) - setHorizontalSpread) > 1e-4
+        || fabs(getPlaneSpread(&frustum->planes[2], &frustum->planes[3]) - setVerticalSpread) > 1e-4) {
+        return false;
+    }
+
+    visibleSetStats.reuses++;
+    visibleSetStats.isCached = true;
+    return true;
+}
+
+void beginVisibleSet(Vector3 position, Vector3 direction, const Frustum* frustum, int revision, int settings) {
+    setPosition = position;
+    setDirection = normalizeDirection(direction);
+    setHorizontalSpread = getPlaneSpread(&frustum->planes[0], &frustum->planes[1]);
+    setVerticalSpread = getPlaneSpread(&frustum->planes[2], &frustum->planes[3]);
+    setRevision = revision;
+    setSettings = settings;
+    isSetValid = true;
+
+    visibleChunkCount = 0;
+    visibleSetStats.rebuilds++;
+}
+
+void addVisibleChunk(Chunk* chunk, float distance, bool isInside) {
+    if (visibleChunkCount == visibleChunkCapacity) {
+        visibleChunkCapacity = visibleChunkCapacity == 0 ? 1024 : visibleChunkCapacity * 2;
+        visibleChunks = realloc(visibleChunks, visibleChunkCapacity * sizeof(VisibleChunk));
+    }
+
+    visibleChunks[visibleChunkCount].chunk = chunk;
+    visibleChunks[visibleChunkCount].distance = distance;
+    visibleChunks[visibleChunkCount].isInside = isInside;
+    visibleChunkCount++;
+}
+
+static int compareVisibleChunks(const void* a, const void* b) {
+    float first = ((const VisibleChunk*)a)->distance;
+    float second = ((const VisibleChunk*)b)->distance;
+    return (first > second) - (first < second);
+}
+
+void sortVisibleSet() {
+    qsort(visibleChunks, visibleChunkCount, sizeof(VisibleChunk), compareVisibleChunks);
+    visibleSetStats.visibleChunks = visibleChunkCount;
+}
+
+const VisibleChunk* getVisibleChunks(int* count) {
+    *count = visibleChunkCount;
+    return visibleChunks;
+}
+
+Vector3 getVisibleSetPosition() {
+    return setPosition;
+}
+
+void invalidateVisibleSet() {
+    isSetValid = false;
+}
+
+void freeVisibleSet() {
+    free(visibleChunks);
+    visibleChunks = NULL;
+    visibleChunkCount = 0;
+    visibleChunkCapacity = 0;
+    isSetValid = false;
+}
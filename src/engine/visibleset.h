@@ -0,0 +1,38 @@
+#ifndef BLOCKS_VISIBLESET
+#define BLOCKS_VISIBLESET
+
+#include <stdbool.h>
+#include "types.h"
+#include "world.h"
+#include "frustum.h"
+
+#define VISIBLE_SET_MOVE_THRESHOLD 0.05
+#define VISIBLE_SET_TURN_THRESHOLD 0.25
+
+typedef struct VisibleChunk {
+	Chunk* chunk;
+	float distance;
+	bool isInside;
+} VisibleChunk;
+
+typedef struct VisibleSetStats {
+	int rebuilds;
+	int reuses;
+	int visibleChunks;
+	bool isCached;
+} VisibleSetStats;
+
+bool isVisibleSetCacheEnabled();
+void setVisibleSetCacheEnabled(bool isEnabled);
+double getVisibleSetMargin(double viewDistance);
+bool isVisibleSetCurrent(Vector3 position, Vector3 direction, const Frustum* frustum, int revision, int settings);
+void beginVisibleSet(Vector3 position, Vector3 direction, const Frustum* frustum, int revision, int settings);
+void addVisibleChunk(Chunk* chunk, float distance, bool isInside);
+void sortVisibleSet();
+const VisibleChunk* getVisibleChunks(int* count);
+Vector3 getVisibleSetPosition();
+void invalidateVisibleSet();
+VisibleSetStats getVisibleSetStats();
+void freeVisibleSet();
+
+#endif
@@ -1,5 +1,8 @@
 #ifndef BLOCKS_WINDOW
 #define BLOCKS_WINDOW
+#if defined(__APPLE__)
+#define GLFW_INCLUDE_GLCOREARB
+#endif
 #include <GLFW/glfw3.h>
 
 GLFWwindow* initWindow(const int resX, const int resY);
@@ -0,0 +1,296 @@
+#include "workers.h"
+
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+
+typedef HANDLE WorkerThread;
+typedef SRWLOCK WorkerMutex;
+typedef CONDITION_VARIABLE WorkerCondition;
+
+#define initWorkerMutex(mutex) InitializeSRWLock(mutex)
+#define destroyWorkerMutex(mutex)
+#define lockWorkerMutex(mutex) AcquireSRWLockExclusive(mutex)
+#define unlockWorkerMutex(mutex) ReleaseSRWLockExclusive(mutex)
+#define initWorkerCondition(condition) InitializeConditionVariable(condition)
+#define destroyWorkerCondition(condition)
+#define waitWorkerCondition(condition, mutex) SleepConditionVariableSRW(condition, mutex, INFINITE, 0)
+#define signalWorkerCondition(condition) WakeConditionVariable(condition)
+#define broadcastWorkerCondition(condition) WakeAllConditionVariable(condition)
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_t WorkerThread;
+typedef pthread_mutex_t WorkerMutex;
+typedef pthread_cond_t WorkerCondition;
+
+#define initWorkerMutex(mutex) pthread_mutex_init(mutex, NULL)
+#define destroyWorkerMutex(mutex) pthread_mutex_destroy(mutex)
+#define lockWorkerMutex(mutex) pthread_mutex_lock(mutex)
+#define unlockWorkerMutex(mutex) pthread_mutex_unlock(mutex)
+#define initWorkerCondition(condition) pthread_cond_init(condition, NULL)
+#define destroyWorkerCondition(condition) pthread_cond_destroy(condition)
+#define waitWorkerCondition(condition, mutex) pthread_cond_wait(condition, mutex)
+#define signalWorkerCondition(condition) pthread_cond_signal(condition)
+#define broadcastWorkerCondition(condition) pthread_cond_broadcast(condition)
+#endif
+
+typedef struct QueuedTask {
+    WorkerTask task;
+    void* context;
+    WorkerGroup* group;
+} QueuedTask;
+
+typedef struct RangeTaskContext {
+    WorkerRangeTask task;
+    void* context;
+    int index;
+} RangeTaskContext;
+
+static WorkerThread* threads = NULL;
+static int threadCount = 0;
+
+static WorkerMutex queueMutex;
+static WorkerCondition queueCondition;
+static WorkerCondition doneCondition;
+
+static QueuedTask* queue = NULL;
+static int queueCapacity = 0;
+static int queueHead = 0;
+static int queueLength = 0;
+static bool shuttingDown = false;
+static bool initialized = false;
+
+static int getProcessorCount() {
+#if defined(_WIN32)
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return (int)systemInfo.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+static void pushTask(QueuedTask queuedTask) {
+    if (queueLength == queueCapacity) {
+        int newCapacity = queueCapacity == 0 ? 64 : queueCapacity * 2;
+        QueuedTask* newQueue = malloc(newCapacity * sizeof(QueuedTask));
+
+        for (int i = 0; i < queueLength; i++) {
+            newQueue[i] = queue[(queueHead + i) % queueCapacity];
+        }
+
+        free(queue);
+        queue = newQueue;
+        queueCapacity = newCapacity;
+        queueHead = 0;
+    }
+
+    queue[(queueHead + queueLength) % queueCapacity] = queuedTask;
+    queueLength++;
+}
+
+static QueuedTask popTask() {
+    QueuedTask queuedTask = queue[queueHead];
+    queueHead = (queueHead + 1) % queueCapacity;
+    queueLength--;
+    return queuedTask;
+}
+
+static bool popGroupTask(WorkerGroup* group, QueuedTask* queuedTask) {
+    for (int i = 0; i < queueLength; i++) {
+        int index = (queueHead + i) % queueCapacity;
+
+        if (queue[index].group != group) {
+            continue;
+        }
+
+        if (i == 0) {
+            *queuedTask = popTask();
+            return true;
+        }
+
+        *queuedTask = queue[index];
+
+        for (int j = i + 1; j < queueLength; j++) {
+            queue[(queueHead + j - 1) % queueCapacity] = queue[(queueHead + j) % queueCapacity];
+        }
+
+        queueLength--;
+        return true;
+    }
+
+    return false;
+}
+
+static void runQueuedTask(QueuedTask queuedTask) {
+    unlockWorkerMutex(&queueMutex);
+    queuedTask.task(queuedTask.context);
+    lockWorkerMutex(&queueMutex);
+
+    queuedTask.group->pending--;
+    if (queuedTask.group->pending == 0) {
+        broadcastWorkerCondition(&doneCondition);
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI workerMain(LPVOID parameter) {
+#else
+static void* workerMain(void* parameter) {
+#endif
+    lockWorkerMutex(&queueMutex);
+
+    while (true) {
+        while (queueLength == 0 && !shuttingDown) {
+            waitWorkerCondition(&queueCondition, &queueMutex);
+        }
+
+        if (queueLength == 0 && shuttingDown) {
+            break;
+        }
+
+        runQueuedTask(popTask());
+    }
+
+    unlockWorkerMutex(&queueMutex);
+    return 0;
+}
+
+void initWorkers(int requestedThreadCount) {
+    if (initialized) {
+        return;
+    }
+
+    initWorkerMutex(&queueMutex);
+    initWorkerCondition(&queueCondition);
+    initWorkerCondition(&doneCondition);
+    shuttingDown = false;
+    initialized = true;
+
+    threadCount = requestedThreadCount > 0 ? requestedThreadCount : getProcessorCount() - 1;
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+
+    threads = calloc(threadCount, sizeof(WorkerThread));
+
+    for (int i = 0; i < threadCount; i++) {
+#if defined(_WIN32)
+        threads[i] = CreateThread(NULL, 0, workerMain, NULL, 0, NULL);
+#else
+        pthread_create(&threads[i], NULL, workerMain, NULL);
+#endif
+    }
+}
+
+void freeWorkers() {
+    if (!initialized) {
+        return;
+    }
+
+    lockWorkerMutex(&queueMutex);
+    shuttingDown = true;
+    broadcastWorkerCondition(&queueCondition);
+    unlockWorkerMutex(&queueMutex);
+
+    for (int i = 0; i < threadCount; i++) {
+#if defined(_WIN32)
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+
+    free(threads);
+    free(queue);
+    threads = NULL;
+    queue = NULL;
+    threadCount = 0;
+    queueCapacity = 0;
+    queueHead = 0;
+    queueLength = 0;
+
+    destroyWorkerCondition(&doneCondition);
+    destroyWorkerCondition(&queueCondition);
+    destroyWorkerMutex(&queueMutex);
+    initialized = false;
+}
+
+int getWorkerCount() {
+    return threadCount;
+}
+
+void submitWorkerTask(WorkerGroup* group, WorkerTask task, void* context) {
+    if (!initialized) {
+        initWorkers(0);
+    }
+
+    QueuedTask queuedTask = {
+        .task = task,
+        .context = context,
+        .group = group
+    };
+
+    lockWorkerMutex(&queueMutex);
+    group->pending++;
+    pushTask(queuedTask);
+    signalWorkerCondition(&queueCondition);
+    unlockWorkerMutex(&queueMutex);
+}
+
+bool isWorkerGroupDone(WorkerGroup* group) {
+    if (!initialized) {
+        return group->pending == 0;
+    }
+
+    lockWorkerMutex(&queueMutex);
+    bool isDone = group->pending == 0;
+    unlockWorkerMutex(&queueMutex);
+
+    return isDone;
+}
+
+void waitForWorkerGroup(WorkerGroup* group) {
+    if (!initialized) {
+        return;
+    }
+
+    lockWorkerMutex(&queueMutex);
+
+    while (group->pending > 0) {
+        QueuedTask queuedTask;
+
+        if (popGroupTask(group, &queuedTask)) {
+            runQueuedTask(queuedTask);
+        } else {
+            waitWorkerCondition(&doneCondition, &queueMutex);
+        }
+    }
+
+    unlockWorkerMutex(&queueMutex);
+}
+
+static void runRangeTask(void* context) {
+    RangeTaskContext* rangeContext = context;
+    rangeContext->task(rangeContext->index, rangeContext->context);
+}
+
+void runWorkersParallel(int taskCount, WorkerRangeTask task, void* context) {
+    WorkerGroup group = { .pending = 0 };
+    RangeTaskContext* rangeContexts = malloc(taskCount * sizeof(RangeTaskContext));
+
+    for (int i = 0; i < taskCount; i++) {
+        rangeContexts[i].task = task;
+        rangeContexts[i].context = context;
+        rangeContexts[i].index = i;
+        submitWorkerTask(&group, runRangeTask, &rangeContexts[i]);
+    }
+
+    waitForWorkerGroup(&group);
+    free(rangeContexts);
+}
@@ -0,0 +1,21 @@
+#ifndef BLOCKS_WORKERS
+#define BLOCKS_WORKERS
+
+#include <stdbool.h>
+
+typedef void (*WorkerTask)(void* context);
+typedef void (*WorkerRangeTask)(int index, void* context);
+
+typedef struct WorkerGroup {
+	int pending;
+} WorkerGroup;
+
+void initWorkers(int threadCount);
+void freeWorkers();
+int getWorkerCount();
+void submitWorkerTask(WorkerGroup* group, WorkerTask task, void* context);
+bool isWorkerGroupDone(WorkerGroup* group);
+void waitForWorkerGroup(WorkerGroup* group);
+void runWorkersParallel(int taskCount, WorkerRangeTask task, void* context);
+
+#endif
@@ -1,6 +1,7 @@
 #include "world.h"
 #include "cube.h"
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <limits.h>
 #include <stdbool.h>
@@ -8,255 +9,1084 @@
 #include "types.h"
 #include "player.h"
 #include "frustum.h"
+#include "visibility.h"
+#include "workers.h"
+#include "noise.h"
+#include "streaming.h"
+#include "region.h"
+#include "journal.h"
+#include "dirty.h"
+#include "lod.h"
+#include "mesh.h"
+#include "meshworkers.h"
+#include "occlusion.h"
+#include "connectivity.h"
+#include "visibleset.h"
+#include "viewport.h"
 #include <stdio.h>
 
 #include "constants.h"
 
 #if defined(__APPLE__)
-#include <OpenGL/gl.h>
+#include <OpenGL/gl3.h>
 #else
 #include <GL/glew.h>
 #include <GL/gl.h>
 #endif
 
+#define OCCLUDER_COLUMN_RADIUS 3
+#define OCCLUDER_CELL_SIZE 4
+#define OCCLUDER_CELL_COUNT (CHUNK_SIZE / OCCLUDER_CELL_SIZE)
+
 WorldState worldState = {
-    .chunks = NULL,
-    .chunkCount = 36
+    .columns = NULL,
+    .columnCount = 0,
+    .columnCapacity = 0,
+    .elidedSectionCount = 0,
+    .revision = 0
+};
+
+static RenderMode renderMode = RENDER_MODE_MESH;
+
+static RenderStats renderStats = {
+    .drawCalls = 0,
+    .drawnVertices = 0,
+    .drawnChunks = 0,
+    .culledChunks = 0,
+    .culledBlocks = 0,
+    .occludedChunks = 0,
+    .caveCulledChunks = 0,
+    .rebuiltMeshes = 0
 };
 
 WorldState* getWorldStateGlobal() {
     return &worldState;
 }
 
+RenderMode getRenderMode() {
+    return renderMode;
+}
+
+void setRenderMode(RenderMode mode) {
+    renderMode = mode;
+}
+
+RenderStats getRenderStats() {
+    return renderStats;
+}
+
 void getChunksInProximity(Vector3 position, int proximity, Chunk* chunks) {
     int currentChunk = 0;
 
-    for (int i = 0; i < worldState.chunkCount; i++) {
-        if (worldState.chunks[i].position.x > position.x - (double)CHUNK_SIZE
-            && worldState.chunks[i].position.x < position.x + (double)CHUNK_SIZE
-            && worldState.chunks[i].position.y > position.y - (double)CHUNK_SIZE
-            && worldState.chunks[i].position.y < position.y + (double)CHUNK_SIZE
-            && worldState.chunks[i].position.z > position.z - (double)CHUNK_SIZE
-            && worldState.chunks[i].position.z < position.z + (double)CHUNK_SIZE
-        ) {
-            chunks[currentChunk++] = worldState.chunks[i];
+    for (int i = 0; i < worldState.columnCount; i++) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            Chunk* chunk = &worldState.columns[i].sections[section];
+            double chunkOriginX = (double)(chunk->position.x * CHUNK_SIZE);
+            double chunkOriginY = (double)(chunk->position.y * CHUNK_SIZE);
+            double chunkOriginZ = (double)(chunk->position.z * CHUNK_SIZE);
+
+            if (chunkOriginX > position.x - (double)CHUNK_SIZE
+                && chunkOriginX < position.x + (double)CHUNK_SIZE
+                && chunkOriginY > position.y - (double)CHUNK_SIZE
+                && chunkOriginY < position.y + (double)CHUNK_SIZE
+                && chunkOriginZ > position.z - (double)CHUNK_SIZE
+                && chunkOriginZ < position.z + (double)CHUNK_SIZE
+            ) {
+                chunks[currentChunk++] = *chunk;
+            }
         }
     }
 }
 
-void placeBlock(WorldState* ws, int x, int y, int z, int blockType) {
-    if (getBlockAtGlobal(ws, x, y, z) != NULL) {
-        return;
+ChunkColumn* getChunkColumnAt(WorldState* ws, int columnX, int columnZ) {
+    IntVector3 key = { .x = columnX, .y = 0, .z = columnZ };
+    int columnIndex = chunkMapGet(&ws->columnMap, key);
+
+    if (columnIndex == CHUNK_MAP_EMPTY) {
+        return NULL;
+    }
+
+    return &ws->columns[columnIndex];
+}
+
+Chunk* getChunkAt(WorldState* ws, int chunkX, int chunkY, int chunkZ) {
+    if (chunkY < 0 || chunkY >= CHUNK_SECTION_COUNT) {
+        return NULL;
+    }
+
+    ChunkColumn* column = getChunkColumnAt(ws, chunkX, chunkZ);
+
+    if (column == NULL) {
+        return NULL;
+    }
+
+    return &column->sections[chunkY];
+}
+
+int getChunkBlock(const Chunk* chunk, int index) {
+    if (chunk->uniformType != CHUNK_MIXED) {
+        return chunk->uniformType;
+    }
+
+    return getStorageBlock(&chunk->blocks, index);
+}
+
+static int getLocalElementIndex(int x, int y, int z) {
+    return (x & CHUNK_MASK) + (y & CHUNK_MASK) * CHUNK_SIZE + (z & CHUNK_MASK) * CHUNK_SIZE * CHUNK_SIZE;
+}
+
+static Chunk* getChunkAtGlobal(WorldState* ws, int x, int y, int z) {
+    return getChunkAt(ws, x >> CHUNK_SHIFT, y >> CHUNK_SHIFT, z >> CHUNK_SHIFT);
+}
+
+static void markColumnModified(WorldState* ws, int x, int y, int z, int blockType) {
+    ChunkColumn* column = getChunkColumnAt(ws, x >> CHUNK_SHIFT, z >> CHUNK_SHIFT);
+
+    if (column != NULL) {
+        column->isModified = true;
+        column->revision++;
+        updateColumnSurface(column, x, y, z, blockType);
+    }
+}
+
+static Vector3 getElementPosition(const Chunk* chunk, int index) {
+    Vector3 position = {
+        .x = (double)(index % CHUNK_SIZE + chunk->position.x * CHUNK_SIZE),
+        .y = (double)((index / CHUNK_SIZE) % CHUNK_SIZE + chunk->position.y * CHUNK_SIZE),
+        .z = (double)(index / (CHUNK_SIZE * CHUNK_SIZE) + chunk->position.z * CHUNK_SIZE)
+    };
+    return position;
+}
+
+size_t getChunkMemoryUsage(const Chunk* chunk) {
+    size_t bytes = sizeof(Chunk);
+
+    if (chunk->uniformType == CHUNK_MIXED) {
+        bytes += getBlockStorageBytes(&chunk->blocks) - sizeof(BlockStorage);
+        bytes += CHUNK_ROW_COUNT * sizeof(uint16_t);
+    }
+
+    if (chunk->visibleFaces != NULL) {
+        bytes += BLOCK_FACE_COUNT * CHUNK_ROW_COUNT * sizeof(uint16_t);
+    }
+
+    return bytes;
+}
+
+size_t getChunkColumnMemoryUsage(const ChunkColumn* column) {
+    size_t bytes = sizeof(ChunkColumn);
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        bytes += getChunkMemoryUsage(&column->sections[section]) - sizeof(Chunk);
     }
 
-    Chunk* targetChunk = NULL;
-    int local_x = 0, local_y = 0, local_z = 0;
-    int elementIndex = 0;
+    return bytes;
+}
+
+static void scanColumnSurface(ChunkColumn* column, int surfaceIndex, int fromY) {
+    int localX = surfaceIndex & CHUNK_MASK;
+    int localZ = surfaceIndex >> CHUNK_SHIFT;
+
+    for (int y = fromY; y >= 0; y--) {
+        const Chunk* chunk = &column->sections[y >> CHUNK_SHIFT];
 
-    for (int i = 0; i < ws->chunkCount; i++) {
-        Chunk* chunk = &ws->chunks[i];
-        int chunk_origin_x = (int)floor(chunk->position.x);
-        int chunk_origin_y = (int)floor(chunk->position.y);
-        int chunk_origin_z = (int)floor(chunk->position.z);
+        if (chunk->uniformType == 0) {
+            y &= ~CHUNK_MASK;
+            continue;
+        }
+
+        int blockType = getChunkBlock(chunk, getLocalElementIndex(localX, y, localZ));
 
-        if (x >= chunk_origin_x && x < chunk_origin_x + CHUNK_SIZE &&
-            y >= chunk_origin_y && y < chunk_origin_y + CHUNK_SIZE &&
-            z >= chunk_origin_z && z < chunk_origin_z + CHUNK_SIZE) {
-            
-            targetChunk = chunk;
-            local_x = x - chunk_origin_x;
-            local_y = y - chunk_origin_y;
-            local_z = z - chunk_origin_z;
-            elementIndex = local_x + local_y * CHUNK_SIZE + local_z * CHUNK_SIZE * CHUNK_SIZE;
-            break;
+        if (blockType != 0) {
+            column->surfaceHeights[surfaceIndex] = (int16_t)y;
+            column->surfaceTypes[surfaceIndex] = (uint8_t)blockType;
+            return;
         }
     }
 
-    if (targetChunk == NULL) {
-        return;
+    column->surfaceHeights[surfaceIndex] = SURFACE_NONE;
+    column->surfaceTypes[surfaceIndex] = 0;
+}
+
+void rebuildColumnSurface(ChunkColumn* column) {
+    uint16_t unresolved[CHUNK_SIZE];
+    int remaining = CHUNK_SIZE * CHUNK_SIZE;
+
+    for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+        column->surfaceHeights[i] = SURFACE_NONE;
+        column->surfaceTypes[i] = 0;
+    }
+
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        unresolved[z] = 0xFFFF;
+    }
+
+    for (int section = CHUNK_SECTION_COUNT - 1; section >= 0 && remaining > 0; section--) {
+        const Chunk* chunk = &column->sections[section];
+
+        if (chunk->uniformType == 0) {
+            continue;
+        }
+
+        for (int y = CHUNK_MASK; y >= 0 && remaining > 0; y--) {
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                uint16_t solid = chunk->uniformType == CHUNK_MIXED ? chunk->solidRows[y + z * CHUNK_SIZE] : 0xFFFF;
+                uint16_t found = solid & unresolved[z];
+
+                if (found == 0) {
+                    continue;
+                }
+
+                unresolved[z] &= (uint16_t)~found;
+
+                for (int x = 0; x < CHUNK_SIZE; x++) {
+                    if ((found >> x) & 1) {
+                        int surfaceIndex = x + z * CHUNK_SIZE;
+                        column->surfaceHeights[surfaceIndex] = (int16_t)(section * CHUNK_SIZE + y);
+                        column->surfaceTypes[surfaceIndex] = (uint8_t)getChunkBlock(chunk, getLocalElementIndex(x, y, z));
+                        remaining--;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void updateColumnSurface(ChunkColumn* column, int x, int y, int z, int blockType) {
+    int surfaceIndex = (x & CHUNK_MASK) + (z & CHUNK_MASK) * CHUNK_SIZE;
+    int surfaceHeight = column->surfaceHeights[surfaceIndex];
+
+    if (y > surfaceHeight && blockType != 0) {
+        column->surfaceHeights[surfaceIndex] = (int16_t)y;
+        column->surfaceTypes[surfaceIndex] = (uint8_t)blockType;
+    } else if (y == surfaceHeight) {
+        if (blockType != 0) {
+            column->surfaceTypes[surfaceIndex] = (uint8_t)blockType;
+        } else {
+            scanColumnSurface(column, surfaceIndex, y - 1);
+        }
+    }
+}
+
+int getSurfaceHeight(WorldState* ws, int x, int z) {
+    ChunkColumn* column = getChunkColumnAt(ws, x >> CHUNK_SHIFT, z >> CHUNK_SHIFT);
+
+    if (column == NULL) {
+        return SURFACE_NONE;
+    }
+
+    return column->surfaceHeights[(x & CHUNK_MASK) + (z & CHUNK_MASK) * CHUNK_SIZE];
+}
+
+int getSurfaceType(WorldState* ws, int x, int z) {
+    ChunkColumn* column = getChunkColumnAt(ws, x >> CHUNK_SHIFT, z >> CHUNK_SHIFT);
+
+    if (column == NULL) {
+        return 0;
     }
 
-    GameElement* newBlock = &targetChunk->gameElements[elementIndex];
-    newBlock->elementType = blockType;
-    newBlock->isObstructed = false;
-    newBlock->position.x = (double)x;
-    newBlock->position.y = (double)y;
-    newBlock->position.z = (double)z;
+    return column->surfaceTypes[(x & CHUNK_MASK) + (z & CHUNK_MASK) * CHUNK_SIZE];
+}
+
+void compactChunk(Chunk* chunk) {
+    if (chunk->uniformType != CHUNK_MIXED) {
+        return;
+    }
 
-    int dx[] = {-1, 1, 0, 0, 0, 0};
-    int dy[] = {0, 0, -1, 1, 0, 0};
-    int dz[] = {0, 0, 0, 0, -1, 1};
+    int firstType = getStorageBlock(&chunk->blocks, 0);
 
-    int solidNeighborCountNewBlock = 0;
-    for (int i = 0; i < 6; i++) {
-        GameElement* neighbor = getBlockAtGlobal(ws, x + dx[i], y + dy[i], z + dz[i]);
-        if (neighbor != NULL && neighbor->elementType != 0) {
-            solidNeighborCountNewBlock++;
+    for (int i = 1; i < BLOCK_STORAGE_SIZE; i++) {
+        if (getStorageBlock(&chunk->blocks, i) != firstType) {
+            return;
         }
     }
-    newBlock->isObstructed = (solidNeighborCountNewBlock == 6);
 
-    for (int i = 0; i < 6; i++) {
-        int neighborX = x + dx[i];
-        int neighborY = y + dy[i];
-        int neighborZ = z + dz[i];
+    freeBlockStorage(&chunk->blocks);
+    free(chunk->solidRows);
+    chunk->solidRows = NULL;
+    chunk->uniformType = firstType;
+}
+
+void expandChunk(WorldState* ws, Chunk* chunk) {
+    if (chunk->uniformType == CHUNK_MIXED) {
+        return;
+    }
+
+    uint16_t rowMask = chunk->uniformType != 0 ? 0xFFFF : 0;
 
-        GameElement* neighborBlock = getBlockAtGlobal(ws, neighborX, neighborY, neighborZ);
+    initBlockStorage(&chunk->blocks, chunk->uniformType);
+    chunk->solidRows = malloc(CHUNK_ROW_COUNT * sizeof(uint16_t));
+    for (int r = 0; r < CHUNK_ROW_COUNT; r++) {
+        chunk->solidRows[r] = rowMask;
+    }
+
+    chunk->uniformType = CHUNK_MIXED;
+    ws->elidedSectionCount--;
+}
+
+bool setChunkBlock(WorldState* ws, Chunk* chunk, int index, int blockType) {
+    if (getChunkBlock(chunk, index) == blockType) {
+        return true;
+    }
+
+    expandChunk(ws, chunk);
+
+    if (!setStorageBlock(&chunk->blocks, index, blockType)) {
+        return false;
+    }
+
+    setChunkOccupancy(chunk, index, blockType != 0);
+    chunk->hasConnectivity = false;
+    return true;
+}
+
+void placeBlock(WorldState* ws, int x, int y, int z, int blockType) {
+    if (getBlockTypeAtGlobal(ws, x, y, z) != 0) {
+        return;
+    }
+
+    Chunk* targetChunk = getChunkAtGlobal(ws, x, y, z);
+
+    if (targetChunk == NULL) {
+        return;
+    }
+
+    int index = getLocalElementIndex(x, y, z);
+
+    if (!setChunkBlock(ws, targetChunk, index, blockType)) {
+        return;
+    }
+
+    markColumnModified(ws, x, y, z, blockType);
+    appendJournalEdit(x, y, z, 0, blockType);
+    markBlockDirty(ws, x, y, z);
+}
+
+static void generateChunkBlocks(Chunk* chunk, const float* heights) {
+    chunk->uniformType = CHUNK_MIXED;
+    initBlockStorage(&chunk->blocks, 0);
+    chunk->solidRows = calloc(CHUNK_ROW_COUNT, sizeof(uint16_t));
+
+    for (int z_local = 0; z_local < CHUNK_SIZE; z_local++) {
+        for (int x_local = 0; x_local < CHUNK_SIZE; x_local++) {
+            float height = heights[x_local + z_local * CHUNK_SIZE] * 10.0f;
+            int groundHeight = (int)roundf(height);
+
+            for (int y_local = 0; y_local < CHUNK_SIZE; y_local++) {
+                int y_coord = y_local + chunk->position.y * CHUNK_SIZE;
+                int elementType = 0;
+
+                if (y_coord <= 0) {
+                    elementType = 3;
+                }
+                else if (y_coord == groundHeight && groundHeight <= 1) {
+                    elementType = 2;
+                }
+                else if (y_coord <= groundHeight) {
+                    elementType = 1;
+                }
 
-        if (neighborBlock != NULL && neighborBlock->elementType != 0) {
-            int solidNeighborCount = 0;
-            for (int j = 0; j < 6; j++) {
-                GameElement* nnBlock = getBlockAtGlobal(ws, neighborX + dx[j], neighborY + dy[j], neighborZ + dz[j]);
-                if (nnBlock != NULL && nnBlock->elementType != 0) {
-                    solidNeighborCount++;
+                if (elementType != 0) {
+                    int i = x_local + y_local * CHUNK_SIZE + z_local * CHUNK_SIZE * CHUNK_SIZE;
+                    setStorageBlock(&chunk->blocks, i, elementType);
+                    setChunkOccupancy(chunk, i, true);
                 }
             }
-            neighborBlock->isObstructed = (solidNeighborCount == 6);
         }
     }
+
+    compactChunk(chunk);
+}
+
+void generateChunkColumn(ChunkColumn* column) {
+    float heights[CHUNK_SIZE * CHUNK_SIZE];
+    fillNoiseHeightmap(column->x * CHUNK_SIZE, column->z * CHUNK_SIZE, heights);
+    column->isModified = false;
+    column->journalSequence = 0;
+
+    int topHeight = 0;
+    for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+        int groundHeight = (int)roundf(heights[i] * 10.0f);
+        if (groundHeight > topHeight) {
+            topHeight = groundHeight;
+        }
+
+        if (groundHeight <= 0) {
+            column->surfaceHeights[i] = 0;
+            column->surfaceTypes[i] = 3;
+        } else {
+            column->surfaceHeights[i] = (int16_t)(groundHeight < WORLD_HEIGHT ? groundHeight : WORLD_HEIGHT - 1);
+            column->surfaceTypes[i] = groundHeight <= 1 ? 2 : 1;
+        }
+    }
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        Chunk* chunk = &column->sections[section];
+
+        memset(chunk, 0, sizeof(Chunk));
+        chunk->position.x = column->x;
+        chunk->position.y = section;
+        chunk->position.z = column->z;
+
+        if (section * CHUNK_SIZE > topHeight) {
+            chunk->uniformType = 0;
+            continue;
+        }
+
+        generateChunkBlocks(chunk, heights);
+    }
+}
+
+void freeChunkColumn(ChunkColumn* column) {
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        Chunk* chunk = &column->sections[section];
+
+        if (chunk->uniformType == CHUNK_MIXED) {
+            freeBlockStorage(&chunk->blocks);
+        }
+
+        freeChunkMesh(chunk);
+        freeChunkInstances(chunk);
+        free(chunk->solidRows);
+        free(chunk->visibleFaces);
+        chunk->solidRows = NULL;
+        chunk->visibleFaces = NULL;
+        chunk->visibleFaceCount = 0;
+    }
+
+    freeColumnLod(column);
+}
+
+static int countElidedSections(const ChunkColumn* column) {
+    int elidedCount = 0;
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        if (column->sections[section].uniformType != CHUNK_MIXED) {
+            elidedCount++;
+        }
+    }
+
+    return elidedCount;
+}
+
+static void generateColumn(int columnIndex, void* context) {
+    ChunkColumn* columns = context;
+    generateChunkColumn(&columns[columnIndex]);
+}
+
+static void generateSectionVisibility(int sectionIndex, void* context) {
+    WorldState* ws = context;
+    ChunkColumn* column = &ws->columns[sectionIndex / CHUNK_SECTION_COUNT];
+    updateChunkVisibility(ws, &column->sections[sectionIndex % CHUNK_SECTION_COUNT]);
+}
+
+ChunkColumn* addChunkColumn(WorldState* ws, const ChunkColumn* column) {
+    if (ws->columnCount == ws->columnCapacity) {
+        ws->columnCapacity = ws->columnCapacity == 0 ? 64 : ws->columnCapacity * 2;
+        ws->columns = realloc(ws->columns, ws->columnCapacity * sizeof(ChunkColumn));
+    }
+
+    if (ws->columnMap.entries == NULL) {
+        initChunkMap(&ws->columnMap, ws->columnCapacity);
+    }
+
+    IntVector3 key = { .x = column->x, .y = 0, .z = column->z };
+    int columnIndex = ws->columnCount++;
+    ws->columns[columnIndex] = *column;
+    chunkMapPut(&ws->columnMap, key, columnIndex);
+    ws->elidedSectionCount += countElidedSections(column);
+    ws->revision++;
+    applyJournalEdits(ws, &ws->columns[columnIndex]);
+
+    return &ws->columns[columnIndex];
 }
 
-static float valueNoise2d(float x, float z) {
-    float total = 0.0f;
-    float frequency = 0.08f;
-    float amplitude = 1.0f;
-    float maxValue = 0.0f;
-    int octaves = 4;
+void removeChunkColumn(WorldState* ws, int columnX, int columnZ) {
+    IntVector3 key = { .x = columnX, .y = 0, .z = columnZ };
+    int columnIndex = chunkMapGet(&ws->columnMap, key);
+
+    if (columnIndex == CHUNK_MAP_EMPTY) {
+        return;
+    }
+
+    ws->elidedSectionCount -= countElidedSections(&ws->columns[columnIndex]);
+    freeChunkColumn(&ws->columns[columnIndex]);
+    chunkMapRemove(&ws->columnMap, key);
+    ws->revision++;
 
-    for (int i = 0; i < octaves; i++) {
-        float n = sinf(x * frequency + i * 13.37f) * cosf(z * frequency + i * 7.13f);
-        total += n * amplitude;
-        maxValue += amplitude;
-        amplitude *= 0.5f;
-        frequency *= 2.0f;
+    int lastIndex = --ws->columnCount;
+    if (columnIndex != lastIndex) {
+        ws->columns[columnIndex] = ws->columns[lastIndex];
+
+        IntVector3 movedKey = { .x = ws->columns[columnIndex].x, .y = 0, .z = ws->columns[columnIndex].z };
+        chunkMapPut(&ws->columnMap, movedKey, columnIndex);
     }
-    return total / maxValue;
 }
 
 void generateWorld() {
-    srand(123);
-    worldState.chunks = calloc(worldState.chunkCount, sizeof(Chunk)); 
-
-    for (int j = 0; j < worldState.chunkCount; j++) {
-        double offset = (double)CHUNK_SIZE * (double)(worldState.chunkCount / (int)sqrt(worldState.chunkCount)) / 2.0;
-
-        Vector3 chunkPosition = {
-            .x = 0.0 + (double)CHUNK_SIZE * (double)(j / (int)sqrt(worldState.chunkCount)) - offset,
-            .y = 0.0,
-            .z = 0.0 + (double)CHUNK_SIZE * (double)(j % (int)sqrt(worldState.chunkCount)) - offset
-        };
-        worldState.chunks[j].position = chunkPosition;
-        worldState.chunks[j].gameElements = calloc(CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE, sizeof(GameElement));
-
-        for (size_t i = 0; i < CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE; i++) {
-            int x_coord = i % CHUNK_SIZE + chunkPosition.x;
-            int y_coord = (i / CHUNK_SIZE) % CHUNK_SIZE + chunkPosition.y;
-            int z_coord = i / (CHUNK_SIZE * CHUNK_SIZE) + chunkPosition.z;
-
-            Vector3 elementPosition = {
-                .x = (double)x_coord,
-                .y = (double)y_coord,
-                .z = (double)z_coord
-            };
-            worldState.chunks[j].gameElements[i].position = elementPosition;
+    initNoise();
 
-            float height = valueNoise2d((float)x_coord, (float)z_coord) * 10.0f;
-            int groundHeight = (int)roundf(height);
+    StreamingConfig config = getChunkStreamingConfig();
+    Vector3 viewportPosition = getViewportPosition();
+    int centerX = (int)floor(viewportPosition.x) >> CHUNK_SHIFT;
+    int centerZ = (int)floor(viewportPosition.z) >> CHUNK_SHIFT;
+    int diameter = config.loadRadius * 2 + 1;
+    ChunkColumn* newColumns = calloc(diameter * diameter, sizeof(ChunkColumn));
+    int newColumnCount = 0;
+    int loadedColumnCount = 0;
+
+    for (int dx = -config.loadRadius; dx <= config.loadRadius; dx++) {
+        for (int dz = -config.loadRadius; dz <= config.loadRadius; dz++) {
+            if (getChunkColumnAt(&worldState, centerX + dx, centerZ + dz) != NULL) {
+                continue;
+            }
+
+            ChunkColumn* column = &newColumns[newColumnCount];
+            column->x = centerX + dx;
+            column->z = centerZ + dz;
+
+            if (loadChunkColumn(column)) {
+                addChunkColumn(&worldState, column);
+                loadedColumnCount++;
+            } else {
+                newColumnCount++;
+            }
+        }
+    }
+
+    runWorkersParallel(newColumnCount, generateColumn, newColumns);
+
+    for (int i = 0; i < newColumnCount; i++) {
+        addChunkColumn(&worldState, &newColumns[i]);
+    }
+    free(newColumns);
+
+    runWorkersParallel(worldState.columnCount * CHUNK_SECTION_COUNT, generateSectionVisibility, &worldState);
+
+    if (worldState.columnCount > 0) {
+        size_t worldBytes = 0;
+        for (int j = 0; j < worldState.columnCount; j++) {
+            worldBytes += getChunkColumnMemoryUsage(&worldState.columns[j]);
+        }
+
+        printf("World: %d columns (%d loaded), %zu bytes per column, %d of %d sections elided, %s noise\n",
+            worldState.columnCount, loadedColumnCount, worldBytes / worldState.columnCount,
+            worldState.elidedSectionCount, worldState.columnCount * CHUNK_SECTION_COUNT, getNoiseKernelName());
+    }
+}
 
-            if (y_coord <= 0) {
-                worldState.chunks[j].gameElements[i].elementType = 3;
+bool saveWorld() {
+    bool isSaved = true;
+
+    for (int i = 0; i < worldState.columnCount; i++) {
+        if (worldState.columns[i].isModified && !saveChunkColumn(&worldState.columns[i])) {
+            isSaved = false;
+        }
+    }
+
+    return isSaved;
+}
+
+void queueWorldSave() {
+    for (int i = 0; i < worldState.columnCount; i++) {
+        if (worldState.columns[i].isModified) {
+            queueChunkColumnSave(&worldState, &worldState.columns[i]);
+        }
+    }
+}
+
+void removeWorld() {
+    if (worldState.columns != NULL) {
+        for (int i = 0; i < worldState.columnCount; i++) {
+            freeChunkColumn(&worldState.columns[i]);
+        }
+        free(worldState.columns);
+        worldState.columns = NULL;
+        worldState.columnCount = 0;
+        worldState.columnCapacity = 0;
+        worldState.elidedSectionCount = 0;
+        worldState.revision++;
+        freeChunkMap(&worldState.columnMap);
+    }
+}
+
+static void drawChunkElement(Chunk* chunk, int index, const PlayerState* pState) {
+    int elementType = getChunkBlock(chunk, index);
+    Vector3 basePosition = getElementPosition(chunk, index);
+    bool isHighlighted = false;
+
+    if (pState->isLookingAtBlock) {
+        if (pState->lookingAtBlock.x == basePosition.x &&
+            pState->lookingAtBlock.y == basePosition.y &&
+            pState->lookingAtBlock.z == basePosition.z) {
+            isHighlighted = true;
+        }
+    }
+
+    if (isHighlighted) {
+        setCubeOutlineWidth(2.0f);
+        drawCube(basePosition, elementType, HIGHLIGHT_OUTLINE_COLOR);
+        setCubeOutlineWidth(1.0f);
+    } else {
+        drawCube(basePosition, elementType, DEFAULT_OUTLINE_COLOR);
+    }
+
+    renderStats.drawCalls++;
+    renderStats.drawnVertices += 24;
+}
+
+static void drawChunkElementBatch(Chunk* chunk, const int* indices, int count, float* centers,
+    const Frustum* frustum, const PlayerState* pState) {
+    static const float extents[12] = {
+        0.5f, 0.5f, 0.5f, 0.5f,
+        0.5f, 0.5f, 0.5f, 0.5f,
+        0.5f, 0.5f, 0.5f, 0.5f
+    };
+
+    for (int lane = count; lane < 4; lane++) {
+        centers[lane] = centers[0];
+        centers[lane + 4] = centers[4];
+        centers[lane + 8] = centers[8];
+    }
+
+    int insideMask;
+    int visibleMask = classifyAABBsInFrustum4(frustum, centers, extents, &insideMask);
+
+    for (int lane = 0; lane < count; lane++) {
+        if ((visibleMask >> lane) & 1) {
+            drawChunkElement(chunk, indices[lane], pState);
+        } else {
+            renderStats.culledBlocks++;
+        }
+    }
+}
+
+static void drawChunkCubes(Chunk* chunk, const Frustum* frustum, const PlayerState* pState, bool isInside) {
+    int indices[4];
+    float centers[12];
+    int batchCount = 0;
+
+    for (int r = 0; r < CHUNK_ROW_COUNT; r++) {
+        uint16_t visibleRow = getVisibleRowMask(chunk, r);
+
+        for (int bit = 0; visibleRow != 0; bit++, visibleRow >>= 1) {
+            if ((visibleRow & 1) == 0) {
+                continue;
+            }
+
+            int i = (r << CHUNK_SHIFT) + bit;
+
+            if (isInside) {
+                drawChunkElement(chunk, i, pState);
+                continue;
+            }
+
+            Vector3 basePosition = getElementPosition(chunk, i);
+            centers[batchCount] = (float)(basePosition.x + 0.5);
+            centers[batchCount + 4] = (float)(basePosition.y - 1.0);
+            centers[batchCount + 8] = (float)(basePosition.z + 0.5);
+            indices[batchCount++] = i;
+
+            if (batchCount == 4) {
+                drawChunkElementBatch(chunk, indices, batchCount, centers, frustum, pState);
+                batchCount = 0;
             }
-            else if (y_coord == groundHeight && groundHeight <= 1) {
-                worldState.chunks[j].gameElements[i].elementType = 2;
+        }
+    }
+
+    if (batchCount > 0) {
+        drawChunkElementBatch(chunk, indices, batchCount, centers, frustum, pState);
+    }
+
+    renderStats.drawnChunks++;
+}
+
+static void drawChunkWithMesh(Chunk* chunk, bool isBatched) {
+    if (chunk->isMeshDirty && chunk->meshJob == 0) {
+        if (!isMeshWorkersEnabled()) {
+            buildChunkMesh(chunk);
+            renderStats.rebuiltMeshes++;
+        } else {
+            submitChunkMeshJob(chunk, MESH_JOB_MESH);
+        }
+    }
+
+    if (chunk->meshVertexCount == 0) {
+        return;
+    }
+
+    if (isBatched) {
+        queueChunkMesh(chunk);
+    } else {
+        drawChunkMesh(chunk);
+        renderStats.drawCalls++;
+    }
+
+    renderStats.drawnVertices += chunk->meshVertexCount;
+    renderStats.drawnChunks++;
+}
+
+static void drawChunkWithInstances(Chunk* chunk) {
+    if (chunk->isInstanceDirty && chunk->instanceJob == 0) {
+        if (!isMeshWorkersEnabled()) {
+            buildChunkInstances(chunk);
+            renderStats.rebuiltMeshes++;
+        } else {
+            submitChunkMeshJob(chunk, MESH_JOB_INSTANCES);
+        }
+    }
+
+    if (chunk->instanceCount == 0) {
+        return;
+    }
+
+    drawChunkInstances(chunk);
+    renderStats.drawCalls++;
+    renderStats.drawnVertices += chunk->instanceCount * 24;
+    renderStats.drawnChunks++;
+}
+
+static void drawChunk(Chunk* chunk, RenderMode mode, bool isInside, const Frustum* frustum, const PlayerState* pState) {
+    if (mode == RENDER_MODE_MESH || mode == RENDER_MODE_INDIRECT) {
+        drawChunkWithMesh(chunk, mode == RENDER_MODE_INDIRECT);
+    } else if (mode == RENDER_MODE_INSTANCED) {
+        drawChunkWithInstances(chunk);
+    } else {
+        drawChunkCubes(chunk, frustum, pState, isInside);
+    }
+}
+
+static void setChunkBoundsLane(const Chunk* chunk, int lane, float* centers, float* extents) {
+    centers[lane] = chunk->position.x * CHUNK_SIZE + (chunk->visibleMin.x + chunk->visibleMax.x + 1) * 0.5f;
+    centers[lane + 4] = chunk->position.y * CHUNK_SIZE + (chunk->visibleMin.y + chunk->visibleMax.y + 1) * 0.5f - 1.5f;
+    centers[lane + 8] = chunk->position.z * CHUNK_SIZE + (chunk->visibleMin.z + chunk->visibleMax.z + 1) * 0.5f;
+    extents[lane] = (chunk->visibleMax.x - chunk->visibleMin.x + 1) * 0.5f;
+    extents[lane + 4] = (chunk->visibleMax.y - chunk->visibleMin.y + 1) * 0.5f;
+    extents[lane + 8] = (chunk->visibleMax.z - chunk->visibleMin.z + 1) * 0.5f;
+}
+
+static bool isChunkOccluded(const Chunk* chunk) {
+    Vector3 center = {
+        .x = chunk->position.x * CHUNK_SIZE + (chunk->visibleMin.x + chunk->visibleMax.x + 1) * 0.5,
+        .y = chunk->position.y * CHUNK_SIZE + (chunk->visibleMin.y + chunk->visibleMax.y + 1) * 0.5 - 1.5,
+        .z = chunk->position.z * CHUNK_SIZE + (chunk->visibleMin.z + chunk->visibleMax.z + 1) * 0.5
+    };
+    Vector3 extents = {
+        .x = (chunk->visibleMax.x - chunk->visibleMin.x + 1) * 0.5,
+        .y = (chunk->visibleMax.y - chunk->visibleMin.y + 1) * 0.5,
+        .z = (chunk->visibleMax.z - chunk->visibleMin.z + 1) * 0.5
+    };
+
+    return isAABBOccluded(&center, &extents);
+}
+
+static void collectVisibleChunk(Chunk* chunk, int chunkCount, bool isInside, Vector3 eyePosition) {
+    if (chunkCount > 1 && isChunkOccluded(chunk)) {
+        renderStats.occludedChunks++;
+        return;
+    }
+
+    float minX = chunk->position.x * CHUNK_SIZE + chunk->visibleMin.x;
+    float minY = chunk->position.y * CHUNK_SIZE + chunk->visibleMin.y - 1.5f;
+    float minZ = chunk->position.z * CHUNK_SIZE + chunk->visibleMin.z;
+    float dx = fmaxf(fmaxf(minX - eyePosition.x, eyePosition.x - (minX + chunk->visibleMax.x - chunk->visibleMin.x + 1)), 0.0f);
+    float dy = fmaxf(fmaxf(minY - eyePosition.y, eyePosition.y - (minY + chunk->visibleMax.y - chunk->visibleMin.y + 1)), 0.0f);
+    float dz = fmaxf(fmaxf(minZ - eyePosition.z, eyePosition.z - (minZ + chunk->visibleMax.z - chunk->visibleMin.z + 1)), 0.0f);
+
+    addVisibleChunk(chunk, dx * dx + dy * dy + dz * dz, isInside);
+}
+
+static void collectColumnChunks(ChunkColumn* column, const Frustum* frustum, Vector3 eyePosition) {
+    Chunk* chunks[CHUNK_SECTION_COUNT];
+    int chunkCount = 0;
+    IntVector3 columnMin = { .x = CHUNK_SIZE, .y = WORLD_HEIGHT, .z = CHUNK_SIZE };
+    IntVector3 columnMax = { .x = -1, .y = -1, .z = -1 };
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        Chunk* chunk = &column->sections[section];
+
+        if (chunk->visibleFaceCount == 0) {
+            if (chunk->meshCapacity != 0 || chunk->instanceCapacity != 0) {
+                freeChunkMesh(chunk);
+                freeChunkInstances(chunk);
             }
-            else if (y_coord <= groundHeight) {
-                worldState.chunks[j].gameElements[i].elementType = 1;
+            continue;
+        }
+
+        if (!isChunkReachable(chunk)) {
+            renderStats.caveCulledChunks++;
+            continue;
+        }
+
+        int baseY = section * CHUNK_SIZE;
+        columnMin.x = chunk->visibleMin.x < columnMin.x ? chunk->visibleMin.x : columnMin.x;
+        columnMin.y = baseY + chunk->visibleMin.y < columnMin.y ? baseY + chunk->visibleMin.y : columnMin.y;
+        columnMin.z = chunk->visibleMin.z < columnMin.z ? chunk->visibleMin.z : columnMin.z;
+        columnMax.x = chunk->visibleMax.x > columnMax.x ? chunk->visibleMax.x : columnMax.x;
+        columnMax.y = baseY + chunk->visibleMax.y > columnMax.y ? baseY + chunk->visibleMax.y : columnMax.y;
+        columnMax.z = chunk->visibleMax.z > columnMax.z ? chunk->visibleMax.z : columnMax.z;
+        chunks[chunkCount++] = chunk;
+    }
+
+    if (chunkCount == 0) {
+        return;
+    }
+
+    Vector3 columnCenter = {
+        .x = column->x * CHUNK_SIZE + (columnMin.x + columnMax.x + 1) * 0.5,
+        .y = (columnMin.y + columnMax.y + 1) * 0.5 - 1.5,
+        .z = column->z * CHUNK_SIZE + (columnMin.z + columnMax.z + 1) * 0.5
+    };
+    Vector3 columnExtents = {
+        .x = (columnMax.x - columnMin.x + 1) * 0.5,
+        .y = (columnMax.y - columnMin.y + 1) * 0.5,
+        .z = (columnMax.z - columnMin.z + 1) * 0.5
+    };
+    FrustumClass columnClass = classifyAABBInFrustum(frustum, &columnCenter, &columnExtents);
+
+    if (columnClass == FRUSTUM_OUTSIDE) {
+        renderStats.culledChunks += chunkCount;
+        return;
+    }
+
+    if (isAABBOccluded(&columnCenter, &columnExtents)) {
+        renderStats.occludedChunks += chunkCount;
+        return;
+    }
+
+    if (columnClass == FRUSTUM_INSIDE) {
+        for (int i = 0; i < chunkCount; i++) {
+            collectVisibleChunk(chunks[i], chunkCount, true, eyePosition);
+        }
+        return;
+    }
+
+    for (int i = 0; i < chunkCount; i += 4) {
+        int batchCount = chunkCount - i < 4 ? chunkCount - i : 4;
+        float centers[12];
+        float extents[12];
+
+        for (int lane = 0; lane < 4; lane++) {
+            setChunkBoundsLane(chunks[i + (lane < batchCount ? lane : 0)], lane, centers, extents);
+        }
+
+        int insideMask;
+        int visibleMask = classifyAABBsInFrustum4(frustum, centers, extents, &insideMask);
+
+        for (int lane = 0; lane < batchCount; lane++) {
+            if ((visibleMask >> lane) & 1) {
+                collectVisibleChunk(chunks[i + lane], chunkCount, (insideMask >> lane) & 1, eyePosition);
+            } else {
+                renderStats.culledChunks++;
             }
-            else {
-                worldState.chunks[j].gameElements[i].elementType = 0;
+        }
+    }
+}
+
+static int getOccluderCellTop(const ChunkColumn* column, int cellX, int cellZ) {
+    uint16_t cellMask = (uint16_t)(((1 << OCCLUDER_CELL_SIZE) - 1) << cellX);
+
+    for (int y = 0; y < WORLD_HEIGHT; y++) {
+        const Chunk* chunk = &column->sections[y >> CHUNK_SHIFT];
+
+        if (chunk->uniformType == 0) {
+            return y - 1;
+        }
+
+        if (chunk->uniformType != CHUNK_MIXED) {
+            y |= CHUNK_MASK;
+            continue;
+        }
+
+        for (int z = cellZ; z < cellZ + OCCLUDER_CELL_SIZE; z++) {
+            if ((chunk->solidRows[(y & CHUNK_MASK) + z * CHUNK_SIZE] & cellMask) != cellMask) {
+                return y - 1;
             }
         }
     }
 
-    for (int j = 0; j < worldState.chunkCount; j++) {
-        for (size_t i = 0; i < CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE; i++) {
-            worldState.chunks[j].gameElements[i].isObstructed = false;
+    return WORLD_HEIGHT - 1;
+}
+
+static void addColumnOccluders(const ChunkColumn* column) {
+    int tops[OCCLUDER_CELL_COUNT * OCCLUDER_CELL_COUNT];
+
+    for (int cellZ = 0; cellZ < OCCLUDER_CELL_COUNT; cellZ++) {
+        for (int cellX = 0; cellX < OCCLUDER_CELL_COUNT; cellX++) {
+            tops[cellX + cellZ * OCCLUDER_CELL_COUNT] = getOccluderCellTop(column, cellX * OCCLUDER_CELL_SIZE, cellZ * OCCLUDER_CELL_SIZE);
         }
     }
 
-    for (int j = 0; j < worldState.chunkCount; j++) {
-        for (size_t i = 0; i < CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE; i++) {
-            GameElement* currentBlock = &worldState.chunks[j].gameElements[i];
+    for (int cellZ = 0; cellZ < OCCLUDER_CELL_COUNT; cellZ++) {
+        for (int cellX = 0; cellX < OCCLUDER_CELL_COUNT; cellX++) {
+            int top = tops[cellX + cellZ * OCCLUDER_CELL_COUNT];
 
-            if (currentBlock->elementType == 0) {
+            if (top < 0) {
                 continue;
             }
 
-            int solidNeighborCount = 0;
-            int currentX = (int)floor(currentBlock->position.x);
-            int currentY = (int)floor(currentBlock->position.y);
-            int currentZ = (int)floor(currentBlock->position.z);
+            int faceMask = 1 << BLOCK_FACE_TOP;
 
-            if (getBlockAtGlobal(&worldState, currentX + 1, currentY, currentZ) != NULL) { solidNeighborCount++; }
-            if (getBlockAtGlobal(&worldState, currentX - 1, currentY, currentZ) != NULL) { solidNeighborCount++; }
-            if (getBlockAtGlobal(&worldState, currentX, currentY + 1, currentZ) != NULL) { solidNeighborCount++; }
-            if (getBlockAtGlobal(&worldState, currentX, currentY - 1, currentZ) != NULL) { solidNeighborCount++; }
-            if (getBlockAtGlobal(&worldState, currentX, currentY, currentZ + 1) != NULL) { solidNeighborCount++; }
-            if (getBlockAtGlobal(&worldState, currentX, currentY, currentZ - 1) != NULL) { solidNeighborCount++; }
+            if (cellX == OCCLUDER_CELL_COUNT - 1 || tops[cellX + 1 + cellZ * OCCLUDER_CELL_COUNT] < top) {
+                faceMask |= 1 << BLOCK_FACE_RIGHT;
+            }
+            if (cellX == 0 || tops[cellX - 1 + cellZ * OCCLUDER_CELL_COUNT] < top) {
+                faceMask |= 1 << BLOCK_FACE_LEFT;
+            }
+            if (cellZ == OCCLUDER_CELL_COUNT - 1 || tops[cellX + (cellZ + 1) * OCCLUDER_CELL_COUNT] < top) {
+                faceMask |= 1 << BLOCK_FACE_FRONT;
+            }
+            if (cellZ == 0 || tops[cellX + (cellZ - 1) * OCCLUDER_CELL_COUNT] < top) {
+                faceMask |= 1 << BLOCK_FACE_BACK;
+            }
 
-            currentBlock->isObstructed = (solidNeighborCount == 6);
+            Vector3 min = {
+                .x = column->x * CHUNK_SIZE + cellX * OCCLUDER_CELL_SIZE,
+                .y = -1.5,
+                .z = column->z * CHUNK_SIZE + cellZ * OCCLUDER_CELL_SIZE
+            };
+            Vector3 max = {
+                .x = min.x + OCCLUDER_CELL_SIZE,
+                .y = top - 0.5,
+                .z = min.z + OCCLUDER_CELL_SIZE
+            };
+            addOccluderBox(min, max, faceMask);
         }
     }
 }
 
-void removeWorld() {
-    if (worldState.chunks != NULL) {
-        for (int i = 0; i < worldState.chunkCount; i++) {
-            if (worldState.chunks[i].gameElements != NULL) {
-                free(worldState.chunks[i].gameElements);
-                worldState.chunks[i].gameElements = NULL; 
+static void rasterizeWorldOccluders(const Matrix4* viewProjection, Vector3 viewportPosition) {
+    beginOcclusionFrame(viewProjection);
+
+    if (!isOcclusionEnabled()) {
+        return;
+    }
+
+    int centerX = (int)floor(viewportPosition.x) >> CHUNK_SHIFT;
+    int centerZ = (int)floor(viewportPosition.z) >> CHUNK_SHIFT;
+
+    for (int dz = -OCCLUDER_COLUMN_RADIUS; dz <= OCCLUDER_COLUMN_RADIUS; dz++) {
+        for (int dx = -OCCLUDER_COLUMN_RADIUS; dx <= OCCLUDER_COLUMN_RADIUS; dx++) {
+            ChunkColumn* column = getChunkColumnAt(&worldState, centerX + dx, centerZ + dz);
+
+            if (column != NULL) {
+                addColumnOccluders(column);
             }
         }
-        free(worldState.chunks);
-        worldState.chunks = NULL;
     }
+
+    rasterizeOccluders();
+}
+
+static void drawHighlightedBlock(const PlayerState* pState) {
+    if (!pState->isLookingAtBlock) {
+        return;
+    }
+
+    Vector3 position = pState->lookingAtBlock;
+    int elementType = getBlockTypeAtGlobal(&worldState, (int)floor(position.x), (int)floor(position.y), (int)floor(position.z));
+
+    if (elementType == 0) {
+        return;
+    }
+
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(-1.0f, -1.0f);
+    setCubeOutlineWidth(2.0f);
+    drawCube(position, elementType, HIGHLIGHT_OUTLINE_COLOR);
+    setCubeOutlineWidth(1.0f);
+    glDisable(GL_POLYGON_OFFSET_FILL);
+
+    renderStats.drawCalls++;
+    renderStats.drawnVertices += 24;
+}
+
+static int getVisibleSetSettings() {
+    return isOcclusionEnabled() | (isCaveCullingEnabled() << 1) | (getLodConfig().levelDistances[0] << 2)
+        | ((int)getViewDistance() << 10);
+}
+
+static void rebuildVisibleSet(const Frustum* frustum, const Matrix4* viewProjection, Vector3 viewportPosition, const PlayerState* pState) {
+    Frustum cullFrustum = *frustum;
+
+    if (isVisibleSetCacheEnabled()) {
+        expandFrustum(&cullFrustum, getVisibleSetMargin(getViewDistance()));
+    }
+
+    renderStats.culledChunks = 0;
+    renderStats.occludedChunks = 0;
+    renderStats.caveCulledChunks = 0;
+    rasterizeWorldOccluders(viewProjection, viewportPosition);
+
+    Vector3 cameraPosition = {
+        .x = viewportPosition.x,
+        .y = viewportPosition.y + pState->height - 1.0,
+        .z = viewportPosition.z
+    };
+    findReachableChunks(&worldState, cameraPosition, &cullFrustum, getLodConfig().levelDistances[0] - 1);
+    beginVisibleSet(viewportPosition, getViewportRotation(), frustum, worldState.revision, getVisibleSetSettings());
+
+    for (int i = 0; i < worldState.columnCount; i++) {
+        ChunkColumn* column = &worldState.columns[i];
+
+        if (getColumnLodLevel(column->x, column->z, viewportPosition) == 0) {
+            collectColumnChunks(column, &cullFrustum, cameraPosition);
+        }
+    }
+
+    sortVisibleSet();
 }
 
-void drawWorld(const Frustum* frustum) {
+void drawWorld(const Frustum* frustum, const Matrix4* viewProjection) {
     PlayerState pState = getPlayerState();
+    Vector3 viewportPosition = getViewportPosition();
+    RenderMode mode = renderMode;
 
-    for (int j = 0; j < worldState.chunkCount; j++) {
-        for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE; i++) {
-            GameElement gameElement = worldState.chunks[j].gameElements[i];
-
-            if (gameElement.elementType != 0 && !gameElement.isObstructed) {
-                Vector3 basePosition = gameElement.position;
-                Vector3 cubeCenter;
-                Vector3 cubeExtents;
-                
-                getCubeAABB(basePosition, &cubeCenter, &cubeExtents);
-                
-                if (isAABBInFrustum(frustum, &cubeCenter, &cubeExtents)) {
-                    bool isHighlighted = false;
-                    if (pState.isLookingAtBlock && pState.lookingAtBlock != NULL) {
-                        if (pState.lookingAtBlock->x == gameElement.position.x &&
-                            pState.lookingAtBlock->y == gameElement.position.y &&
-                            pState.lookingAtBlock->z == gameElement.position.z) {
-                            isHighlighted = true;
-                        }
-                    }
+    if (mode == RENDER_MODE_INDIRECT && !isCubeMeshBatchSupported()) {
+        mode = RENDER_MODE_MESH;
+    }
 
-                    if (isHighlighted) {
-                        glLineWidth(2.0f);
-                        drawCube(basePosition, getColorByType(gameElement.elementType), HIGHLIGHT_OUTLINE_COLOR);
-                        glLineWidth(1.0f);
-                    } else {
-                        drawCube(basePosition, getColorByType(gameElement.elementType), DEFAULT_OUTLINE_COLOR);
-                    }
-                }
-            }
+    resetLodStats();
+    renderStats.drawCalls = 0;
+    renderStats.drawnVertices = 0;
+    renderStats.drawnChunks = 0;
+    renderStats.culledBlocks = 0;
+    resetFrustumStats();
+    renderStats.rebuiltMeshes += uploadFinishedMeshes(&worldState);
+
+    if (!isVisibleSetCurrent(viewportPosition, getViewportRotation(), frustum, worldState.revision, getVisibleSetSettings())) {
+        rebuildVisibleSet(frustum, viewProjection, viewportPosition, &pState);
+    }
+
+    int visibleCount;
+    const VisibleChunk* visibleChunks = getVisibleChunks(&visibleCount);
+
+    for (int i = 0; i < visibleCount; i++) {
+        drawChunk(visibleChunks[i].chunk, mode, visibleChunks[i].isInside, frustum, &pState);
+    }
+
+    if (drawCubeMeshBatch(DEFAULT_OUTLINE_COLOR)) {
+        renderStats.drawCalls++;
+    }
+
+    Vector3 lodPosition = getVisibleSetPosition();
+
+    for (int i = 0; i < worldState.columnCount; i++) {
+        ChunkColumn* column = &worldState.columns[i];
+        int level = getColumnLodLevel(column->x, column->z, lodPosition);
+
+        if (level > 0) {
+            drawColumnLod(&worldState, column, level, frustum);
         }
     }
+
+    if (mode != RENDER_MODE_CUBES) {
+        drawHighlightedBlock(&pState);
+    }
+
+    LodStats lodStats = getLodStats();
+    renderStats.drawCalls += lodStats.drawnColumns;
+    renderStats.drawnVertices += lodStats.drawnCells * 24;
 }
 
 void getGameElementsInProximity(Vector3 position, Vector3 rangeFrom, Vector3 rangeTo, GameElement** gameElements) {
@@ -288,10 +1118,8 @@ void getGameElementsInProximity(Vector3 position, Vector3 rangeFrom, Vector3 ran
                     goto end_loops;
                 }
 
-                GameElement* foundElement = getBlockAtGlobal(&worldState, ix, iy, iz);
-
-                if (foundElement != NULL) {
-                    (*gameElements)[currentGameElementIndex++] = *foundElement;
+                if (getBlockAtGlobal(&worldState, ix, iy, iz, &(*gameElements)[currentGameElementIndex])) {
+                    currentGameElementIndex++;
                 }
             }
         }
@@ -300,63 +1128,50 @@ void getGameElementsInProximity(Vector3 position, Vector3 rangeFrom, Vector3 ran
 end_loops:;
 }
 
-GameElement* getBlockAtGlobal(WorldState* worldState, int x, int y, int z) {
-    for (int i = 0; i < worldState->chunkCount; i++) {
-        Chunk* chunk = &worldState->chunks[i];
+int getBlockTypeAtGlobal(WorldState* worldState, int x, int y, int z) {
+    Chunk* chunk = getChunkAtGlobal(worldState, x, y, z);
 
-        int chunk_origin_x = (int)floor(chunk->position.x);
-        int chunk_origin_y = (int)floor(chunk->position.y);
-        int chunk_origin_z = (int)floor(chunk->position.z);
+    if (chunk == NULL) {
+        return 0;
+    }
 
-        if (x >= chunk_origin_x && x < chunk_origin_x + CHUNK_SIZE &&
-            y >= chunk_origin_y && y < chunk_origin_y + CHUNK_SIZE &&
-            z >= chunk_origin_z && z < chunk_origin_z + CHUNK_SIZE) {
-            
-            int local_x = x - chunk_origin_x;
-            int local_y = y - chunk_origin_y;
-            int local_z = z - chunk_origin_z;
+    return getChunkBlock(chunk, getLocalElementIndex(x, y, z));
+}
 
-            int index = local_x + local_y * CHUNK_SIZE + local_z * CHUNK_SIZE * CHUNK_SIZE;
+bool getBlockAtGlobal(WorldState* worldState, int x, int y, int z, GameElement* element) {
+    Chunk* chunk = getChunkAtGlobal(worldState, x, y, z);
 
-            GameElement* element = &chunk->gameElements[index];
+    if (chunk == NULL) {
+        return false;
+    }
 
-            if (element->elementType != 0) {
-                return element;
-            } else {
-                return NULL; 
-            }
-        }
+    int index = getLocalElementIndex(x, y, z);
+    int elementType = getChunkBlock(chunk, index);
+
+    if (elementType == 0) {
+        return false;
     }
-    return NULL;
+
+    element->position = getElementPosition(chunk, index);
+    element->elementType = elementType;
+    element->visibleFaces = getVisibleFaceMask(chunk, index);
+    element->isObstructed = element->visibleFaces == 0;
+    return true;
 }
 
 void destroyBlock(WorldState* ws, int x, int y, int z) {
-    GameElement* blockToDestroy = getBlockAtGlobal(ws, x, y, z);
-
-    if (blockToDestroy != NULL && blockToDestroy->elementType != 0) {
-        blockToDestroy->elementType = 0;
-
-        int dx[] = {-1, 1, 0, 0, 0, 0};
-        int dy[] = {0, 0, -1, 1, 0, 0};
-        int dz[] = {0, 0, 0, 0, -1, 1};
+    Chunk* chunk = getChunkAtGlobal(ws, x, y, z);
 
-        for (int i = 0; i < 6; i++) {
-            int neighborX = x + dx[i];
-            int neighborY = y + dy[i];
-            int neighborZ = z + dz[i];
+    if (chunk == NULL) {
+        return;
+    }
 
-            GameElement* neighborBlock = getBlockAtGlobal(ws, neighborX, neighborY, neighborZ);
+    int index = getLocalElementIndex(x, y, z);
+    int oldType = getChunkBlock(chunk, index);
 
-            if (neighborBlock != NULL && neighborBlock->elementType != 0) {
-                int solidNeighborCount = 0;
-                for (int j = 0; j < 6; j++) {
-                    GameElement* nnBlock = getBlockAtGlobal(ws, neighborX + dx[j], neighborY + dy[j], neighborZ + dz[j]);
-                    if (nnBlock != NULL && nnBlock->elementType != 0) {
-                        solidNeighborCount++;
-                    }
-                }
-                neighborBlock->isObstructed = (solidNeighborCount == 6);
-            }
-        }
+    if (oldType != 0 && setChunkBlock(ws, chunk, index, 0)) {
+        markColumnModified(ws, x, y, z, 0);
+        appendJournalEdit(x, y, z, oldType, 0);
+        markBlockDirty(ws, x, y, z);
     }
 }
@@ -1,31 +1,121 @@
 #ifndef BLOCKS_WORLD
 #define BLOCKS_WORLD
 #define CHUNK_SIZE 16
+#define CHUNK_SHIFT 4
+#define CHUNK_MASK (CHUNK_SIZE - 1)
+#define CHUNK_SECTION_COUNT 16
+#define CHUNK_MIXED -1
+#define WORLD_HEIGHT (CHUNK_SIZE * CHUNK_SECTION_COUNT)
+#define SURFACE_NONE -1
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "types.h"
 #include "frustum.h"
+#include "matrix.h"
+#include "chunkmap.h"
+#include "blockstorage.h"
 
 typedef struct GameElement {
 	Vector3 position;
 	int elementType;
 	bool isObstructed;
+	int visibleFaces;
 } GameElement;
 
 typedef struct Chunk {
-	Vector3 position;
-	GameElement* gameElements;
+	IntVector3 position;
+	int uniformType;
+	BlockStorage blocks;
+	uint16_t* solidRows;
+	uint16_t (*visibleFaces)[CHUNK_SIZE * CHUNK_SIZE];
+	int visibleFaceCount;
+	IntVector3 visibleMin;
+	IntVector3 visibleMax;
+	uint16_t dirtySlices;
+	int meshOffset;
+	int meshCapacity;
+	int meshVertexCount;
+	bool isMeshDirty;
+	int meshJob;
+	int instanceOffset;
+	int instanceCapacity;
+	int instanceCount;
+	bool isInstanceDirty;
+	int instanceJob;
+	uint64_t faceConnectivity;
+	bool hasConnectivity;
+	int reachedFrame;
+	uint8_t reachedFaces;
 } Chunk;
 
+typedef struct ChunkColumn {
+	int x;
+	int z;
+	bool isModified;
+	int revision;
+	uint64_t journalSequence;
+	Chunk sections[CHUNK_SECTION_COUNT];
+	int16_t surfaceHeights[CHUNK_SIZE * CHUNK_SIZE];
+	uint8_t surfaceTypes[CHUNK_SIZE * CHUNK_SIZE];
+	struct LodCache* lodCache;
+} ChunkColumn;
+
+typedef enum RenderMode {
+	RENDER_MODE_CUBES,
+	RENDER_MODE_MESH,
+	RENDER_MODE_INSTANCED,
+	RENDER_MODE_INDIRECT,
+	RENDER_MODE_COUNT
+} RenderMode;
+
+typedef struct RenderStats {
+	int drawCalls;
+	int drawnVertices;
+	int drawnChunks;
+	int culledChunks;
+	int culledBlocks;
+	int occludedChunks;
+	int caveCulledChunks;
+	int rebuiltMeshes;
+} RenderStats;
+
 typedef struct WorldState {
-	Chunk* chunks;
-	int chunkCount;
+	ChunkColumn* columns;
+	int columnCount;
+	int columnCapacity;
+	ChunkMap columnMap;
+	int elidedSectionCount;
+	int revision;
 } WorldState;
 
-GameElement* getBlockAtGlobal(WorldState* worldState, int x, int y, int z);
+Chunk* getChunkAt(WorldState* worldState, int chunkX, int chunkY, int chunkZ);
+ChunkColumn* getChunkColumnAt(WorldState* worldState, int columnX, int columnZ);
+ChunkColumn* addChunkColumn(WorldState* worldState, const ChunkColumn* column);
+void removeChunkColumn(WorldState* worldState, int columnX, int columnZ);
+void freeChunkColumn(ChunkColumn* column);
+void generateChunkColumn(ChunkColumn* column);
+void rebuildColumnSurface(ChunkColumn* column);
+void updateColumnSurface(ChunkColumn* column, int x, int y, int z, int blockType);
+int getSurfaceHeight(WorldState* worldState, int x, int z);
+int getSurfaceType(WorldState* worldState, int x, int z);
+void compactChunk(Chunk* chunk);
+void expandChunk(WorldState* worldState, Chunk* chunk);
+int getChunkBlock(const Chunk* chunk, int index);
+bool setChunkBlock(WorldState* worldState, Chunk* chunk, int index, int blockType);
+int getBlockTypeAtGlobal(WorldState* worldState, int x, int y, int z);
+bool getBlockAtGlobal(WorldState* worldState, int x, int y, int z, GameElement* element);
+size_t getChunkMemoryUsage(const Chunk* chunk);
+size_t getChunkColumnMemoryUsage(const ChunkColumn* column);
 void generateWorld();
+bool saveWorld();
+void queueWorldSave();
 void removeWorld();
-void drawWorld(const Frustum* frustum);
+void drawWorld(const Frustum* frustum, const Matrix4* viewProjection);
+RenderMode getRenderMode();
+void setRenderMode(RenderMode mode);
+RenderStats getRenderStats();
 void getGameElementsInProximity(Vector3 position, Vector3 rangeFrom, Vector3 rangeTo, GameElement** gameElements);
 WorldState* getWorldStateGlobal();
 void destroyBlock(WorldState* ws, int x, int y, int z);
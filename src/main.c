@@ -6,20 +6,28 @@
 __declspec(dllexport) DWORD NvOptimusEnablement = 0x00000001;
 __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 #endif
+#if !defined(__APPLE__)
 #include <GL/glew.h>
-#include <GLFW/glfw3.h>
-#include <GL/glut.h>
+#endif
 
 #include "engine/window.h"
 #include "engine/display.h"
 #include "engine/cube.h"
+#include "engine/upload.h"
+#include "engine/occlusion.h"
+#include "engine/connectivity.h"
+#include "engine/meshworkers.h"
+#include "engine/visibleset.h"
+#include "engine/hud.h"
+#include "engine/overdraw.h"
 #include "engine/userinputs.h"
+#include "engine/workers.h"
 
 int main(int argc, char** argv) {
-    glutInit(&argc, argv);
     GLFWwindow* window = initWindow(1280, 720);
 
     if (window != NULL) {
+#if !defined(__APPLE__)
         glewExperimental = GL_TRUE;
         GLenum err = glewInit();
         if (GLEW_OK != err) {
@@ -30,15 +38,30 @@ int main(int argc, char** argv) {
         }
 
         printf("Using GLEW %s\n", glewGetString(GLEW_VERSION));
+#endif
         printf("OpenGL Renderer: %s\n", (const char*)glGetString(GL_RENDERER));
         printf("OpenGL Version: %s\n", (const char*)glGetString(GL_VERSION));
 
-        initCubeVBOs();
+        if (!initCubeRenderer() || !initUploads() || !initHud() || !initOverdrawQueries()) {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+            return 1;
+        }
+
+        initWorkers(0);
 
         glfwSetMouseButtonCallback(window, processMouseButtonActions);
 
         processDisplayLoop(window);
-        freeCubeVBOs();
+        freeWorkers();
+        freeMeshWorkers();
+        freeVisibleSet();
+        freeConnectivity();
+        freeOcclusion();
+        freeHud();
+        freeOverdrawQueries();
+        freeCubeRenderer();
+        freeUploads();
 
         glfwDestroyWindow(window);
     }
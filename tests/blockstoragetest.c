@@ -0,0 +1,53 @@
+#include "testing.h"
+#include "engine/blockstorage.h"
+#include "engine/visibility.h"
+#include "engine/world.h"
+
+#include <stdlib.h>
+
+static void testFullPalette() {
+    BlockStorage storage;
+    initBlockStorage(&storage, 0);
+
+    for (int i = 0; i < 256; i++) {
+        CHECK(setStorageBlock(&storage, i, i));
+    }
+
+    CHECK(storage.bitsPerBlock == BLOCK_STORAGE_MAX_BITS);
+    CHECK(!setStorageBlock(&storage, 300, 256));
+    CHECK(getStorageBlock(&storage, 300) == 0);
+    CHECK(setStorageBlock(&storage, 300, 255));
+
+    CHECK(setStorageBlock(&storage, 1, 0));
+    CHECK(setStorageBlock(&storage, 300, 256));
+    CHECK(getStorageBlock(&storage, 300) == 256);
+
+    freeBlockStorage(&storage);
+}
+
+static void testChunkOccupancy() {
+    WorldState world = { 0 };
+    Chunk chunk = { .uniformType = 0 };
+
+    for (int i = 0; i < 256; i++) {
+        CHECK(setChunkBlock(&world, &chunk, i, i));
+    }
+
+    CHECK(!setChunkBlock(&world, &chunk, 1000, 256));
+    CHECK(getChunkBlock(&chunk, 1000) == 0);
+    CHECK(!isChunkOccupied(&chunk, 1000));
+
+    for (int i = 0; i < BLOCK_STORAGE_SIZE; i++) {
+        CHECK(isChunkOccupied(&chunk, i) == (getChunkBlock(&chunk, i) != 0));
+    }
+
+    freeBlockStorage(&chunk.blocks);
+    free(chunk.solidRows);
+}
+
+int main() {
+    testFullPalette();
+    testChunkOccupancy();
+
+    return finishTest("blockstorage");
+}
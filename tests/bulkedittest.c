@@ -0,0 +1,99 @@
+#include "testing.h"
+#include <string.h>
+#include "engine/bulkedit.h"
+#include "engine/dirty.h"
+#include "engine/journal.h"
+#include "engine/visibility.h"
+
+#define COLUMN_RADIUS 3
+#define CARVE_RADIUS 32.0
+#define TOUCHED_COLUMNS 25
+
+static void carveBlockByBlock(WorldState* world, Vector3 center, double radius) {
+    int extent = (int)radius;
+
+    for (int z = -extent; z <= extent; z++) {
+        for (int y = -extent; y <= extent; y++) {
+            for (int x = -extent; x <= extent; x++) {
+                if ((double)(x * x + y * y + z * z) <= radius * radius) {
+                    destroyBlock(world, (int)center.x + x, (int)center.y + y, (int)center.z + z);
+                }
+            }
+        }
+    }
+}
+
+static void updateWorldVisibility(WorldState* world) {
+    for (int i = 0; i < world->columnCount; i++) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            updateChunkVisibility(world, &world->columns[i].sections[section]);
+        }
+    }
+}
+
+static void compareWorlds(WorldState* first, WorldState* second) {
+    int blockMismatches = 0;
+    int faceMismatches = 0;
+
+    for (int i = 0; i < first->columnCount; i++) {
+        ChunkColumn* column = &first->columns[i];
+        ChunkColumn* other = getChunkColumnAt(second, column->x, column->z);
+
+        CHECK(memcmp(column->surfaceHeights, other->surfaceHeights, sizeof(column->surfaceHeights)) == 0);
+
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            for (int index = 0; index < BLOCK_STORAGE_SIZE; index++) {
+                blockMismatches += getChunkBlock(&column->sections[section], index)
+                    != getChunkBlock(&other->sections[section], index);
+                faceMismatches += getVisibleFaceMask(&column->sections[section], index)
+                    != getVisibleFaceMask(&other->sections[section], index);
+            }
+        }
+    }
+
+    CHECK(blockMismatches == 0);
+    CHECK(faceMismatches == 0);
+}
+
+int main() {
+    WorldState bulk = { 0 };
+    WorldState single = { 0 };
+    Vector3 center = { .x = 0.0, .y = CARVE_RADIUS, .z = 0.0 };
+
+    IntVector3 min = { .x = -(int)CARVE_RADIUS, .y = 0, .z = -(int)CARVE_RADIUS };
+    IntVector3 max = { .x = (int)CARVE_RADIUS, .y = 2 * (int)CARVE_RADIUS, .z = (int)CARVE_RADIUS };
+
+    generateTestWorld(&bulk, COLUMN_RADIUS);
+    generateTestWorld(&single, COLUMN_RADIUS);
+    updateWorldVisibility(&bulk);
+    updateWorldVisibility(&single);
+    fillBlocks(&bulk, min, max, 1);
+    processDirtyChunks(&bulk);
+    fillBlocks(&single, min, max, 1);
+    processDirtyChunks(&single);
+
+    int records = getJournalStats().journalRecords;
+    double start = getTestTime();
+    carveSphere(&bulk, center, CARVE_RADIUS);
+    processDirtyChunks(&bulk);
+    double bulkElapsed = getTestTime() - start;
+    int bulkRecords = getJournalStats().journalRecords - records;
+
+    records = getJournalStats().journalRecords;
+    start = getTestTime();
+    carveBlockByBlock(&single, center, CARVE_RADIUS);
+    processDirtyChunks(&single);
+    double singleElapsed = getTestTime() - start;
+    int singleRecords = getJournalStats().journalRecords - records;
+
+    CHECK(bulkRecords > 0 && bulkRecords <= TOUCHED_COLUMNS);
+    CHECK(singleRecords > 100000);
+    compareWorlds(&bulk, &single);
+
+    printf("  64^3 carve: %.2f ms as a bulk edit (%d journal records), %.2f ms block by block (%d journal records)\n",
+        bulkElapsed * 1e3, bulkRecords, singleElapsed * 1e3, singleRecords);
+
+    freeTestWorld(&bulk);
+    freeTestWorld(&single);
+    return finishTest("bulkedit");
+}
@@ -0,0 +1,134 @@
+#include "testing.h"
+#include "engine/chunkmap.h"
+
+#include <stdlib.h>
+
+#define KEY_COUNT 4096
+#define LOOKUP_COUNT 4000000
+#define SCAN_LOOKUP_COUNT 100000
+
+static IntVector3 getGridKey(int index) {
+    IntVector3 key = { .x = index % 16 - 8, .y = index / 16 % 16, .z = index / 256 - 8 };
+    return key;
+}
+
+static void testAgainstArray() {
+    ChunkMap map;
+    int values[KEY_COUNT];
+    unsigned int random = 1;
+
+    initChunkMap(&map, 4);
+
+    for (int i = 0; i < KEY_COUNT; i++) {
+        values[i] = CHUNK_MAP_EMPTY;
+    }
+
+    for (int step = 0; step < 200000; step++) {
+        int index = nextTestRandom(&random) % KEY_COUNT;
+        IntVector3 key = getGridKey(index);
+
+        if (nextTestRandom(&random) % 3 == 0) {
+            chunkMapRemove(&map, key);
+            values[index] = CHUNK_MAP_EMPTY;
+        } else {
+            chunkMapPut(&map, key, step);
+            values[index] = step;
+        }
+    }
+
+    int count = 0;
+    for (int i = 0; i < KEY_COUNT; i++) {
+        CHECK(chunkMapGet(&map, getGridKey(i)) == values[i]);
+        count += values[i] != CHUNK_MAP_EMPTY;
+    }
+
+    CHECK(map.count == count);
+    freeChunkMap(&map);
+}
+
+static void benchmarkChunkMap(int keyCount) {
+    ChunkMap map;
+    IntVector3* keys = malloc(LOOKUP_COUNT * sizeof(IntVector3));
+    unsigned int random = 7;
+    long sum = 0;
+    int found = 0;
+
+    initChunkMap(&map, keyCount);
+
+    for (int i = 0; i < keyCount; i++) {
+        chunkMapPut(&map, getGridKey(i), i);
+    }
+
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        keys[i] = getGridKey(nextTestRandom(&random) % keyCount);
+    }
+
+    double start = getTestTime();
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        sum += chunkMapGet(&map, keys[i]);
+    }
+    double elapsed = getTestTime() - start;
+
+    IntVector3* grid = malloc(keyCount * sizeof(IntVector3));
+    for (int i = 0; i < keyCount; i++) {
+        grid[i] = getGridKey(i);
+    }
+
+    start = getTestTime();
+    for (int i = 0; i < SCAN_LOOKUP_COUNT; i++) {
+        for (int j = 0; j < keyCount; j++) {
+            if (grid[j].x == keys[i].x && grid[j].y == keys[i].y && grid[j].z == keys[i].z) {
+                found++;
+                break;
+            }
+        }
+    }
+    double scanElapsed = getTestTime() - start;
+
+    CHECK(sum >= 0);
+    CHECK(found == SCAN_LOOKUP_COUNT);
+    printf("  %4d chunks: %.1f ns per map lookup, %.1f ns per linear scan\n", keyCount,
+        elapsed * 1e9 / LOOKUP_COUNT, scanElapsed * 1e9 / SCAN_LOOKUP_COUNT);
+
+    free(grid);
+    free(keys);
+    freeChunkMap(&map);
+}
+
+static void benchmarkBlockLookup(int columnRadius) {
+    WorldState world = { 0 };
+    unsigned int random = 11;
+    int width = (columnRadius * 2 + 1) * CHUNK_SIZE;
+    long solidCount = 0;
+
+    generateTestWorld(&world, columnRadius);
+
+    double start = getTestTime();
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        int x = (int)(nextTestRandom(&random) % width) - columnRadius * CHUNK_SIZE;
+        int z = (int)(nextTestRandom(&random) % width) - columnRadius * CHUNK_SIZE;
+        int y = (int)(nextTestRandom(&random) % 16);
+        solidCount += getBlockTypeAtGlobal(&world, x, y, z) != 0;
+    }
+    double elapsed = getTestTime() - start;
+
+    CHECK(solidCount > 0);
+    printf("  %4d chunks: %.1f ns per getBlockTypeAtGlobal\n", world.columnCount * CHUNK_SECTION_COUNT,
+        elapsed * 1e9 / LOOKUP_COUNT);
+
+    freeTestWorld(&world);
+}
+
+int main() {
+    testAgainstArray();
+
+    benchmarkChunkMap(36);
+    benchmarkChunkMap(256);
+    benchmarkChunkMap(1024);
+    benchmarkChunkMap(4096);
+
+    benchmarkBlockLookup(1);
+    benchmarkBlockLookup(7);
+
+    return finishTest("chunkmap");
+}
@@ -0,0 +1,168 @@
+#include <string.h>
+#include "testing.h"
+#include "engine/constants.h"
+#include "engine/connectivity.h"
+#include "engine/bulkedit.h"
+
+#define REBUILD_COUNT 2000
+
+static uint16_t solidRows[CHUNK_ROW_COUNT];
+
+static Chunk createSolidChunk() {
+    Chunk chunk = { .uniformType = CHUNK_MIXED, .solidRows = solidRows };
+
+    memset(solidRows, 0xFF, sizeof(solidRows));
+    return chunk;
+}
+
+static void carveCell(int x, int y, int z) {
+    solidRows[y + z * CHUNK_SIZE] &= (uint16_t)~(1u << x);
+}
+
+static void testSlab() {
+    Chunk chunk = createSolidChunk();
+
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            carveCell(x, 8, z);
+        }
+    }
+
+    updateChunkConnectivity(&chunk);
+    CHECK(areChunkFacesConnected(&chunk, BLOCK_FACE_LEFT, BLOCK_FACE_RIGHT));
+    CHECK(areChunkFacesConnected(&chunk, BLOCK_FACE_FRONT, BLOCK_FACE_LEFT));
+    CHECK(!areChunkFacesConnected(&chunk, BLOCK_FACE_TOP, BLOCK_FACE_BOTTOM));
+    CHECK(!areChunkFacesConnected(&chunk, BLOCK_FACE_TOP, BLOCK_FACE_LEFT));
+}
+
+static void testShaftAndTunnel() {
+    Chunk chunk = createSolidChunk();
+
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        carveCell(3, y, 3);
+    }
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        carveCell(x, 12, 10);
+    }
+
+    updateChunkConnectivity(&chunk);
+    CHECK(areChunkFacesConnected(&chunk, BLOCK_FACE_TOP, BLOCK_FACE_BOTTOM));
+    CHECK(areChunkFacesConnected(&chunk, BLOCK_FACE_BOTTOM, BLOCK_FACE_TOP));
+    CHECK(areChunkFacesConnected(&chunk, BLOCK_FACE_LEFT, BLOCK_FACE_RIGHT));
+    CHECK(!areChunkFacesConnected(&chunk, BLOCK_FACE_TOP, BLOCK_FACE_RIGHT));
+    CHECK(!areChunkFacesConnected(&chunk, BLOCK_FACE_FRONT, BLOCK_FACE_BACK));
+
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        carveCell(i, i, 3);
+        carveCell(i < CHUNK_MASK ? i + 1 : i, i, 3);
+    }
+
+    updateChunkConnectivity(&chunk);
+    CHECK(areChunkFacesConnected(&chunk, BLOCK_FACE_TOP, BLOCK_FACE_RIGHT));
+    CHECK(areChunkFacesConnected(&chunk, BLOCK_FACE_BOTTOM, BLOCK_FACE_LEFT));
+    CHECK(!areChunkFacesConnected(&chunk, BLOCK_FACE_TOP, BLOCK_FACE_FRONT));
+}
+
+static void testSealedPocket() {
+    Chunk chunk = createSolidChunk();
+
+    for (int z = 4; z < 12; z++) {
+        for (int y = 4; y < 12; y++) {
+            for (int x = 4; x < 12; x++) {
+                carveCell(x, y, z);
+            }
+        }
+    }
+
+    updateChunkConnectivity(&chunk);
+    CHECK(chunk.faceConnectivity == CONNECTIVITY_NONE);
+}
+
+static void testUniformChunks() {
+    Chunk air = { .uniformType = 0 };
+    Chunk solid = { .uniformType = 1 };
+
+    CHECK(areChunkFacesConnected(&air, BLOCK_FACE_TOP, BLOCK_FACE_BOTTOM));
+    CHECK(air.faceConnectivity == CONNECTIVITY_ALL);
+    CHECK(!areChunkFacesConnected(&solid, BLOCK_FACE_TOP, BLOCK_FACE_BOTTOM));
+    CHECK(solid.faceConnectivity == CONNECTIVITY_NONE);
+}
+
+static void findChunksFromAbove(WorldState* world) {
+    Vector3 eye = { .x = 8.0, .y = 80.0, .z = 8.0 };
+    Vector3 center = { .x = 8.0, .y = 0.0, .z = 8.0 };
+    Vector3 up = { .x = 0.0, .y = 0.0, .z = -1.0 };
+    Matrix4 viewProjection = multiplyMatrices(getPerspectiveMatrix(90, 1.0, 0.1, 256.0), getLookAtMatrix(eye, center, up));
+    Frustum frustum;
+
+    extractFrustumPlanes(&frustum, &viewProjection);
+    findReachableChunks(world, eye, &frustum, 1);
+}
+
+static void testBuriedCave() {
+    WorldState world = { 0 };
+    IntVector3 min = { .x = -CHUNK_SIZE, .y = 0, .z = -CHUNK_SIZE };
+    IntVector3 max = { .x = CHUNK_SIZE * 2 - 1, .y = CHUNK_SIZE * 3 - 1, .z = CHUNK_SIZE * 2 - 1 };
+    Vector3 caveCenter = { .x = 8.0, .y = 24.0, .z = 8.0 };
+
+    generateTestWorld(&world, 1);
+    fillBlocks(&world, min, max, 1);
+    carveSphere(&world, caveCenter, 4.0);
+
+    Chunk* cave = getChunkAt(&world, 0, 1, 0);
+    Chunk* sky = getChunkAt(&world, 0, 4, 0);
+
+    findChunksFromAbove(&world);
+    CHECK(isChunkReachable(sky));
+    CHECK(isChunkReachable(getChunkAt(&world, 0, 2, 0)));
+    CHECK(!isChunkReachable(cave));
+    CHECK(!isChunkReachable(getChunkAt(&world, 0, 0, 0)));
+    int sealedReached = getConnectivityStats().reachedChunks;
+
+    for (int y = CHUNK_SIZE * 3 - 1; y >= 26; y--) {
+        destroyBlock(&world, 8, y, 8);
+    }
+
+    findChunksFromAbove(&world);
+    CHECK(isChunkReachable(cave));
+    CHECK(!isChunkReachable(getChunkAt(&world, 0, 0, 0)));
+    CHECK(getConnectivityStats().reachedChunks == sealedReached + 1);
+
+    setCaveCullingEnabled(false);
+    findChunksFromAbove(&world);
+    CHECK(isChunkReachable(getChunkAt(&world, 0, 0, 0)));
+    setCaveCullingEnabled(true);
+
+    freeTestWorld(&world);
+}
+
+static void benchmarkRebuild() {
+    unsigned int random = 11;
+    Chunk chunk = createSolidChunk();
+    int connected = 0;
+
+    double start = getTestTime();
+    for (int i = 0; i < REBUILD_COUNT; i++) {
+        for (int row = 0; row < CHUNK_ROW_COUNT; row++) {
+            solidRows[row] = (uint16_t)(nextTestRandom(&random) | nextTestRandom(&random));
+        }
+
+        updateChunkConnectivity(&chunk);
+        connected += areChunkFacesConnected(&chunk, BLOCK_FACE_TOP, BLOCK_FACE_BOTTOM);
+    }
+    double elapsed = getTestTime() - start;
+
+    CHECK(connected > 0);
+    printf("  %.1f us per updateChunkConnectivity on a porous chunk\n", elapsed * 1e6 / REBUILD_COUNT);
+}
+
+int main() {
+    testSlab();
+    testShaftAndTunnel();
+    testSealedPocket();
+    testUniformChunks();
+    testBuriedCave();
+    benchmarkRebuild();
+    freeConnectivity();
+    return finishTest("connectivity");
+}
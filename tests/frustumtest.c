@@ -0,0 +1,211 @@
+#include <math.h>
+#include "testing.h"
+#include "engine/frustum.h"
+#include "engine/visibility.h"
+
+#define COLUMN_RADIUS 7
+#define FRAME_COUNT 16
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define popcount16(value) ((int)__popcnt16(value))
+#else
+#define popcount16(value) __builtin_popcount(value)
+#endif
+
+typedef struct CullResult {
+    int visibleBlocks;
+    int aabbTests;
+    double elapsed;
+} CullResult;
+
+static Frustum getFrameFrustum(int frame) {
+    double yaw = frame * 2.0 * M_PI / FRAME_COUNT;
+    Vector3 eye = { .x = 8.0, .y = 20.0, .z = 8.0 };
+    Vector3 center = { .x = eye.x + sin(yaw), .y = eye.y - 0.3, .z = eye.z - cos(yaw) };
+    Vector3 up = { .x = 0.0, .y = 1.0, .z = 0.0 };
+    Matrix4 viewProjection = multiplyMatrices(getPerspectiveMatrix(60, 16.0 / 9.0, 0.1, 96.0), getLookAtMatrix(eye, center, up));
+    Frustum frustum;
+
+    extractFrustumPlanes(&frustum, &viewProjection);
+    return frustum;
+}
+
+static bool isChunkBlockSolid(const Chunk* chunk, int x, int y, int z) {
+    if (chunk->uniformType != CHUNK_MIXED) {
+        return chunk->uniformType != 0;
+    }
+
+    return (chunk->solidRows[y + z * CHUNK_SIZE] >> x) & 1;
+}
+
+static Vector3 getBlockBase(const Chunk* chunk, int x, int y, int z) {
+    Vector3 base = {
+        .x = chunk->position.x * CHUNK_SIZE + x,
+        .y = chunk->position.y * CHUNK_SIZE + y,
+        .z = chunk->position.z * CHUNK_SIZE + z
+    };
+    return base;
+}
+
+static int cullBlocksPerBlock(WorldState* world, const Frustum* frustum) {
+    int visible = 0;
+
+    for (int i = 0; i < world->columnCount; i++) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            const Chunk* chunk = &world->columns[i].sections[section];
+
+            if (chunk->uniformType == 0) {
+                continue;
+            }
+
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                for (int y = 0; y < CHUNK_SIZE; y++) {
+                    for (int x = 0; x < CHUNK_SIZE; x++) {
+                        if (!isChunkBlockSolid(chunk, x, y, z)) {
+                            continue;
+                        }
+
+                        Vector3 center;
+                        Vector3 extents;
+                        getCubeAABB(getBlockBase(chunk, x, y, z), &center, &extents);
+                        visible += isAABBInFrustum(frustum, &center, &extents);
+                    }
+                }
+            }
+        }
+    }
+
+    return visible;
+}
+
+static int cullChunkBlocks(const Chunk* chunk, const Frustum* frustum) {
+    float centers[12];
+    float extents[12];
+    int batchCount = 0;
+    int visible = 0;
+
+    for (int lane = 0; lane < 12; lane++) {
+        extents[lane] = 0.5f;
+    }
+
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                if (!isChunkBlockSolid(chunk, x, y, z)) {
+                    continue;
+                }
+
+                Vector3 center;
+                Vector3 blockExtents;
+                getCubeAABB(getBlockBase(chunk, x, y, z), &center, &blockExtents);
+                centers[batchCount] = (float)center.x;
+                centers[batchCount + 4] = (float)center.y;
+                centers[batchCount + 8] = (float)center.z;
+
+                if (++batchCount == 4) {
+                    int insideMask;
+                    visible += popcount16(classifyAABBsInFrustum4(frustum, centers, extents, &insideMask));
+                    batchCount = 0;
+                }
+            }
+        }
+    }
+
+    for (int lane = 0; lane < batchCount; lane++) {
+        Vector3 center = { .x = centers[lane], .y = centers[lane + 4], .z = centers[lane + 8] };
+        Vector3 blockExtents = { .x = 0.5, .y = 0.5, .z = 0.5 };
+        visible += isAABBInFrustum(frustum, &center, &blockExtents);
+    }
+
+    return visible;
+}
+
+static int countSolidBlocks(const Chunk* chunk) {
+    if (chunk->uniformType != CHUNK_MIXED) {
+        return chunk->uniformType != 0 ? CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE : 0;
+    }
+
+    int count = 0;
+
+    for (int row = 0; row < CHUNK_ROW_COUNT; row++) {
+        count += popcount16(chunk->solidRows[row]);
+    }
+
+    return count;
+}
+
+static int cullBlocksHierarchical(WorldState* world, const Frustum* frustum) {
+    Vector3 extents = { .x = CHUNK_SIZE * 0.5, .y = CHUNK_SIZE * 0.5, .z = CHUNK_SIZE * 0.5 };
+    int visible = 0;
+
+    for (int i = 0; i < world->columnCount; i++) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            const Chunk* chunk = &world->columns[i].sections[section];
+
+            if (chunk->uniformType == 0) {
+                continue;
+            }
+
+            Vector3 center = {
+                .x = (chunk->position.x + 0.5) * CHUNK_SIZE,
+                .y = (chunk->position.y + 0.5) * CHUNK_SIZE - 1.5,
+                .z = (chunk->position.z + 0.5) * CHUNK_SIZE
+            };
+            FrustumClass chunkClass = classifyAABBInFrustum(frustum, &center, &extents);
+
+            if (chunkClass == FRUSTUM_INSIDE) {
+                visible += countSolidBlocks(chunk);
+            } else if (chunkClass == FRUSTUM_INTERSECTS) {
+                visible += cullChunkBlocks(chunk, frustum);
+            }
+        }
+    }
+
+    return visible;
+}
+
+static CullResult runFrames(WorldState* world, int (*cull)(WorldState*, const Frustum*), int* visibleBlocks) {
+    CullResult result = { 0 };
+
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        Frustum frustum = getFrameFrustum(frame);
+
+        resetFrustumStats();
+        double start = getTestTime();
+        visibleBlocks[frame] = cull(world, &frustum);
+        result.elapsed += getTestTime() - start;
+        result.visibleBlocks += visibleBlocks[frame];
+        result.aabbTests += getFrustumStats().aabbTests;
+    }
+
+    return result;
+}
+
+int main() {
+    WorldState world = { 0 };
+    int perBlockVisible[FRAME_COUNT];
+    int hierarchicalVisible[FRAME_COUNT];
+    int mismatches = 0;
+
+    generateTestWorld(&world, COLUMN_RADIUS);
+
+    CullResult perBlock = runFrames(&world, cullBlocksPerBlock, perBlockVisible);
+    CullResult hierarchical = runFrames(&world, cullBlocksHierarchical, hierarchicalVisible);
+
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        mismatches += perBlockVisible[frame] != hierarchicalVisible[frame];
+    }
+
+    CHECK(mismatches == 0);
+    CHECK(perBlock.visibleBlocks > 0);
+    CHECK(hierarchical.aabbTests < perBlock.aabbTests / 4);
+
+    printf("  %d visible blocks per frame: per-block loop %.2f ms (%d tests), hierarchical %.2f ms (%d tests)\n",
+        perBlock.visibleBlocks / FRAME_COUNT,
+        perBlock.elapsed * 1e3 / FRAME_COUNT, perBlock.aabbTests / FRAME_COUNT,
+        hierarchical.elapsed * 1e3 / FRAME_COUNT, hierarchical.aabbTests / FRAME_COUNT);
+
+    freeTestWorld(&world);
+    return finishTest("frustum");
+}
@@ -0,0 +1,237 @@
+#include "testing.h"
+#include "engine/journal.h"
+#include "engine/region.h"
+#include "engine/streaming.h"
+#include "engine/viewport.h"
+#include "engine/workers.h"
+#include "engine/bulkedit.h"
+
+#include <math.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define EDITS_PER_FRAME 100
+#define COMPACTED_EDITS 10000
+#define TAIL_EDITS 500
+#define MAX_FRAMES 100000
+#define EDITED_BLOCKS (3 * CHUNK_SIZE * WORLD_HEIGHT * 3 * CHUNK_SIZE)
+
+static int centerX = 0;
+static int centerZ = 0;
+
+static void applyRandomEdits(WorldState* world, unsigned int* random, int count) {
+    int width = 3 * CHUNK_SIZE;
+
+    for (int i = 0; i < count; i++) {
+        int x = (centerX - 1) * CHUNK_SIZE + (int)(nextTestRandom(random) % width);
+        int y = (int)(nextTestRandom(random) % 32);
+        int z = (centerZ - 1) * CHUNK_SIZE + (int)(nextTestRandom(random) % width);
+
+        int kind = (int)(nextTestRandom(random) % 500);
+
+        if (kind == 0) {
+            Vector3 center = { .x = x, .y = y, .z = z };
+            carveSphere(world, center, 3.0);
+        } else if (kind == 1) {
+            IntVector3 min = { .x = x - 2, .y = y, .z = z - 2 };
+            IntVector3 max = { .x = x + 2, .y = y + 4, .z = z + 2 };
+            replaceBlocks(world, min, max, 1 + (int)(nextTestRandom(random) % 5), 1 + (int)(nextTestRandom(random) % 5));
+        } else if (getBlockTypeAtGlobal(world, x, y, z) != 0) {
+            destroyBlock(world, x, y, z);
+        } else {
+            placeBlock(world, x, y, z, 1 + (int)(nextTestRandom(random) % 5));
+        }
+    }
+}
+
+static void fillReplacedBox(WorldState* world) {
+    IntVector3 min = { .x = centerX * CHUNK_SIZE + 2, .y = 4, .z = centerZ * CHUNK_SIZE + 2 };
+    IntVector3 max = { .x = centerX * CHUNK_SIZE + 8, .y = 10, .z = centerZ * CHUNK_SIZE + 8 };
+    fillBlocks(world, min, max, 3);
+
+    max.y = 6;
+    fillBlocks(world, min, max, 1);
+}
+
+static void replaceBoxTwice(WorldState* world) {
+    IntVector3 min = { .x = centerX * CHUNK_SIZE + 2, .y = 4, .z = centerZ * CHUNK_SIZE + 2 };
+    IntVector3 max = { .x = centerX * CHUNK_SIZE + 8, .y = 10, .z = centerZ * CHUNK_SIZE + 8 };
+    replaceBlocks(world, min, max, 1, 2);
+    replaceBlocks(world, min, max, 3, 1);
+}
+
+static void saveModifiedColumns(WorldState* world) {
+    for (int i = 0; i < world->columnCount; i++) {
+        if (world->columns[i].isModified) {
+            queueChunkColumnSave(world, &world->columns[i]);
+        }
+    }
+
+    finishChunkColumnSaves();
+}
+
+static void flushJournalFrames() {
+    for (int frame = 0; frame < MAX_FRAMES && getJournalStats().bufferedRecords > 0; frame++) {
+        updateJournal();
+        usleep(100);
+    }
+}
+
+static double runEditFrames(unsigned int* random, int count) {
+    double maxFrame = 0.0;
+
+    for (int edits = 0; edits < count; edits += EDITS_PER_FRAME) {
+        applyRandomEdits(getWorldStateGlobal(), random, EDITS_PER_FRAME);
+
+        double start = getTestTime();
+        updateJournal();
+        double elapsed = getTestTime() - start;
+
+        maxFrame = elapsed > maxFrame ? elapsed : maxFrame;
+    }
+
+    return maxFrame;
+}
+
+static void runEditingSession() {
+    unsigned int random = 29;
+
+    initJournal();
+    generateWorld();
+
+    double asyncStall = runEditFrames(&random, COMPACTED_EDITS);
+
+    for (int frame = 0; frame < MAX_FRAMES && getJournalStats().compactions == 0; frame++) {
+        updateJournal();
+        usleep(100);
+    }
+
+    int compactions = getJournalStats().compactions;
+    CHECK(compactions >= 1);
+
+    applyRandomEdits(getWorldStateGlobal(), &random, COMPACTED_EDITS);
+    fillReplacedBox(getWorldStateGlobal());
+    double start = getTestTime();
+    compactJournal();
+    double syncStall = getTestTime() - start;
+
+    CHECK(getJournalStats().compactions == compactions + 1);
+
+    runEditFrames(&random, TAIL_EDITS);
+    replaceBoxTwice(getWorldStateGlobal());
+    flushJournalFrames();
+    saveModifiedColumns(getWorldStateGlobal());
+
+    runEditFrames(&random, TAIL_EDITS);
+    flushJournalFrames();
+
+    CHECK(getJournalStats().bufferedRecords == 0);
+    CHECK(getJournalStats().failedWrites == 0);
+    printf("  %d edits: %d background compactions with a %.2f ms worst frame, %.2f ms for a blocking compaction\n",
+        COMPACTED_EDITS, compactions, asyncStall * 1e3, syncStall * 1e3);
+
+    freeWorkers();
+    fflush(stdout);
+    _exit(testFailures > 0);
+}
+
+static void readRegionBlocks(uint8_t* blocks) {
+    for (int x = 0; x < 3 * CHUNK_SIZE; x++) {
+        for (int y = 0; y < WORLD_HEIGHT; y++) {
+            for (int z = 0; z < 3 * CHUNK_SIZE; z++) {
+                *blocks++ = (uint8_t)getBlockTypeAtGlobal(getWorldStateGlobal(),
+                    (centerX - 1) * CHUNK_SIZE + x, y, (centerZ - 1) * CHUNK_SIZE + z);
+            }
+        }
+    }
+}
+
+static void writeExpectedBlocks() {
+    static uint8_t expected[EDITED_BLOCKS];
+    unsigned int random = 29;
+
+    generateWorld();
+    applyRandomEdits(getWorldStateGlobal(), &random, COMPACTED_EDITS * 2);
+    fillReplacedBox(getWorldStateGlobal());
+    applyRandomEdits(getWorldStateGlobal(), &random, TAIL_EDITS);
+    replaceBoxTwice(getWorldStateGlobal());
+    applyRandomEdits(getWorldStateGlobal(), &random, TAIL_EDITS);
+    readRegionBlocks(expected);
+
+    FILE* file = fopen("expected.bin", "wb");
+    bool isWritten = file != NULL && fwrite(expected, sizeof(expected), 1, file) == 1;
+
+    if (file != NULL) {
+        fclose(file);
+    }
+
+    freeWorkers();
+    _exit(!isWritten);
+}
+
+static void checkReplayedWorld() {
+    static uint8_t expected[EDITED_BLOCKS];
+    static uint8_t replayed[EDITED_BLOCKS];
+    FILE* file = fopen("expected.bin", "rb");
+
+    CHECK(file != NULL && fread(expected, sizeof(expected), 1, file) == 1);
+    if (file != NULL) {
+        fclose(file);
+    }
+
+    StreamingConfig config = getChunkStreamingConfig();
+    config.loadRadius = 0;
+    setChunkStreamingConfig(config);
+
+    initJournal();
+    generateWorld();
+    CHECK(getJournalStats().replayedRecords > 0);
+    closeJournal();
+    removeWorld();
+
+    config.loadRadius = 1;
+    setChunkStreamingConfig(config);
+
+    initJournal();
+    generateWorld();
+    readRegionBlocks(replayed);
+
+    int mismatches = 0;
+    for (int i = 0; i < EDITED_BLOCKS; i++) {
+        mismatches += expected[i] != replayed[i];
+    }
+
+    CHECK(mismatches == 0);
+    CHECK(getRegionStats().loadedColumns > 0);
+}
+
+static void runChild(void (*task)()) {
+    int status = 0;
+    pid_t child = fork();
+
+    if (child == 0) {
+        task();
+    }
+
+    waitpid(child, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+int main() {
+    Vector3 position = getViewportPosition();
+    StreamingConfig config = getChunkStreamingConfig();
+
+    centerX = (int)floor(position.x) >> CHUNK_SHIFT;
+    centerZ = (int)floor(position.z) >> CHUNK_SHIFT;
+    config.loadRadius = 1;
+    setChunkStreamingConfig(config);
+
+    runChild(writeExpectedBlocks);
+    runChild(runEditingSession);
+    checkReplayedWorld();
+
+    closeJournal();
+    removeWorld();
+    freeWorkers();
+    return finishTest("journal");
+}
@@ -0,0 +1,70 @@
+#include "testing.h"
+#include "engine/noise.h"
+
+#include <math.h>
+
+#define TEST_COLUMNS 4096
+#define BENCHMARK_COLUMNS 200000
+#define HEIGHT_TOLERANCE 1e-4f
+
+static void testKernel(const char* name) {
+    static float heights[NOISE_HEIGHTMAP_SIZE * NOISE_HEIGHTMAP_SIZE];
+    unsigned int random = 3;
+    float maxError = 0.0f;
+    int roundingMismatches = 0;
+
+    if (!selectNoiseKernel(name)) {
+        printf("  %s: not supported\n", name);
+        return;
+    }
+
+    for (int i = 0; i < TEST_COLUMNS; i++) {
+        int originX = ((int)(nextTestRandom(&random) % 20000) - 10000) * NOISE_HEIGHTMAP_SIZE;
+        int originZ = ((int)(nextTestRandom(&random) % 20000) - 10000) * NOISE_HEIGHTMAP_SIZE;
+
+        fillNoiseHeightmap(originX, originZ, heights);
+
+        for (int z = 0; z < NOISE_HEIGHTMAP_SIZE; z++) {
+            for (int x = 0; x < NOISE_HEIGHTMAP_SIZE; x++) {
+                float expected = valueNoise2d((float)(originX + x), (float)(originZ + z));
+                float height = heights[x + z * NOISE_HEIGHTMAP_SIZE];
+                float error = fabsf(height - expected);
+
+                if (error > maxError) {
+                    maxError = error;
+                }
+
+                float scaled = expected * 10.0f;
+                bool nearHalf = fabsf(scaled - floorf(scaled) - 0.5f) <= HEIGHT_TOLERANCE * 10.0f;
+
+                if (roundf(height * 10.0f) != roundf(scaled) && !nearHalf) {
+                    roundingMismatches++;
+                }
+            }
+        }
+    }
+
+    CHECK(maxError <= HEIGHT_TOLERANCE);
+    CHECK(roundingMismatches == 0);
+
+    double start = getTestTime();
+    float sum = 0.0f;
+    for (int i = 0; i < BENCHMARK_COLUMNS; i++) {
+        fillNoiseHeightmap(i * NOISE_HEIGHTMAP_SIZE, (i / 64) * NOISE_HEIGHTMAP_SIZE, heights);
+        sum += heights[i & (NOISE_HEIGHTMAP_SIZE * NOISE_HEIGHTMAP_SIZE - 1)];
+    }
+    double elapsed = getTestTime() - start;
+
+    CHECK(!isnan(sum));
+    printf("  %s: max error %.2g, %.0f columns per second\n", name, maxError, BENCHMARK_COLUMNS / elapsed);
+}
+
+int main() {
+    testKernel("scalar");
+    testKernel("sse2");
+    testKernel("avx2");
+
+    CHECK(!selectNoiseKernel("unknown"));
+
+    return finishTest("noise");
+}
@@ -0,0 +1,201 @@
+#include <math.h>
+#include "testing.h"
+#include "engine/constants.h"
+#include "engine/occlusion.h"
+#include "engine/workers.h"
+#include "engine/noise.h"
+#include "engine/bulkedit.h"
+
+#define COLUMN_RADIUS 7
+#define OCCLUDER_RADIUS 3
+#define CELL_SIZE 4
+#define CELL_COUNT (CHUNK_SIZE / CELL_SIZE)
+#define CELL_WIDTH ((OCCLUDER_RADIUS * 2 + 1) * CELL_COUNT)
+#define FRAME_COUNT 64
+
+static Matrix4 getViewProjection(Vector3 eye, double yaw) {
+    Vector3 center = { .x = eye.x + sin(yaw), .y = eye.y - 0.2, .z = eye.z - cos(yaw) };
+    Vector3 up = { .x = 0.0, .y = 1.0, .z = 0.0 };
+
+    return multiplyMatrices(getPerspectiveMatrix(60, 2.0, 0.1, 256.0), getLookAtMatrix(eye, center, up));
+}
+
+static void testKnownOccluder() {
+    Vector3 eye = { .x = 0.0, .y = 0.0, .z = 0.0 };
+    Vector3 center = { .x = 0.0, .y = 0.0, .z = -1.0 };
+    Vector3 up = { .x = 0.0, .y = 1.0, .z = 0.0 };
+    Matrix4 viewProjection = multiplyMatrices(getPerspectiveMatrix(60, 2.0, 0.1, 256.0), getLookAtMatrix(eye, center, up));
+    Vector3 wallMin = { .x = -10.0, .y = -10.0, .z = -21.0 };
+    Vector3 wallMax = { .x = 10.0, .y = 10.0, .z = -20.0 };
+    Vector3 extents = { .x = 2.0, .y = 2.0, .z = 2.0 };
+    Vector3 behind = { .x = 0.0, .y = 0.0, .z = -40.0 };
+    Vector3 inFront = { .x = 0.0, .y = 0.0, .z = -10.0 };
+    Vector3 straddling = { .x = 20.0, .y = 0.0, .z = -40.0 };
+    Vector3 beside = { .x = 25.0, .y = 0.0, .z = -40.0 };
+
+    beginOcclusionFrame(&viewProjection);
+    addOccluderBox(wallMin, wallMax, OCCLUSION_FACE_ALL);
+    CHECK(!isAABBOccluded(&behind, &extents));
+
+    rasterizeOccluders();
+    CHECK(isAABBOccluded(&behind, &extents));
+    CHECK(!isAABBOccluded(&inFront, &extents));
+    CHECK(!isAABBOccluded(&straddling, &extents));
+    CHECK(!isAABBOccluded(&beside, &extents));
+
+    OcclusionStats stats = getOcclusionStats();
+    CHECK(stats.occluderBoxes == 1);
+    CHECK(stats.testedBoxes == 4);
+    CHECK(stats.occludedBoxes == 1);
+
+    setOcclusionEnabled(false);
+    CHECK(!isAABBOccluded(&behind, &extents));
+    setOcclusionEnabled(true);
+}
+
+static void raiseHills(WorldState* world) {
+    int extent = COLUMN_RADIUS * CHUNK_SIZE;
+
+    for (int z = -extent; z < extent + CHUNK_SIZE; z += CELL_SIZE) {
+        for (int x = -extent; x < extent + CHUNK_SIZE; x += CELL_SIZE) {
+            IntVector3 min = { .x = x, .y = 0, .z = z };
+            IntVector3 max = {
+                .x = x + CELL_SIZE - 1,
+                .y = (int)(24.0 + 20.0 * sin(x / 23.0) * cos(z / 17.0)),
+                .z = z + CELL_SIZE - 1
+            };
+            fillBlocks(world, min, max, 1);
+        }
+    }
+}
+
+static int getCellTop(WorldState* world, int x, int z) {
+    for (int y = 0; y < WORLD_HEIGHT; y++) {
+        for (int cellZ = z; cellZ < z + CELL_SIZE; cellZ++) {
+            for (int cellX = x; cellX < x + CELL_SIZE; cellX++) {
+                if (getBlockTypeAtGlobal(world, cellX, y, cellZ) == 0) {
+                    return y - 1;
+                }
+            }
+        }
+    }
+
+    return WORLD_HEIGHT - 1;
+}
+
+static void addTerrainOccluders(const int* tops) {
+    for (int cellZ = 0; cellZ < CELL_WIDTH; cellZ++) {
+        for (int cellX = 0; cellX < CELL_WIDTH; cellX++) {
+            int top = tops[cellX + cellZ * CELL_WIDTH];
+
+            if (top < 0) {
+                continue;
+            }
+
+            int faceMask = 1 << BLOCK_FACE_TOP;
+
+            if (cellX == CELL_WIDTH - 1 || tops[cellX + 1 + cellZ * CELL_WIDTH] < top) {
+                faceMask |= 1 << BLOCK_FACE_RIGHT;
+            }
+            if (cellX == 0 || tops[cellX - 1 + cellZ * CELL_WIDTH] < top) {
+                faceMask |= 1 << BLOCK_FACE_LEFT;
+            }
+            if (cellZ == CELL_WIDTH - 1 || tops[cellX + (cellZ + 1) * CELL_WIDTH] < top) {
+                faceMask |= 1 << BLOCK_FACE_FRONT;
+            }
+            if (cellZ == 0 || tops[cellX + (cellZ - 1) * CELL_WIDTH] < top) {
+                faceMask |= 1 << BLOCK_FACE_BACK;
+            }
+
+            Vector3 min = {
+                .x = (cellX - OCCLUDER_RADIUS * CELL_COUNT) * CELL_SIZE,
+                .y = -1.5,
+                .z = (cellZ - OCCLUDER_RADIUS * CELL_COUNT) * CELL_SIZE
+            };
+            Vector3 max = { .x = min.x + CELL_SIZE, .y = top - 0.5, .z = min.z + CELL_SIZE };
+            addOccluderBox(min, max, faceMask);
+        }
+    }
+}
+
+static int testTerrainChunks(WorldState* world) {
+    Vector3 extents = { .x = CHUNK_SIZE * 0.5, .y = CHUNK_SIZE * 0.5, .z = CHUNK_SIZE * 0.5 };
+    int occluded = 0;
+
+    for (int i = 0; i < world->columnCount; i++) {
+        ChunkColumn* column = &world->columns[i];
+
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            if (column->sections[section].uniformType == 0) {
+                continue;
+            }
+
+            Vector3 center = {
+                .x = (column->x + 0.5) * CHUNK_SIZE,
+                .y = (section + 0.5) * CHUNK_SIZE - 1.5,
+                .z = (column->z + 0.5) * CHUNK_SIZE
+            };
+            occluded += isAABBOccluded(&center, &extents);
+        }
+    }
+
+    return occluded;
+}
+
+static void benchmarkHillyTerrain() {
+    static const int threadCounts[] = { 1, 4 };
+    static int tops[CELL_WIDTH * CELL_WIDTH];
+    WorldState world = { 0 };
+
+    generateTestWorld(&world, COLUMN_RADIUS);
+    raiseHills(&world);
+
+    for (int cellZ = 0; cellZ < CELL_WIDTH; cellZ++) {
+        for (int cellX = 0; cellX < CELL_WIDTH; cellX++) {
+            tops[cellX + cellZ * CELL_WIDTH] = getCellTop(&world,
+                (cellX - OCCLUDER_RADIUS * CELL_COUNT) * CELL_SIZE, (cellZ - OCCLUDER_RADIUS * CELL_COUNT) * CELL_SIZE);
+        }
+    }
+
+    Vector3 eye = { .x = 8.0, .y = getSurfaceHeight(&world, 8, 8) + 2.5, .z = 8.0 };
+
+    for (int t = 0; t < 2; t++) {
+        initWorkers(threadCounts[t]);
+
+        double rasterTime = 0.0;
+        double testTime = 0.0;
+        int tested = 0;
+        int occluded = 0;
+
+        for (int frame = 0; frame < FRAME_COUNT; frame++) {
+            Matrix4 viewProjection = getViewProjection(eye, frame * 2.0 * M_PI / FRAME_COUNT);
+
+            double start = getTestTime();
+            beginOcclusionFrame(&viewProjection);
+            addTerrainOccluders(tops);
+            rasterizeOccluders();
+            double rasterized = getTestTime();
+            occluded += testTerrainChunks(&world);
+            testTime += getTestTime() - rasterized;
+            rasterTime += rasterized - start;
+            tested += getOcclusionStats().testedBoxes;
+        }
+
+        CHECK(occluded > 0 && occluded < tested);
+        printf("  hilly terrain, %d threads: %.2f ms rasterizing and %.2f ms testing per frame, %d of %d chunks occluded\n",
+            getWorkerCount(), rasterTime * 1e3 / FRAME_COUNT, testTime * 1e3 / FRAME_COUNT,
+            occluded / FRAME_COUNT, tested / FRAME_COUNT);
+        freeWorkers();
+    }
+
+    freeTestWorld(&world);
+}
+
+int main() {
+    initNoise();
+    testKnownOccluder();
+    freeWorkers();
+    benchmarkHillyTerrain();
+    freeOcclusion();
+    return finishTest("occlusion");
+}
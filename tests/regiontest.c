@@ -0,0 +1,163 @@
+#include "testing.h"
+#include "engine/region.h"
+#include "engine/workers.h"
+
+#include <string.h>
+
+#define BENCHMARK_RADIUS 7
+#define RANDOM_EDITS 2000
+
+static void editColumn(WorldState* world, ChunkColumn* column, unsigned int* random) {
+    for (int i = 0; i < RANDOM_EDITS; i++) {
+        int x = column->x * CHUNK_SIZE + (int)(nextTestRandom(random) % CHUNK_SIZE);
+        int y = (int)(nextTestRandom(random) % 40);
+        int z = column->z * CHUNK_SIZE + (int)(nextTestRandom(random) % CHUNK_SIZE);
+
+        if (i % 2 == 0) {
+            destroyBlock(world, x, y, z);
+        } else {
+            placeBlock(world, x, y, z, 1 + (int)(nextTestRandom(random) % 5));
+        }
+    }
+}
+
+static bool isColumnEqual(const ChunkColumn* first, const ChunkColumn* second) {
+    if (memcmp(first->surfaceHeights, second->surfaceHeights, sizeof(first->surfaceHeights)) != 0
+        || memcmp(first->surfaceTypes, second->surfaceTypes, sizeof(first->surfaceTypes)) != 0) {
+        return false;
+    }
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+        for (int index = 0; index < BLOCK_STORAGE_SIZE; index++) {
+            if (getChunkBlock(&first->sections[section], index) != getChunkBlock(&second->sections[section], index)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void checkSavedColumns(WorldState* world) {
+    closeRegionFiles();
+
+    for (int i = 0; i < world->columnCount; i++) {
+        ChunkColumn loaded = { .x = world->columns[i].x, .z = world->columns[i].z };
+
+        CHECK(loadChunkColumn(&loaded));
+        CHECK(!loaded.isModified);
+        CHECK(isColumnEqual(&loaded, &world->columns[i]));
+        freeChunkColumn(&loaded);
+    }
+}
+
+static void testRoundTrip() {
+    WorldState world = { 0 };
+    unsigned int random = 17;
+
+    generateTestWorld(&world, 1);
+
+    for (int i = 0; i < world.columnCount; i++) {
+        CHECK(!world.columns[i].isModified);
+        editColumn(&world, &world.columns[i], &random);
+        CHECK(world.columns[i].isModified);
+    }
+
+    for (int i = 0; i < world.columnCount; i++) {
+        if (i % 2 == 0) {
+            CHECK(saveChunkColumn(&world.columns[i]));
+            CHECK(!world.columns[i].isModified);
+        } else {
+            queueChunkColumnSave(&world, &world.columns[i]);
+        }
+    }
+
+    finishChunkColumnSaves();
+
+    for (int i = 0; i < world.columnCount; i++) {
+        CHECK(!world.columns[i].isModified);
+    }
+
+    checkSavedColumns(&world);
+
+    for (int i = 0; i < world.columnCount; i++) {
+        editColumn(&world, &world.columns[i], &random);
+        queueChunkColumnSave(&world, &world.columns[i]);
+    }
+
+    editColumn(&world, &world.columns[0], &random);
+    finishChunkColumnSaves();
+    CHECK(!isChunkColumnSaving(0, 0));
+    CHECK(world.columns[0].isModified);
+    CHECK(!world.columns[1].isModified);
+    CHECK(saveChunkColumn(&world.columns[0]));
+    checkSavedColumns(&world);
+
+    freeTestWorld(&world);
+}
+
+static void benchmarkLoad() {
+    WorldState world = { 0 };
+    unsigned int random = 23;
+
+    generateTestWorld(&world, BENCHMARK_RADIUS);
+
+    for (int i = 0; i < world.columnCount; i++) {
+        editColumn(&world, &world.columns[i], &random);
+        queueChunkColumnSave(&world, &world.columns[i]);
+    }
+
+    finishChunkColumnSaves();
+    syncRegionFiles();
+    closeRegionFiles();
+
+    RegionStats before = getRegionStats();
+    double start = getTestTime();
+
+    for (int i = 0; i < world.columnCount; i++) {
+        ChunkColumn loaded = { .x = world.columns[i].x, .z = world.columns[i].z };
+        CHECK(loadChunkColumn(&loaded));
+        freeChunkColumn(&loaded);
+    }
+
+    double loadElapsed = getTestTime() - start;
+    RegionStats after = getRegionStats();
+
+    start = getTestTime();
+
+    for (int i = 0; i < world.columnCount; i++) {
+        ChunkColumn generated = { .x = world.columns[i].x, .z = world.columns[i].z };
+        generateChunkColumn(&generated);
+        freeChunkColumn(&generated);
+    }
+
+    double generateElapsed = getTestTime() - start;
+    double interleavedLoad = 0.0;
+
+    for (int i = 0; i < world.columnCount; i++) {
+        ChunkColumn loaded = { .x = world.columns[i].x, .z = world.columns[i].z };
+
+        CHECK(saveChunkColumn(&world.columns[(i + 1) % world.columnCount]));
+        start = getTestTime();
+        CHECK(loadChunkColumn(&loaded));
+        interleavedLoad += getTestTime() - start;
+        freeChunkColumn(&loaded);
+    }
+
+    CHECK(after.loadedColumns - before.loadedColumns == world.columnCount);
+    printf("  %d columns: %.1f us per load (%.1f KB each), %.1f us per load between saves, %.1f us per generation\n",
+        world.columnCount, loadElapsed * 1e6 / world.columnCount,
+        (after.loadedBytes - before.loadedBytes) / 1024.0 / world.columnCount,
+        interleavedLoad * 1e6 / world.columnCount, generateElapsed * 1e6 / world.columnCount);
+
+    freeTestWorld(&world);
+}
+
+int main() {
+    testRoundTrip();
+    benchmarkLoad();
+
+    freeWorkers();
+    closeRegionFiles();
+    return finishTest("region");
+}
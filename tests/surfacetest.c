@@ -0,0 +1,118 @@
+#include "testing.h"
+#include "engine/bulkedit.h"
+
+#define COLUMN_RADIUS 2
+#define RANDOM_EDITS 50000
+#define LOOKUP_COUNT 1000000
+
+static int scanSurfaceHeight(WorldState* world, int x, int z) {
+    for (int y = WORLD_HEIGHT - 1; y >= 0; y--) {
+        if (getBlockTypeAtGlobal(world, x, y, z) != 0) {
+            return y;
+        }
+    }
+
+    return SURFACE_NONE;
+}
+
+static void checkSurface(WorldState* world) {
+    int heightMismatches = 0;
+    int typeMismatches = 0;
+    int extent = COLUMN_RADIUS * CHUNK_SIZE;
+
+    for (int z = -extent; z < extent + CHUNK_SIZE; z++) {
+        for (int x = -extent; x < extent + CHUNK_SIZE; x++) {
+            int height = scanSurfaceHeight(world, x, z);
+            int type = height != SURFACE_NONE ? getBlockTypeAtGlobal(world, x, height, z) : 0;
+
+            heightMismatches += getSurfaceHeight(world, x, z) != height;
+            typeMismatches += getSurfaceType(world, x, z) != type;
+        }
+    }
+
+    CHECK(heightMismatches == 0);
+    CHECK(typeMismatches == 0);
+}
+
+static void applyRandomEdits(WorldState* world) {
+    unsigned int random = 3;
+    int width = (COLUMN_RADIUS * 2 + 1) * CHUNK_SIZE;
+
+    for (int i = 0; i < RANDOM_EDITS; i++) {
+        int x = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        int z = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        int surface = getSurfaceHeight(world, x, z);
+        int y = surface + (int)(nextTestRandom(&random) % 9) - 4;
+
+        if (y < 0 || y >= WORLD_HEIGHT) {
+            continue;
+        }
+
+        if (nextTestRandom(&random) % 2 == 0) {
+            destroyBlock(world, x, surface, z);
+        } else {
+            placeBlock(world, x, y, z, 1 + (int)(nextTestRandom(&random) % 3));
+        }
+    }
+}
+
+static void digShafts(WorldState* world) {
+    for (int x = -COLUMN_RADIUS * CHUNK_SIZE; x < COLUMN_RADIUS * CHUNK_SIZE; x += 7) {
+        for (int y = WORLD_HEIGHT - 1; y >= 0; y--) {
+            destroyBlock(world, x, y, x / 2);
+        }
+    }
+}
+
+static void benchmarkSurface(WorldState* world) {
+    unsigned int random = 9;
+    int width = (COLUMN_RADIUS * 2 + 1) * CHUNK_SIZE;
+    long indexSum = 0;
+    long scanSum = 0;
+
+    double start = getTestTime();
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        int x = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        int z = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        indexSum += getSurfaceHeight(world, x, z);
+    }
+    double indexElapsed = getTestTime() - start;
+
+    random = 9;
+    start = getTestTime();
+    for (int i = 0; i < LOOKUP_COUNT / 100; i++) {
+        int x = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        int z = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        scanSum += scanSurfaceHeight(world, x, z);
+    }
+    double scanElapsed = getTestTime() - start;
+
+    CHECK(indexSum > 0 && scanSum > 0);
+    printf("  %.1f ns per getSurfaceHeight, %.1f ns per column scan\n",
+        indexElapsed * 1e9 / LOOKUP_COUNT, scanElapsed * 1e9 / (LOOKUP_COUNT / 100));
+}
+
+int main() {
+    WorldState world = { 0 };
+    IntVector3 min = { .x = -20, .y = 0, .z = -20 };
+    IntVector3 max = { .x = 20, .y = 40, .z = 4 };
+    Vector3 center = { .x = 0.0, .y = 40.0, .z = 0.0 };
+
+    generateTestWorld(&world, COLUMN_RADIUS);
+    checkSurface(&world);
+
+    applyRandomEdits(&world);
+    checkSurface(&world);
+
+    digShafts(&world);
+    checkSurface(&world);
+
+    fillBlocks(&world, min, max, 2);
+    carveSphere(&world, center, 12.0);
+    checkSurface(&world);
+
+    benchmarkSurface(&world);
+
+    freeTestWorld(&world);
+    return finishTest("surface");
+}
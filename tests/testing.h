@@ -0,0 +1,62 @@
+#ifndef BLOCKS_TESTING
+#define BLOCKS_TESTING
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "engine/world.h"
+
+static int testFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++; \
+        } \
+    } while (0)
+
+static inline double getTestTime() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static inline unsigned int nextTestRandom(unsigned int* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static inline void generateTestWorld(WorldState* world, int columnRadius) {
+    for (int x = -columnRadius; x <= columnRadius; x++) {
+        for (int z = -columnRadius; z <= columnRadius; z++) {
+            ChunkColumn column = { .x = x, .z = z };
+            generateChunkColumn(&column);
+            addChunkColumn(world, &column);
+        }
+    }
+}
+
+static inline void freeTestWorld(WorldState* world) {
+    for (int i = 0; i < world->columnCount; i++) {
+        freeChunkColumn(&world->columns[i]);
+    }
+
+    free(world->columns);
+    freeChunkMap(&world->columnMap);
+    world->columns = NULL;
+    world->columnCount = 0;
+    world->columnCapacity = 0;
+}
+
+static inline int finishTest(const char* name) {
+    if (testFailures > 0) {
+        fprintf(stderr, "%s: %d checks failed\n", name, testFailures);
+        return 1;
+    }
+
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,201 @@
+#include <string.h>
+#include "testing.h"
+#include "engine/upload.h"
+#include <GLFW/glfw3.h>
+
+#define STRESS_SLOTS 512
+#define STRESS_STEPS 200000
+#define PATTERN_SIZE 4000
+
+typedef struct TestAllocation {
+    int offset;
+    int size;
+} TestAllocation;
+
+static GLFWwindow* createHiddenContext() {
+    if (!glfwInit()) {
+        return NULL;
+    }
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "uploadtest", NULL, NULL);
+    if (window == NULL) {
+        glfwTerminate();
+        return NULL;
+    }
+
+    glfwMakeContextCurrent(window);
+
+#if !defined(__APPLE__)
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return NULL;
+    }
+#endif
+
+    return window;
+}
+
+static int getAlignedSize(int size) {
+    return (size + GEOMETRY_ALIGNMENT - 1) & ~(GEOMETRY_ALIGNMENT - 1);
+}
+
+static void checkFullyCoalesced() {
+    UploadStats before = getUploadStats();
+    int offset = allocateGeometry(before.arenaBytes);
+
+    CHECK(offset == 0);
+    CHECK(getUploadStats().arenaGrowths == before.arenaGrowths);
+    freeGeometry(offset, before.arenaBytes);
+}
+
+static void checkCoalescing() {
+    int first = allocateGeometry(100);
+    int second = allocateGeometry(300);
+    int third = allocateGeometry(GEOMETRY_ALIGNMENT);
+
+    CHECK(first == 0);
+    CHECK(second == GEOMETRY_ALIGNMENT);
+    CHECK(third == GEOMETRY_ALIGNMENT * 3);
+    CHECK(getUploadStats().arenaUsedBytes == GEOMETRY_ALIGNMENT * 4);
+    CHECK(getUploadStats().allocationCount == 3);
+
+    freeGeometry(second, 300);
+    freeGeometry(first, 100);
+
+    int merged = allocateGeometry(GEOMETRY_ALIGNMENT * 3);
+    CHECK(merged == 0);
+
+    freeGeometry(merged, GEOMETRY_ALIGNMENT * 3);
+    freeGeometry(third, GEOMETRY_ALIGNMENT);
+    CHECK(getUploadStats().arenaUsedBytes == 0);
+    CHECK(getUploadStats().allocationCount == 0);
+    checkFullyCoalesced();
+}
+
+static void checkGrowth() {
+    unsigned char pattern[PATTERN_SIZE];
+    unsigned char readBack[PATTERN_SIZE];
+
+    for (int i = 0; i < PATTERN_SIZE; i++) {
+        pattern[i] = (unsigned char)(i * 7 + 3);
+    }
+
+    int kept = allocateGeometry(PATTERN_SIZE);
+    int filler = allocateGeometry(GEOMETRY_ARENA_INITIAL_SIZE - getAlignedSize(PATTERN_SIZE));
+    CHECK(kept == 0 && filler != GEOMETRY_NONE);
+
+    beginUploadFrame();
+    uploadGeometry(kept, pattern, PATTERN_SIZE);
+    endUploadFrame();
+
+    UploadStats before = getUploadStats();
+    int grown = allocateGeometry(GEOMETRY_ALIGNMENT);
+    UploadStats after = getUploadStats();
+
+    CHECK(grown == GEOMETRY_ARENA_INITIAL_SIZE);
+    CHECK(after.arenaGrowths == before.arenaGrowths + 1);
+    CHECK(after.arenaBytes == GEOMETRY_ARENA_INITIAL_SIZE * 2);
+
+    memset(readBack, 0, sizeof(readBack));
+    glBindBuffer(GL_COPY_READ_BUFFER, getGeometryBuffer());
+    glGetBufferSubData(GL_COPY_READ_BUFFER, kept, PATTERN_SIZE, readBack);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    CHECK(memcmp(pattern, readBack, PATTERN_SIZE) == 0);
+
+    freeGeometry(filler, GEOMETRY_ARENA_INITIAL_SIZE - getAlignedSize(PATTERN_SIZE));
+    freeGeometry(grown, GEOMETRY_ALIGNMENT);
+    freeGeometry(kept, PATTERN_SIZE);
+    CHECK(getUploadStats().arenaUsedBytes == 0);
+    checkFullyCoalesced();
+}
+
+static bool isOverlapping(TestAllocation* allocations, int index) {
+    TestAllocation* current = &allocations[index];
+    int end = current->offset + getAlignedSize(current->size);
+
+    for (int i = 0; i < STRESS_SLOTS; i++) {
+        TestAllocation* other = &allocations[i];
+
+        if (i == index || other->offset == GEOMETRY_NONE) {
+            continue;
+        }
+
+        if (current->offset < other->offset + getAlignedSize(other->size) && other->offset < end) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void stressAllocations() {
+    TestAllocation allocations[STRESS_SLOTS];
+    unsigned int random = 5;
+    int overlaps = 0;
+    int misaligned = 0;
+
+    for (int i = 0; i < STRESS_SLOTS; i++) {
+        allocations[i].offset = GEOMETRY_NONE;
+    }
+
+    double start = getTestTime();
+    for (int step = 0; step < STRESS_STEPS; step++) {
+        TestAllocation* allocation = &allocations[nextTestRandom(&random) % STRESS_SLOTS];
+
+        if (allocation->offset != GEOMETRY_NONE) {
+            freeGeometry(allocation->offset, allocation->size);
+            allocation->offset = GEOMETRY_NONE;
+        } else {
+            allocation->size = 1 + (int)(nextTestRandom(&random) % (64 * 1024));
+            allocation->offset = allocateGeometry(allocation->size);
+            misaligned += allocation->offset % GEOMETRY_ALIGNMENT != 0;
+        }
+    }
+    double elapsed = getTestTime() - start;
+
+    for (int i = 0; i < STRESS_SLOTS; i++) {
+        overlaps += allocations[i].offset != GEOMETRY_NONE && isOverlapping(allocations, i);
+    }
+
+    CHECK(overlaps == 0);
+    CHECK(misaligned == 0);
+
+    for (int i = 0; i < STRESS_SLOTS; i++) {
+        if (allocations[i].offset != GEOMETRY_NONE) {
+            freeGeometry(allocations[i].offset, allocations[i].size);
+        }
+    }
+
+    CHECK(getUploadStats().arenaUsedBytes == 0);
+    CHECK(getUploadStats().allocationCount == 0);
+    checkFullyCoalesced();
+
+    printf("  %.1f ns per allocate or free, %d KB arena after %d growths\n",
+        elapsed * 1e9 / STRESS_STEPS, getUploadStats().arenaBytes / 1024, getUploadStats().arenaGrowths);
+}
+
+int main() {
+    GLFWwindow* window = createHiddenContext();
+    if (window == NULL) {
+        printf("upload: skipped, no OpenGL context\n");
+        return 0;
+    }
+
+    CHECK(initUploads());
+    checkCoalescing();
+    checkGrowth();
+    stressAllocations();
+    freeUploads();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return finishTest("upload");
+}
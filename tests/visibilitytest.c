@@ -0,0 +1,130 @@
+#include "testing.h"
+#include "engine/visibility.h"
+#include "engine/constants.h"
+
+#define COLUMN_RADIUS 3
+#define RANDOM_EDITS 20000
+
+static int probeVisibleFaces(WorldState* world, int x, int y, int z) {
+    static const int offsets[BLOCK_FACE_COUNT][3] = {
+        [BLOCK_FACE_TOP] = { 0, 1, 0 },
+        [BLOCK_FACE_BOTTOM] = { 0, -1, 0 },
+        [BLOCK_FACE_FRONT] = { 0, 0, 1 },
+        [BLOCK_FACE_BACK] = { 0, 0, -1 },
+        [BLOCK_FACE_RIGHT] = { 1, 0, 0 },
+        [BLOCK_FACE_LEFT] = { -1, 0, 0 }
+    };
+    int mask = 0;
+
+    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+        if (getBlockTypeAtGlobal(world, x + offsets[face][0], y + offsets[face][1], z + offsets[face][2]) == 0) {
+            mask |= 1 << face;
+        }
+    }
+
+    return mask;
+}
+
+static int probeChunk(WorldState* world, Chunk* chunk, int* masks) {
+    int faceCount = 0;
+
+    for (int index = 0; index < BLOCK_STORAGE_SIZE; index++) {
+        int x = chunk->position.x * CHUNK_SIZE + (index & CHUNK_MASK);
+        int y = chunk->position.y * CHUNK_SIZE + ((index >> CHUNK_SHIFT) & CHUNK_MASK);
+        int z = chunk->position.z * CHUNK_SIZE + (index >> (CHUNK_SHIFT * 2));
+
+        masks[index] = getChunkBlock(chunk, index) != 0 ? probeVisibleFaces(world, x, y, z) : 0;
+        faceCount += __builtin_popcount(masks[index]);
+    }
+
+    return faceCount;
+}
+
+static void carveRandomBlocks(WorldState* world) {
+    unsigned int random = 5;
+    int width = (COLUMN_RADIUS * 2 + 1) * CHUNK_SIZE;
+
+    for (int i = 0; i < RANDOM_EDITS; i++) {
+        int x = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        int y = (int)(nextTestRandom(&random) % 24);
+        int z = (int)(nextTestRandom(&random) % width) - COLUMN_RADIUS * CHUNK_SIZE;
+        Chunk* chunk = getChunkAt(world, x >> CHUNK_SHIFT, y >> CHUNK_SHIFT, z >> CHUNK_SHIFT);
+        int index = (x & CHUNK_MASK) + (y & CHUNK_MASK) * CHUNK_SIZE + (z & CHUNK_MASK) * CHUNK_SIZE * CHUNK_SIZE;
+
+        setChunkBlock(world, chunk, index, i % 3 == 0 ? 1 : 0);
+    }
+}
+
+static double checkWorldVisibility(WorldState* world) {
+    static int masks[BLOCK_STORAGE_SIZE];
+    double probeElapsed = 0.0;
+
+    for (int i = 0; i < world->columnCount; i++) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            Chunk* chunk = &world->columns[i].sections[section];
+
+            double start = getTestTime();
+            int faceCount = probeChunk(world, chunk, masks);
+            probeElapsed += getTestTime() - start;
+
+            CHECK(chunk->visibleFaceCount == faceCount);
+
+            for (int index = 0; index < BLOCK_STORAGE_SIZE; index++) {
+                CHECK(getVisibleFaceMask(chunk, index) == masks[index]);
+            }
+        }
+    }
+
+    return probeElapsed;
+}
+
+static void testColumnStreaming(WorldState* world) {
+    int columnX[] = { 0, 1, -COLUMN_RADIUS };
+    int columnZ[] = { 0, 0, COLUMN_RADIUS };
+
+    for (int i = 0; i < 3; i++) {
+        removeChunkColumn(world, columnX[i], columnZ[i]);
+        updateChunkColumnNeighborhoodVisibility(world, columnX[i], columnZ[i]);
+        checkWorldVisibility(world);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        ChunkColumn column = { .x = columnX[i], .z = columnZ[i] };
+        generateChunkColumn(&column);
+        addChunkColumn(world, &column);
+
+        double start = getTestTime();
+        updateChunkColumnNeighborhoodVisibility(world, columnX[i], columnZ[i]);
+        double elapsed = getTestTime() - start;
+
+        checkWorldVisibility(world);
+        printf("  column %d, %d: %.1f us to integrate\n", columnX[i], columnZ[i], elapsed * 1e6);
+    }
+}
+
+int main() {
+    WorldState world = { 0 };
+
+    generateTestWorld(&world, COLUMN_RADIUS);
+    carveRandomBlocks(&world);
+
+    int chunkCount = world.columnCount * CHUNK_SECTION_COUNT;
+    double start = getTestTime();
+
+    for (int i = 0; i < world.columnCount; i++) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            updateChunkVisibility(&world, &world.columns[i].sections[section]);
+        }
+    }
+
+    double bitsetElapsed = getTestTime() - start;
+    double probeElapsed = checkWorldVisibility(&world);
+
+    printf("  %d chunks: %.1f us per chunk for the bitset pass, %.1f us per chunk for the neighbour probe\n",
+        chunkCount, bitsetElapsed * 1e6 / chunkCount, probeElapsed * 1e6 / chunkCount);
+
+    testColumnStreaming(&world);
+
+    freeTestWorld(&world);
+    return finishTest("visibility");
+}
@@ -0,0 +1,109 @@
+#include <math.h>
+#include "testing.h"
+#include "engine/visibleset.h"
+
+#define SORTED_CHUNKS 4096
+#define SORT_ROUNDS 100
+
+static Frustum getTestFrustum(double fovY, Vector3 position, Vector3 direction) {
+    Vector3 center = { .x = position.x + direction.x, .y = position.y + direction.y, .z = position.z + direction.z };
+    Vector3 up = { .x = 0.0, .y = 1.0, .z = 0.0 };
+    Matrix4 viewProjection = multiplyMatrices(getPerspectiveMatrix(fovY, 16.0 / 9.0, 0.1, 256.0), getLookAtMatrix(position, center, up));
+    Frustum frustum;
+
+    extractFrustumPlanes(&frustum, &viewProjection);
+    return frustum;
+}
+
+static Vector3 getTurnedDirection(double degrees) {
+    Vector3 direction = { .x = sin(degrees * M_PI / 180.0), .y = 0.0, .z = -cos(degrees * M_PI / 180.0) };
+    return direction;
+}
+
+static void testInvalidation() {
+    Vector3 position = { .x = 10.0, .y = 20.0, .z = 30.0 };
+    Vector3 direction = getTurnedDirection(0.0);
+    Frustum frustum = getTestFrustum(60, position, direction);
+    Frustum wideFrustum = getTestFrustum(75, position, direction);
+    Vector3 nudged = { .x = position.x + VISIBLE_SET_MOVE_THRESHOLD * 0.5, .y = position.y, .z = position.z };
+    Vector3 moved = { .x = position.x, .y = position.y, .z = position.z + VISIBLE_SET_MOVE_THRESHOLD * 2.0 };
+    Vector3 scaled = { .x = direction.x * 3.0, .y = direction.y * 3.0, .z = direction.z * 3.0 };
+
+    CHECK(!isVisibleSetCurrent(position, direction, &frustum, 1, 0));
+
+    beginVisibleSet(position, direction, &frustum, 1, 0);
+    sortVisibleSet();
+    CHECK(isVisibleSetCurrent(position, direction, &frustum, 1, 0));
+    CHECK(getVisibleSetStats().isCached);
+    CHECK(isVisibleSetCurrent(nudged, direction, &frustum, 1, 0));
+    CHECK(isVisibleSetCurrent(position, scaled, &frustum, 1, 0));
+    CHECK(isVisibleSetCurrent(position, getTurnedDirection(VISIBLE_SET_TURN_THRESHOLD * 0.5), &frustum, 1, 0));
+
+    CHECK(!isVisibleSetCurrent(position, direction, &frustum, 2, 0));
+    CHECK(!getVisibleSetStats().isCached);
+    CHECK(!isVisibleSetCurrent(position, direction, &frustum, 1, 1));
+    CHECK(!isVisibleSetCurrent(moved, direction, &frustum, 1, 0));
+    CHECK(!isVisibleSetCurrent(position, getTurnedDirection(VISIBLE_SET_TURN_THRESHOLD * 2.0), &frustum, 1, 0));
+    CHECK(!isVisibleSetCurrent(position, getTurnedDirection(-VISIBLE_SET_TURN_THRESHOLD * 2.0), &frustum, 1, 0));
+    CHECK(!isVisibleSetCurrent(position, direction, &wideFrustum, 1, 0));
+
+    VisibleSetStats stats = getVisibleSetStats();
+    CHECK(stats.rebuilds == 1);
+    CHECK(stats.reuses == 4);
+
+    invalidateVisibleSet();
+    CHECK(!isVisibleSetCurrent(position, direction, &frustum, 1, 0));
+
+    beginVisibleSet(position, direction, &frustum, 1, 0);
+    setVisibleSetCacheEnabled(false);
+    CHECK(!isVisibleSetCurrent(position, direction, &frustum, 1, 0));
+    setVisibleSetCacheEnabled(true);
+    CHECK(!isVisibleSetCurrent(position, direction, &frustum, 1, 0));
+}
+
+static void testFrontToBackOrder() {
+    static Chunk chunks[SORTED_CHUNKS];
+    Vector3 position = { .x = 0.0, .y = 0.0, .z = 0.0 };
+    Vector3 direction = getTurnedDirection(0.0);
+    Frustum frustum = getTestFrustum(60, position, direction);
+    unsigned int random = 17;
+    int outOfOrder = 0;
+    int insideMismatches = 0;
+    double sortTime = 0.0;
+
+    for (int round = 0; round < SORT_ROUNDS; round++) {
+        beginVisibleSet(position, direction, &frustum, round, 0);
+
+        for (int i = 0; i < SORTED_CHUNKS; i++) {
+            float distance = (float)(nextTestRandom(&random) % 100000);
+            chunks[i].visibleFaceCount = (int)distance;
+            addVisibleChunk(&chunks[i], distance, (int)distance % 2 == 0);
+        }
+
+        double start = getTestTime();
+        sortVisibleSet();
+        sortTime += getTestTime() - start;
+
+        int count;
+        const VisibleChunk* visible = getVisibleChunks(&count);
+        CHECK(count == SORTED_CHUNKS);
+
+        for (int i = 0; i < count; i++) {
+            outOfOrder += i > 0 && visible[i].distance < visible[i - 1].distance;
+            insideMismatches += visible[i].chunk->visibleFaceCount != (int)visible[i].distance
+                || visible[i].isInside != ((int)visible[i].distance % 2 == 0);
+        }
+    }
+
+    CHECK(outOfOrder == 0);
+    CHECK(insideMismatches == 0);
+    CHECK(getVisibleSetStats().visibleChunks == SORTED_CHUNKS);
+    printf("  %d chunks: %.1f us per front-to-back sort\n", SORTED_CHUNKS, sortTime * 1e6 / SORT_ROUNDS);
+}
+
+int main() {
+    testInvalidation();
+    testFrontToBackOrder();
+    freeVisibleSet();
+    return finishTest("visibleset");
+}
@@ -0,0 +1,144 @@
+#include "testing.h"
+#include "engine/workers.h"
+#include "engine/streaming.h"
+#include "engine/viewport.h"
+#include "engine/visibility.h"
+#include "engine/noise.h"
+
+#include <math.h>
+#include <string.h>
+
+static void generateSerialWorld(WorldState* world, int centerX, int centerZ, int radius) {
+    for (int x = centerX - radius; x <= centerX + radius; x++) {
+        for (int z = centerZ - radius; z <= centerZ + radius; z++) {
+            ChunkColumn column = { .x = x, .z = z };
+            generateChunkColumn(&column);
+            addChunkColumn(world, &column);
+        }
+    }
+
+    for (int i = 0; i < world->columnCount; i++) {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            updateChunkVisibility(world, &world->columns[i].sections[section]);
+        }
+    }
+}
+
+static bool isChunkEqual(const Chunk* first, const Chunk* second) {
+    if (first->uniformType != second->uniformType || first->visibleFaceCount != second->visibleFaceCount) {
+        return false;
+    }
+
+    for (int index = 0; index < BLOCK_STORAGE_SIZE; index++) {
+        if (getChunkBlock(first, index) != getChunkBlock(second, index)
+            || getVisibleFaceMask(first, index) != getVisibleFaceMask(second, index)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void compareWorlds(WorldState* serial, WorldState* parallel) {
+    CHECK(serial->columnCount == parallel->columnCount);
+
+    for (int i = 0; i < parallel->columnCount; i++) {
+        ChunkColumn* column = &parallel->columns[i];
+        ChunkColumn* expected = getChunkColumnAt(serial, column->x, column->z);
+
+        CHECK(expected != NULL);
+        if (expected == NULL) {
+            continue;
+        }
+
+        CHECK(memcmp(column->surfaceHeights, expected->surfaceHeights, sizeof(column->surfaceHeights)) == 0);
+        CHECK(memcmp(column->surfaceTypes, expected->surfaceTypes, sizeof(column->surfaceTypes)) == 0);
+
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++) {
+            CHECK(isChunkEqual(&column->sections[section], &expected->sections[section]));
+        }
+    }
+}
+
+static int isBlockerReleased = 0;
+
+static void runBlockingTask(void* context) {
+    while (!__atomic_load_n(&isBlockerReleased, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void runCountingTask(void* context) {
+    __atomic_add_fetch((int*)context, 1, __ATOMIC_RELAXED);
+}
+
+static void testGroupWait() {
+    WorkerGroup blocker = { .pending = 0 };
+    WorkerGroup other = { .pending = 0 };
+    WorkerGroup own = { .pending = 0 };
+    int otherCount = 0;
+    int ownCount = 0;
+
+    initWorkers(1);
+    submitWorkerTask(&blocker, runBlockingTask, NULL);
+
+    for (int i = 0; i < 8; i++) {
+        submitWorkerTask(&other, runCountingTask, &otherCount);
+        submitWorkerTask(&own, runCountingTask, &ownCount);
+    }
+
+    waitForWorkerGroup(&own);
+    CHECK(ownCount == 8);
+    CHECK(otherCount == 0);
+
+    __atomic_store_n(&isBlockerReleased, 1, __ATOMIC_RELEASE);
+    waitForWorkerGroup(&other);
+    waitForWorkerGroup(&blocker);
+    CHECK(otherCount == 8);
+
+    freeWorkers();
+}
+
+int main() {
+    static const int radii[] = { 1, 3, 7 };
+    static const int threadCounts[] = { 1, 2, 4, 7 };
+    Vector3 position = getViewportPosition();
+    int centerX = (int)floor(position.x) >> CHUNK_SHIFT;
+    int centerZ = (int)floor(position.z) >> CHUNK_SHIFT;
+
+    initNoise();
+    testGroupWait();
+
+    for (int r = 0; r < 3; r++) {
+        WorldState serial = { 0 };
+        StreamingConfig config = getChunkStreamingConfig();
+        config.loadRadius = radii[r];
+        setChunkStreamingConfig(config);
+
+        double times[4];
+        double start = getTestTime();
+        generateSerialWorld(&serial, centerX, centerZ, radii[r]);
+        double serialTime = getTestTime() - start;
+
+        for (int t = 0; t < 4; t++) {
+            initWorkers(threadCounts[t]);
+
+            start = getTestTime();
+            generateWorld();
+            times[t] = getTestTime() - start;
+
+            compareWorlds(&serial, getWorldStateGlobal());
+            removeWorld();
+            freeWorkers();
+        }
+
+        printf("  %d chunks: serial %.1f ms", serial.columnCount * CHUNK_SECTION_COUNT, serialTime * 1e3);
+        for (int t = 0; t < 4; t++) {
+            printf(", %d threads %.1f ms", threadCounts[t], times[t] * 1e3);
+        }
+        printf("\n");
+
+        freeTestWorld(&serial);
+    }
+
+    return finishTest("workers");
+}